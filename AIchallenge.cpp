@@ -12,6 +12,7 @@
 // Include Files
 //-----------------------------------------------------------------
 #include "AIchallenge.h"																				
+#include "Benchmark.h"
 
 //-----------------------------------------------------------------
 // Defines
@@ -25,20 +26,19 @@ int _fpst;
 
 AIchallenge::AIchallenge():m_gridSize(40),
 							m_default(),
-							m_isRigidCell(),
+							m_arena(),
 							m_filler(),
-							m_berserker()
+							m_berserker(),
+							m_matchCount(0),
+							m_isMatchOver(false),
+							m_moveBudget(10000000),
+							m_budgetPolicy(BUDGET_WARN)
 {
 
 }
 
 AIchallenge::~AIchallenge()																						
 {
-	for (int i = 0; i < 48; ++i)
-	{
-		delete [] m_isRigidCell[i];
-	}
-	delete [] m_isRigidCell;
 }
 
 void AIchallenge::GameInitialize(HINSTANCE hInstance)			
@@ -51,6 +51,7 @@ void AIchallenge::GameInitialize(HINSTANCE hInstance)
 	GAME_ENGINE->SetWidth(800);
 	GAME_ENGINE->SetHeight(800);
     GAME_ENGINE->SetFrameRate(20);
+	GAME_ENGINE->SetKeyList(String("B"));
 }
 
 void AIchallenge::GameStart()
@@ -72,29 +73,32 @@ void AIchallenge::GameStart()
 	m_filler.yPos = GAME_ENGINE->GetHeight() / 2 / m_gridSize;
 	m_filler.playerColor = RGB(0,0,255);
 	m_filler.fillColor = RGB(150,150,255);
+	m_berserker.cellsFilled = m_filler.cellsFilled = 0;
+	m_berserkerLatency.Clear();
+	m_fillerLatency.Clear();
+	m_lossCauses[0] = m_lossCauses[1] = LOSS_NONE;
+	m_isMatchOver = false;
 	
-	//Rigid Cell List Allocating
-	m_isRigidCell = new bool*[GAME_ENGINE->GetWidth() / m_gridSize];
-	for (int i = 0; i < GAME_ENGINE->GetWidth() / m_gridSize; ++i)
-	{
-		m_isRigidCell[i] = new bool[GAME_ENGINE->GetHeight() / m_gridSize];
-	}
+	//Rigid Cell grid with the wall ring
+	m_arena.Create(GAME_ENGINE->GetWidth() / m_gridSize, GAME_ENGINE->GetHeight() / m_gridSize);
+	m_arena.AddWallRing();
 
-	//rigid cell ini
-	for(int x = 0;x < (GAME_ENGINE->GetWidth() / m_gridSize);++x)
-	{
-		for(int y = 0; y < (GAME_ENGINE->GetHeight() / m_gridSize);++y)
-		{
-			m_isRigidCell[x][y] = false;
-			m_isRigidCell[0][y] = true;
-			m_isRigidCell[GAME_ENGINE->GetWidth() / m_gridSize - 1][y] = true;
-		}
-		m_isRigidCell[x][0] = true;
-		m_isRigidCell[x][GAME_ENGINE->GetHeight() / m_gridSize - 1] = true;
-	}
+	//per player distance fields
+	m_berserkerDistance.Initialize(m_arena, m_berserker.xPos, m_berserker.yPos);
+	m_fillerDistance.Initialize(m_arena, m_filler.xPos, m_filler.yPos);
+	//listeners kept data of the old arena
+	m_rigidCellListeners.clear();
+	AddRigidCellListener(&m_berserkerDistance);
+	AddRigidCellListener(&m_fillerDistance);
+
+	//match statistics, written in the background
+	CreateDirectory(TEXT("temp\\"), NULL);
+	TCHAR statisticsFilename[] = TEXT("temp\\matches.csv");
+	m_statistics.Open(statisticsFilename, true);
 }
 void AIchallenge::GameEnd()
 {
+	m_statistics.Close();
 }
 void AIchallenge::GameActivate()
 {
@@ -113,6 +117,11 @@ void AIchallenge::CheckKeyboard()
 }
 void AIchallenge::KeyPressed(TCHAR cKey)
 {
+	if(cKey == 'B')
+	{
+		Benchmark benchmark;
+		benchmark.RunAll();
+	}
 }
 void AIchallenge::GamePaint(RECT rect)
 {
@@ -135,11 +144,30 @@ void AIchallenge::GameCycle(RECT rect)
 
 
 	//Move the AI's
-	if(_fpst % 2== 0)
+	if(_fpst % 2== 0 && !m_isMatchOver)
 	{
 		//m_default = MoveAIplayer(m_default);
-		m_berserker = MoveAIplayer(m_berserker);
-		m_filler = MoveAIplayer(m_filler,0);
+		//both heads become rigid before anything else, like Match::TickSimultaneously:
+		//both AIs are checked and decide on the same arena, then ResolveMoves moves them at once
+		m_berserker = FillHead(m_berserker, m_berserkerDistance);
+		m_filler = FillHead(m_filler, m_fillerDistance);
+		catchImmobilised(m_berserker);
+		catchImmobilised(m_filler);
+
+		//every decision is timed against the move budget: a slow AI would hold up the whole cycle
+		//filling the head and the loss check stay outside the timer, they aren't the AI's work
+		if(!m_isMatchOver)
+		{
+			LARGE_INTEGER start;
+			QueryPerformanceCounter(&start);
+			m_berserker = CheckMoveBudget(m_berserker, MoveAIplayer(m_berserker), start, m_berserkerLatency);
+			QueryPerformanceCounter(&start);
+			m_filler = CheckMoveBudget(m_filler, MoveAIplayer(m_filler,0), start, m_fillerLatency);
+		}
+
+		//no moves are made once an AI lost, and the result is recorded once for the whole tick
+		if(!m_isMatchOver) ResolveMoves();
+		if(m_isMatchOver) FinishMatch();
 	}
 
 	//Draw the rigid cells
@@ -162,11 +190,11 @@ void AIchallenge::DrawAIplayer(AI_PLAYER player)
 void AIchallenge::DrawRigidBodies()
 {
 	GAME_ENGINE->SetColor(RGB(120,120,120));
-	for(int x = 0;x < GAME_ENGINE->GetWidth() / m_gridSize;++x)
+	for(int x = 0;x < m_arena.GetWidth();++x)
 	{
-		for(int y = 0; y < (GAME_ENGINE->GetHeight() / m_gridSize);++y)
+		for(int y = 0; y < m_arena.GetHeight();++y)
 		{
-			if(m_isRigidCell[x][y])
+			if(m_arena.IsRigid(x,y))
 			{
 				GAME_ENGINE->FillRect(x * m_gridSize + 1, y * m_gridSize + 1, m_gridSize - 1, m_gridSize - 1);
 			}
@@ -174,88 +202,183 @@ void AIchallenge::DrawRigidBodies()
 	}
 }
 
+AI_PLAYER AIchallenge::FillHead(AI_PLAYER player, DistanceField<ArenaGrid>& distanceRef)
+{
+	//the cell the AI stands on becomes part of its wall
+	//its distance field moves along first: a step to the next cell is cheaper than a new search
+	if(!m_arena.IsRigid(player.xPos, player.yPos)) player.cellsFilled++;
+	distanceRef.SetSource(player.xPos, player.yPos);
+	MakeRigid(player.xPos, player.yPos);
+	return player;
+}
+
 AI_PLAYER AIchallenge::MoveAIplayer(AI_PLAYER player)
 {
-	//random move algorythm
-	m_isRigidCell[player.xPos][player.yPos] = true;
+	//random move algorythm: only decides the direction, ResolveMoves makes the move (a rigid cell keeps it in place)
 	player.direction = rand() % 4;
-	
-	//catch loss (fix:wallDrawn)
-	if(m_isRigidCell[player.xPos -1][player.yPos] &&
-		m_isRigidCell[player.xPos][player.yPos-1] &&
-		m_isRigidCell[player.xPos+1][player.yPos] &&
-		m_isRigidCell[player.xPos][player.yPos+1])
+	return player;
+}
+
+AI_PLAYER AIchallenge::MoveAIplayer(AI_PLAYER player, int pattern)
+{
+	//Fill Algorythm: the first free neighbour, left (0), up (1), right (2), down (3); ResolveMoves makes the move
+	if(!m_arena.IsRigid(player.xPos - 1, player.yPos))
 	{
-		GAME_ENGINE->MessageBox(String(player.name) + " lost the game");
-		GAME_ENGINE->SetFrameRate(0);
+		player.direction = 0;
 	}
-	else
+	else if(!m_arena.IsRigid(player.xPos, player.yPos -1))
 	{
-		//catch rigidwall
-		switch(player.direction)
-		{
-		case 0:
-			if(player.xPos <= 0) break;
-			if(m_isRigidCell[player.xPos -1][player.yPos])break;
-			player.xPos--;
-			break;
-		case 1:
-			if(player.yPos <= 0) break;
-			if(m_isRigidCell[player.xPos][player.yPos-1])break;
-			player.yPos--;
-			break;
-		case 2:
-			if(player.xPos >= GAME_ENGINE->GetWidth() / m_gridSize) break;
-			if(m_isRigidCell[player.xPos+1][player.yPos])break;
-			player.xPos++;
-			break;
-		case 3:
-			if(player.yPos >= GAME_ENGINE->GetHeight() / m_gridSize) break;
-			if(m_isRigidCell[player.xPos][player.yPos+1])break;
-			player.yPos++;
-			break;
-		default:
-			break;
-		}
+		player.direction = 1;
+	}
+	else if(!m_arena.IsRigid(player.xPos + 1, player.yPos))
+	{
+		player.direction = 2;
+	}
+	else if(!m_arena.IsRigid(player.xPos, player.yPos +1))
+	{
+		player.direction = 3;
 	}
 	return player;
 }
 
-AI_PLAYER AIchallenge::MoveAIplayer(AI_PLAYER player, int pattern)
+void AIchallenge::catchImmobilised(AI_PLAYER player)
+{
+	if(m_arena.IsImmobilised(player.xPos, player.yPos))
+	{
+		RecordLoss(player, LOSS_IMMOBILISED);
+	}
+}
+
+void AIchallenge::RecordLoss(AI_PLAYER player, LOSS_CAUSE cause)
 {
-	//Fill Algorythm
-	m_isRigidCell[player.xPos][player.yPos] = true;
+	//player 0 is the berserker, player 1 the filler; only the first cause of a player counts
+	int loser = player.name == m_berserker.name ? 0 : 1;
+	if(m_lossCauses[loser] == LOSS_NONE) m_lossCauses[loser] = cause;
+	m_isMatchOver = true;
+}
+
+void AIchallenge::FinishMatch()
+{
+	//when both AIs lost in the same tick, e.g. head-on or both immobilised, it is a draw
+	AI_PLAYER players[2] = { m_berserker, m_filler };
+	bool hasLost[2] = { m_lossCauses[0] != LOSS_NONE, m_lossCauses[1] != LOSS_NONE };
+
+	MATCH_SAMPLE sample;
+	sample.matchId = m_matchCount++;
+	sample.tickCount = _fpst / 2 + 1;
+	sample.winner = hasLost[0] && hasLost[1] ? -1 : (hasLost[0] ? 1 : 0);
+	for(int i = 0; i < 2; ++i)
+	{
+		sample.lossCauses[i] = m_lossCauses[i];
+		sample.cellsFilled[i] = players[i].cellsFilled;
+		sample.survivalTicks[i] = sample.tickCount;
+	}
+	StatisticsBuffer* bufferPtr = m_statistics.GetThreadBuffer();
+	bufferPtr->RecordMatch(sample);
+	bufferPtr->Flush();
+
+	ReportLatency(m_berserker.name, m_berserkerLatency);
+	ReportLatency(m_filler.name, m_fillerLatency);
 
-	if(!m_isRigidCell[player.xPos - 1][player.yPos])
+	String message("");
+	if(sample.winner == -1)
+	{
+		message = m_lossCauses[0] == LOSS_COLLISION ? String("Head-on collision: a draw") : String("Both AIs lost the game: a draw");
+	}
+	else
 	{
-		player.xPos--;
+		int loser = 1 - sample.winner;
+		message = String(players[loser].name) + " lost the game";
+		if(m_lossCauses[loser] == LOSS_FORFEIT) message += String(": over its move budget");
 	}
-	else if(!m_isRigidCell[player.xPos][player.yPos -1])
+	GAME_ENGINE->MessageBox(message);
+	GAME_ENGINE->SetFrameRate(0);
+}
+
+AI_PLAYER AIchallenge::CheckMoveBudget(AI_PLAYER before, AI_PLAYER after, LARGE_INTEGER start, LatencyHistogram& latencyRef)
+{
+	LARGE_INTEGER end, frequency;
+	QueryPerformanceCounter(&end);
+	QueryPerformanceFrequency(&frequency);
+	LONGLONG nanoseconds = (LONGLONG) ((end.QuadPart - start.QuadPart) * (1e9 / (double) frequency.QuadPart));
+	latencyRef.Record(nanoseconds);
+	if(nanoseconds <= m_moveBudget) return after;
+
+	//the AI has decided by now, so the policy can only correct its decision afterwards
+	if(m_budgetPolicy == BUDGET_FORFEIT)
 	{
-		player.yPos--;
+		RecordLoss(after, LOSS_FORFEIT);
 	}
-	else if(!m_isRigidCell[player.xPos + 1][player.yPos])
+	else if(m_budgetPolicy == BUDGET_DEFAULT_MOVE)
 	{
-		player.xPos++;
+		//the default move goes to its first free neighbour instead
+		for(int direction = 0; direction < 4; ++direction)
+		{
+			if(!m_arena.IsRigid(before.xPos + DIRECTION_DX[direction], before.yPos + DIRECTION_DY[direction]))
+			{
+				after.direction = direction;
+				break;
+			}
+		}
 	}
-	else if(!m_isRigidCell[player.xPos][player.yPos +1])
+	else
 	{
-		player.yPos++;
+		OutputDebugString(String(after.name) + " over its move budget: " + nanoseconds / 1000.0 + " us\n");
 	}
-	catchImmobilised(player);
-	return player;
+	return after;
 }
 
-void AIchallenge::catchImmobilised(AI_PLAYER player)
+void AIchallenge::ResolveMoves()
 {
-	if(m_isRigidCell[player.xPos -1][player.yPos] &&
-	m_isRigidCell[player.xPos][player.yPos-1] &&
-	m_isRigidCell[player.xPos+1][player.yPos] &&
-	m_isRigidCell[player.xPos][player.yPos+1])
+	CELL positions[2] = { { m_berserker.xPos, m_berserker.yPos }, { m_filler.xPos, m_filler.yPos } };
+	int directions[2] = { m_berserker.direction, m_filler.direction };
+	m_tickResolver.Gather(m_arena, positions, directions, 2);
+	m_tickResolver.Resolve();
+
+	if(m_tickResolver.GetCollisionCount() > 0)
 	{
-		GAME_ENGINE->MessageBox(String(player.name) + " lost the game");
-		GAME_ENGINE->SetFrameRate(0);
+		//head-on: both lose
+		RecordLoss(m_berserker, LOSS_COLLISION);
+		RecordLoss(m_filler, LOSS_COLLISION);
+		return;
 	}
+
+	//only the positions are committed: the cells become rigid through MakeRigid when the AIs move on, so the listeners hear of them
+	CELL berserker = m_tickResolver.GetTarget(0), filler = m_tickResolver.GetTarget(1);
+	m_berserker.xPos = berserker.x;
+	m_berserker.yPos = berserker.y;
+	m_filler.xPos = filler.x;
+	m_filler.yPos = filler.y;
+}
+
+void AIchallenge::ReportLatency(const String& name, const LatencyHistogram& latencyRef)
+{
+	OutputDebugString(String(name) + " moves: " + (int) latencyRef.GetCount() + " p50 " + latencyRef.GetPercentile(0.5) / 1000.0
+		+ " us, p99 " + latencyRef.GetPercentile(0.99) / 1000.0 + " us, max " + latencyRef.GetMax() / 1000.0 + " us\n");
+}
+
+void AIchallenge::MakeRigid(int x, int y)
+{
+	if(m_arena.IsRigid(x,y)) return;
+	m_arena.SetRigid(x,y);
+	for(size_t i = 0; i < m_rigidCellListeners.size(); ++i)
+	{
+		m_rigidCellListeners[i]->CellBecameRigid(x,y);
+	}
+}
+
+void AIchallenge::AddRigidCellListener(RigidCellListener* listenerPtr)
+{
+	if(find(m_rigidCellListeners.begin(), m_rigidCellListeners.end(), listenerPtr) == m_rigidCellListeners.end())
+	{
+		m_rigidCellListeners.push_back(listenerPtr);
+	}
+}
+
+void AIchallenge::RemoveRigidCellListener(RigidCellListener* listenerPtr)
+{
+	vector<RigidCellListener*>::iterator pos = find(m_rigidCellListeners.begin(), m_rigidCellListeners.end(), listenerPtr);
+	if(pos != m_rigidCellListeners.end()) m_rigidCellListeners.erase(pos);
 }
 
 void AIchallenge::CallAction(Caller* callerPtr)
@@ -14,6 +14,12 @@
 #include "Resource.h"	
 #include "GameEngine.h"
 #include "AbstractGame.h"
+#include "ArenaGrid.h"
+#include "RigidCellListener.h"
+#include "DistanceField.h"
+#include "MatchStatistics.h"
+#include "LatencyHistogram.h"
+#include "TickResolver.h"
 
 
 //-----------------------------------------------------------------
@@ -39,6 +45,7 @@ struct AI_PLAYER
 	COLORREF playerColor, fillColor;
 	//DIRECTION direction;
 	int direction;
+	int cellsFilled;
 };
 
 struct GRID
@@ -83,10 +90,19 @@ public:
 	void GameCycle(RECT rect);
 	void DrawAIplayer(AI_PLAYER player);
 	void DrawRigidBodies();
+	AI_PLAYER FillHead(AI_PLAYER player, DistanceField<ArenaGrid>& distanceRef);
 	AI_PLAYER MoveAIplayer(AI_PLAYER player);
 	AI_PLAYER MoveAIplayer(AI_PLAYER player, int pattern);
 	void catchImmobilised(AI_PLAYER player);
+	void RecordLoss(AI_PLAYER player, LOSS_CAUSE cause);
+	void FinishMatch();
+	AI_PLAYER CheckMoveBudget(AI_PLAYER before, AI_PLAYER after, LARGE_INTEGER start, LatencyHistogram& latencyRef);
+	void ResolveMoves();
+	void ReportLatency(const String& name, const LatencyHistogram& latencyRef);
 	bool IsDeathCorner(int x, int y);
+	void MakeRigid(int x, int y);
+	void AddRigidCellListener(RigidCellListener* listenerPtr);
+	void RemoveRigidCellListener(RigidCellListener* listenerPtr);
 
 	void CallAction(Caller* callerPtr);
 
@@ -98,7 +114,22 @@ private:
 	AI_PLAYER m_default;
 	AI_PLAYER m_berserker, m_filler;
 	//GRID m_isRigidCell;
-	bool **m_isRigidCell;
+	ArenaGrid m_arena;
+	vector<RigidCellListener*> m_rigidCellListeners;
+	//distance from each player to every cell, kept up to date across moves
+	DistanceField<ArenaGrid> m_berserkerDistance, m_fillerDistance;
+	//one summary per match in temp\\matches.csv
+	MatchStatistics m_statistics;
+	int m_matchCount;
+	//losses of the current tick: the match ends once, after both AIs are handled
+	LOSS_CAUSE m_lossCauses[2];
+	bool m_isMatchOver;
+	//time of every move per AI, reported when the match ends; a move over budget is dealt with by the budget policy
+	LatencyHistogram m_berserkerLatency, m_fillerLatency;
+	LONGLONG m_moveBudget;
+	BUDGET_POLICY m_budgetPolicy;
+	//moves both AIs at once, after both have decided
+	TickResolver m_tickResolver;
 	// -------------------------
 	// Disabling default copy constructor and default assignment operator.
 	// If you get a linker error from one of these functions, your class is internally trying to use them. This is
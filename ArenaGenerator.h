@@ -0,0 +1,338 @@
+//-----------------------------------------------------------------
+// ArenaGenerator Object
+// C++ Header - ArenaGenerator.h - version 2010 v2_07
+//
+// ArenaGenerator builds test arenas from a seed: mazes, rooms joined by
+// corridors, caves grown with a cellular automaton, and randomly
+// scattered obstacles. The same kind, size, density and seed always give
+// the same arena, so benchmarks and tournaments can regenerate their
+// workloads instead of storing them. Every arena gets the wall ring of
+// the AIchallenge arena and is written into any arena grid.
+//
+// What density means depends on the kind:
+//	MAZE		the fraction of the maze walls that is kept, below 1 the maze gets loops
+//	ROOMS		the fraction of the arena that stays rigid around the rooms and corridors
+//	CAVE		the chance a cell starts out rigid before the automaton smooths it, 0.45 looks natural
+//	OBSTACLES	the chance a cell is rigid
+//-----------------------------------------------------------------
+
+#pragma once
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#include "ArenaGrid.h"
+#include "Random.h"
+#include <vector>
+#include <algorithm>
+#include <stdint.h>
+
+//-----------------------------------------------------------------
+// ArenaGenerator Class
+//-----------------------------------------------------------------
+class ArenaGenerator
+{
+public:
+	enum Kind
+	{
+		MAZE,
+		ROOMS,
+		CAVE,
+		OBSTACLES
+	};
+	static const int KIND_COUNT = 4;
+	static const int CAVE_STEPS = 5;
+
+	//---------------------------
+	// Constructor(s)
+	//---------------------------
+	ArenaGenerator() : m_width(0), m_height(0)
+	{
+	}
+
+	//---------------------------
+	// Destructor
+	//---------------------------
+	virtual ~ArenaGenerator()
+	{
+	}
+
+	//---------------------------
+	// General Methods
+	//---------------------------
+
+	// recreates the grid at the given size; the free cells of caves and rooms are all connected
+	template<class Grid>
+	void Generate(Grid& gridRef, Kind kind, int width, int height, double density, uint64_t seed)
+	{
+		m_random.Seed(seed * KIND_COUNT + kind);
+		m_width = width;
+		m_height = height;
+		m_cells.assign(width * height, 1);
+
+		switch (kind)
+		{
+		case MAZE: CarveMaze(density); break;
+		case ROOMS: CarveRooms(density); break;
+		case CAVE: GrowCave(density); break;
+		case OBSTACLES: ScatterObstacles(density); break;
+		}
+		AddWallRing();
+		if (kind == ROOMS || kind == CAVE) KeepLargestRegion();
+
+		gridRef.Create(width, height);
+		for (int y = 0; y < height; ++y)
+		{
+			for (int x = 0; x < width; ++x)
+			{
+				if (m_cells[y * width + x]) gridRef.SetRigid(x, y);
+			}
+		}
+	}
+
+	// a random free cell of the arena generated last, e.g. to place a player; {-1, -1} when there is none
+	CELL FindFreeCell()
+	{
+		CELL cell = { -1, -1 };
+		int freeCount = CountFreeCells();
+		if (freeCount == 0) return cell;
+		int skip = m_random.NextInt(freeCount);
+		for (int i = 0; i < (int) m_cells.size(); ++i)
+		{
+			if (m_cells[i] == 0 && skip-- == 0)
+			{
+				cell.x = i % m_width;
+				cell.y = i / m_width;
+				break;
+			}
+		}
+		return cell;
+	}
+
+	int CountFreeCells() const
+	{
+		return (int) std::count(m_cells.begin(), m_cells.end(), (unsigned char) 0);
+	}
+
+	static const char* GetKindName(Kind kind)
+	{
+		static const char* namesPtr[KIND_COUNT] = { "maze", "rooms", "cave", "obstacles" };
+		return namesPtr[kind];
+	}
+
+private:
+	// -------------------------
+	// Internal structs
+	// -------------------------
+	struct Room
+	{
+		int left, top, right, bottom;		// inclusive
+	};
+
+	// -------------------------
+	// Member functions
+	// -------------------------
+	bool IsInside(int x, int y) const { return x > 0 && y > 0 && x < m_width - 1 && y < m_height - 1; }
+	unsigned char& Cell(int x, int y) { return m_cells[y * m_width + x]; }
+
+	void AddWallRing()
+	{
+		for (int x = 0; x < m_width; ++x)
+		{
+			Cell(x, 0) = 1;
+			Cell(x, m_height - 1) = 1;
+		}
+		for (int y = 0; y < m_height; ++y)
+		{
+			Cell(0, y) = 1;
+			Cell(m_width - 1, y) = 1;
+		}
+	}
+
+	// depth first backtracker over the cells with odd coordinates, the cells in between are the walls
+	void CarveMaze(double density)
+	{
+		if (!IsInside(1, 1)) return;
+		std::vector<CELL> stack;
+		CELL start = { 1, 1 };
+		Cell(1, 1) = 0;
+		stack.push_back(start);
+		while (!stack.empty())
+		{
+			CELL cell = stack.back();
+			int directions[4], count = 0;
+			for (int direction = 0; direction < 4; ++direction)
+			{
+				int x = cell.x + 2 * DIRECTION_DX[direction], y = cell.y + 2 * DIRECTION_DY[direction];
+				if (IsInside(x, y) && Cell(x, y)) directions[count++] = direction;
+			}
+			if (count == 0)
+			{
+				stack.pop_back();
+				continue;
+			}
+			int direction = directions[m_random.NextInt(count)];
+			Cell(cell.x + DIRECTION_DX[direction], cell.y + DIRECTION_DY[direction]) = 0;
+			CELL next = { cell.x + 2 * DIRECTION_DX[direction], cell.y + 2 * DIRECTION_DY[direction] };
+			Cell(next.x, next.y) = 0;
+			stack.push_back(next);
+		}
+
+		// knocking out walls between two corridors adds loops
+		for (int y = 1; y < m_height - 1; ++y)
+		{
+			for (int x = 1 + (y & 1); x < m_width - 1; x += 2)
+			{
+				if (!Cell(x, y)) continue;
+				bool isBetweenColumns = (y & 1) != 0;
+				int dx = isBetweenColumns ? 1 : 0, dy = isBetweenColumns ? 0 : 1;
+				if (!IsInside(x + dx, y + dy) || Cell(x - dx, y - dy) || Cell(x + dx, y + dy)) continue;
+				if (!m_random.NextChance(density)) Cell(x, y) = 0;
+			}
+		}
+	}
+
+	// random rooms that don't touch, each joined to the one before by an L shaped corridor
+	void CarveRooms(double density)
+	{
+		int innerCount = std::max(m_width - 2, 0) * std::max(m_height - 2, 0);
+		int freeTarget = (int) (innerCount * (1.0 - density));
+		int maxSide = std::max(std::min(m_width, m_height) / 6, 3);
+		std::vector<Room> rooms;
+		int freeCount = 0;
+		for (int attempt = 0; attempt < 64 + innerCount / 16 && freeCount < freeTarget; ++attempt)
+		{
+			Room room;
+			int roomWidth = m_random.NextInt(3, maxSide), roomHeight = m_random.NextInt(3, maxSide);
+			if (roomWidth > m_width - 2 || roomHeight > m_height - 2) continue;
+			room.left = m_random.NextInt(1, m_width - 1 - roomWidth);
+			room.top = m_random.NextInt(1, m_height - 1 - roomHeight);
+			room.right = room.left + roomWidth - 1;
+			room.bottom = room.top + roomHeight - 1;
+
+			bool isOverlapping = false;
+			for (size_t i = 0; i < rooms.size() && !isOverlapping; ++i)
+			{
+				const Room& otherRef = rooms[i];
+				isOverlapping = room.left <= otherRef.right + 1 && otherRef.left <= room.right + 1 && room.top <= otherRef.bottom + 1 && otherRef.top <= room.bottom + 1;
+			}
+			if (isOverlapping) continue;
+
+			for (int y = room.top; y <= room.bottom; ++y)
+			{
+				for (int x = room.left; x <= room.right; ++x) freeCount += Free(x, y);
+			}
+			if (!rooms.empty())
+			{
+				const Room& previousRef = rooms.back();
+				int x = (room.left + room.right) / 2, y = (room.top + room.bottom) / 2;
+				int goalX = (previousRef.left + previousRef.right) / 2, goalY = (previousRef.top + previousRef.bottom) / 2;
+				bool isHorizontalFirst = m_random.NextChance(0.5);
+				int cornerX = isHorizontalFirst ? goalX : x, cornerY = isHorizontalFirst ? y : goalY;
+				// from the room to the corner and on to the previous room; two of the four legs are a single cell
+				for (int step = std::min(x, cornerX); step <= std::max(x, cornerX); ++step) freeCount += Free(step, y);
+				for (int step = std::min(y, cornerY); step <= std::max(y, cornerY); ++step) freeCount += Free(x, step);
+				for (int step = std::min(cornerX, goalX); step <= std::max(cornerX, goalX); ++step) freeCount += Free(step, cornerY);
+				for (int step = std::min(cornerY, goalY); step <= std::max(cornerY, goalY); ++step) freeCount += Free(cornerX, step);
+			}
+			rooms.push_back(room);
+		}
+	}
+
+	// returns 1 when the cell was rigid
+	int Free(int x, int y)
+	{
+		unsigned char& cellRef = Cell(x, y);
+		int wasRigid = cellRef;
+		cellRef = 0;
+		return wasRigid;
+	}
+
+	// random fill, then every step a cell becomes rigid when at least 5 of the 9 cells around it are
+	void GrowCave(double density)
+	{
+		ScatterObstacles(density);
+		std::vector<unsigned char> next(m_cells.size(), 1);
+		for (int step = 0; step < CAVE_STEPS; ++step)
+		{
+			for (int y = 1; y < m_height - 1; ++y)
+			{
+				for (int x = 1; x < m_width - 1; ++x)
+				{
+					int rigidCount = 0;
+					for (int dy = -1; dy <= 1; ++dy)
+					{
+						const unsigned char* rowPtr = &m_cells[(y + dy) * m_width + x - 1];
+						rigidCount += rowPtr[0] + rowPtr[1] + rowPtr[2];
+					}
+					next[y * m_width + x] = rigidCount >= 5 ? 1 : 0;
+				}
+			}
+			m_cells.swap(next);
+		}
+	}
+
+	void ScatterObstacles(double density)
+	{
+		for (int y = 1; y < m_height - 1; ++y)
+		{
+			for (int x = 1; x < m_width - 1; ++x)
+			{
+				Cell(x, y) = m_random.NextChance(density) ? 1 : 0;
+			}
+		}
+	}
+
+	// fills every free region but the biggest, so players can always reach each other
+	void KeepLargestRegion()
+	{
+		std::vector<int> regions(m_cells.size(), -1);
+		std::vector<int> queue;
+		int largestRegion = -1, largestSize = 0, regionCount = 0;
+		for (int start = 0; start < (int) m_cells.size(); ++start)
+		{
+			if (m_cells[start] || regions[start] != -1) continue;
+			queue.clear();
+			queue.push_back(start);
+			regions[start] = regionCount;
+			for (size_t head = 0; head < queue.size(); ++head)
+			{
+				// the wall ring keeps every neighbour inside the buffer
+				int index = queue[head];
+				int neighbours[4] = { index - 1, index - m_width, index + 1, index + m_width };
+				for (int direction = 0; direction < 4; ++direction)
+				{
+					int neighbour = neighbours[direction];
+					if (m_cells[neighbour] || regions[neighbour] != -1) continue;
+					regions[neighbour] = regionCount;
+					queue.push_back(neighbour);
+				}
+			}
+			if ((int) queue.size() > largestSize)
+			{
+				largestSize = (int) queue.size();
+				largestRegion = regionCount;
+			}
+			++regionCount;
+		}
+		for (size_t i = 0; i < m_cells.size(); ++i)
+		{
+			if (!m_cells[i] && regions[i] != largestRegion) m_cells[i] = 1;
+		}
+	}
+
+	// -------------------------
+	// Datamembers
+	// -------------------------
+	Random m_random;
+	int m_width, m_height;
+	std::vector<unsigned char> m_cells;		// the arena generated last, 1 for rigid
+
+	// -------------------------
+	// Disabling default copy constructor and default assignment operator.
+	// If you get a linker error from one of these functions, your class is internally trying to use them. This is
+	// an error in your class, these declarations are deliberately made without implementation because they should never be used.
+	// -------------------------
+	ArenaGenerator(const ArenaGenerator& agRef);
+	ArenaGenerator& operator=(const ArenaGenerator& agRef);
+};
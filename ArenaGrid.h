@@ -0,0 +1,181 @@
+//-----------------------------------------------------------------
+// ArenaGrid Object
+// C++ Header - ArenaGrid.h - version 2010 v2_07
+//
+// ArenaGrid holds the rigid cells of the arena, surrounded by one ring
+// of rigid sentinel cells, so every neighbour of a cell inside the arena
+// can be read without a bounds check.
+// How the cells are laid out in memory is decided by a layout class:
+// RowMajorLayout stores them row by row (ArenaGrid), TiledLayout stores
+// them in 8x8 tiles (TiledArenaGrid) so vertical neighbours share cache lines.
+//-----------------------------------------------------------------
+
+#pragma once
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#include <vector>
+
+//-----------------------------------------------------------------
+// Direction steps, indexed like DIRECTION (left, up, right, down)
+//-----------------------------------------------------------------
+static const int DIRECTION_DX[4] = { -1, 0, 1, 0 };
+static const int DIRECTION_DY[4] = { 0, -1, 0, 1 };
+
+//-----------------------------------------------------------------
+// Structs
+//-----------------------------------------------------------------
+struct CELL
+{
+	int x, y;
+};
+
+//-----------------------------------------------------------------
+// RowMajorLayout Class
+//-----------------------------------------------------------------
+class RowMajorLayout
+{
+public:
+	void Create(int width, int height)
+	{
+		m_stride = width + 2;
+		m_cellCount = m_stride * (height + 2);
+	}
+
+	int Index(int x, int y) const { return (y + 1) * m_stride + x + 1; }
+	int GetCellCount() const { return m_cellCount; }
+
+private:
+	int m_stride;
+	int m_cellCount;
+};
+
+//-----------------------------------------------------------------
+// TiledLayout Class
+//-----------------------------------------------------------------
+class TiledLayout
+{
+public:
+	void Create(int width, int height)
+	{
+		m_tilesX = (width + 2 + 7) >> 3;
+		m_cellCount = m_tilesX * ((height + 2 + 7) >> 3) * 64;
+	}
+
+	// tiles are stored row by row, the 64 cells inside a tile as well
+	int Index(int x, int y) const
+	{
+		int px = x + 1, py = y + 1;
+		return (((py >> 3) * m_tilesX + (px >> 3)) << 6) | ((py & 7) << 3) | (px & 7);
+	}
+	int GetCellCount() const { return m_cellCount; }
+
+private:
+	int m_tilesX;
+	int m_cellCount;
+};
+
+//-----------------------------------------------------------------
+// BasicArenaGrid Class
+//-----------------------------------------------------------------
+template<class Layout>
+class BasicArenaGrid
+{
+public:
+	//---------------------------
+	// Constructor(s)
+	//---------------------------
+	BasicArenaGrid()
+	{
+		Create(0, 0);
+	}
+
+	BasicArenaGrid(int width, int height)
+	{
+		Create(width, height);
+	}
+
+	//---------------------------
+	// General Methods
+	//---------------------------
+	void Create(int width, int height)		// all cells free, sentinel ring rigid
+	{
+		m_width = width;
+		m_height = height;
+		m_layout.Create(width, height);
+
+		//everything rigid, then free the inside: only the sentinel ring (and tile padding) stays rigid
+		m_cells.assign(m_layout.GetCellCount(), 1);
+		Clear();
+	}
+
+	void Clear()							// frees every cell inside the arena
+	{
+		for (int y = 0; y < m_height; ++y)
+		{
+			for (int x = 0; x < m_width; ++x)
+			{
+				m_cells[m_layout.Index(x, y)] = 0;
+			}
+		}
+	}
+
+	void AddWallRing()						// makes the outer cells of the arena rigid, like the original arena
+	{
+		for (int x = 0; x < m_width; ++x)
+		{
+			SetRigid(x, 0);
+			SetRigid(x, m_height - 1);
+		}
+		for (int y = 0; y < m_height; ++y)
+		{
+			SetRigid(0, y);
+			SetRigid(m_width - 1, y);
+		}
+	}
+
+	template<class OtherGrid>
+	void Assign(const OtherGrid& otherRef)	// copies the cells of a grid with any layout
+	{
+		Create(otherRef.GetWidth(), otherRef.GetHeight());
+		for (int y = 0; y < m_height; ++y)
+		{
+			for (int x = 0; x < m_width; ++x)
+			{
+				m_cells[m_layout.Index(x, y)] = otherRef.IsRigid(x, y) ? 1 : 0;
+			}
+		}
+	}
+
+	int GetWidth() const { return m_width; }
+	int GetHeight() const { return m_height; }
+
+	// x and y may be anything from -1 up to and including width/height: the sentinel ring is addressable
+	int Index(int x, int y) const { return m_layout.Index(x, y); }
+	int GetCellCount() const { return m_layout.GetCellCount(); }
+
+	int GetCell(int x, int y) const { return m_cells[m_layout.Index(x, y)]; }		// 0 = free, 1 = rigid
+	bool IsRigid(int x, int y) const { return m_cells[m_layout.Index(x, y)] != 0; }
+	void SetRigid(int x, int y) { m_cells[m_layout.Index(x, y)] = 1; }
+	void SetFree(int x, int y) { m_cells[m_layout.Index(x, y)] = 0; }
+
+	int CountRigidNeighbours(int x, int y) const
+	{
+		return GetCell(x - 1, y) + GetCell(x, y - 1) + GetCell(x + 1, y) + GetCell(x, y + 1);
+	}
+	bool IsImmobilised(int x, int y) const { return CountRigidNeighbours(x, y) == 4; }
+
+	// BasicArenaGrid is a value type on purpose: copying it gives an independent snapshot of the arena
+
+private:
+	// -------------------------
+	// Datamembers
+	// -------------------------
+	int m_width, m_height;
+	Layout m_layout;
+	std::vector<unsigned char> m_cells;
+};
+
+typedef BasicArenaGrid<RowMajorLayout> ArenaGrid;
+typedef BasicArenaGrid<TiledLayout> TiledArenaGrid;
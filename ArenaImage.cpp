@@ -0,0 +1,160 @@
+//-----------------------------------------------------------------
+// ArenaImage Object
+// C++ Source - ArenaImage.cpp - version 2010 v2_07
+//-----------------------------------------------------------------
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#include "ArenaImage.h"
+#include "GameEngine.h"
+#include <algorithm>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__SSE2__)
+#define ARENA_IMAGE_SSE2
+#include <emmintrin.h>
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// TargaLoader::Load returns IMG_OK (GameEngine.cpp) on success
+static const int TARGA_OK = 0x1;
+
+//-----------------------------------------------------------------
+// ArenaImage methods
+//-----------------------------------------------------------------
+ArenaImage::ArenaImage()
+{
+	Create(0, 0);
+}
+
+ArenaImage::~ArenaImage()
+{
+	// nothing to destroy
+}
+
+bool ArenaImage::Load(TCHAR* filenamePtr, int threshold)
+{
+	TargaLoader loader;
+	if (loader.Load(filenamePtr) != TARGA_OK || loader.GetBPP() != 8) return false;
+
+	int width = loader.GetWidth(), height = loader.GetHeight();
+	const unsigned char* pixelsPtr = loader.GetImg();
+	const unsigned char* palettePtr = loader.GetPalette();
+	if (palettePtr == NULL)
+	{
+		Threshold(pixelsPtr, width, height, threshold);
+		return true;
+	}
+
+	// indexed: one look up table from palette index to grey, then the same pass over every translated row
+	unsigned char grey[256];
+	for (int colour = 0; colour < 256; ++colour)
+	{
+		const unsigned char* rgbPtr = &palettePtr[colour * 3];
+		grey[colour] = (unsigned char) ((rgbPtr[0] * 77 + rgbPtr[1] * 150 + rgbPtr[2] * 29) >> 8);
+	}
+	Create(width, height);
+	m_greyRow.resize(width);
+	threshold = std::min(std::max(threshold, 0), 255);
+	for (int y = 0; y < height; ++y)
+	{
+		const unsigned char* rowPtr = &pixelsPtr[y * width];
+		for (int x = 0; x < width; ++x) m_greyRow[x] = grey[rowPtr[x]];
+		ThresholdRow(&m_greyRow[0], threshold, &m_rigidBits[y * m_wordsPerRow]);
+	}
+	return true;
+}
+
+void ArenaImage::Threshold(const unsigned char* pixelsPtr, int width, int height, int threshold)
+{
+	Create(width, height);
+	threshold = std::min(std::max(threshold, 0), 255);
+	for (int y = 0; y < height; ++y)
+	{
+		ThresholdRow(&pixelsPtr[y * width], threshold, &m_rigidBits[y * m_wordsPerRow]);
+	}
+}
+
+int ArenaImage::CountRigidCells() const
+{
+	int count = 0;
+	for (size_t i = 0; i < m_rigidBits.size(); ++i)
+	{
+		for (uint64_t bits = m_rigidBits[i]; bits != 0; bits &= bits - 1) ++count;
+	}
+	return count;
+}
+
+void ArenaImage::CopyTo(ChunkedArenaGrid& gridRef) const
+{
+	gridRef.Create(m_width, m_height);
+	for (int y = 0; y < m_height; ++y)
+	{
+		const uint64_t* rowPtr = GetRow(y);
+		for (int word = 0; word < m_wordsPerRow; ++word)
+		{
+			if (rowPtr[word] != 0) gridRef.SetRigidBits(word << 6, y, rowPtr[word]);
+		}
+	}
+}
+
+void ArenaImage::Create(int width, int height)
+{
+	m_width = width;
+	m_height = height;
+	m_wordsPerRow = (width + 63) >> 6;
+	m_rigidBits.assign(m_wordsPerRow * height, 0);
+}
+
+// sets the bit of every pixel darker than the threshold, the bits past the width stay 0
+void ArenaImage::ThresholdRow(const unsigned char* pixelsPtr, int threshold, uint64_t* rowPtr) const
+{
+	int x = 0;
+#ifdef ARENA_IMAGE_SSE2
+	int fullWords = m_width >> 6;
+	// SSE2 only compares signed bytes: flipping the top bit of both sides keeps the unsigned order
+	const __m128i signBit = _mm_set1_epi8((char) 0x80);
+	const __m128i limit = _mm_set1_epi8((char) (threshold ^ 0x80));
+	for (int word = 0; word < fullWords; ++word, x += 64)
+	{
+		uint64_t bits = 0;
+		for (int part = 0; part < 4; ++part)
+		{
+			__m128i pixels = _mm_loadu_si128((const __m128i*) &pixelsPtr[x + part * 16]);
+			__m128i isDark = _mm_cmplt_epi8(_mm_xor_si128(pixels, signBit), limit);
+			bits |= (uint64_t) (unsigned int) _mm_movemask_epi8(isDark) << (part * 16);
+		}
+		rowPtr[word] = bits;
+	}
+#endif
+
+	// the rest of the row, or all of it without SSE2
+	for (; x < m_width; x += 64)
+	{
+		uint64_t bits = 0;
+		int count = std::min(m_width - x, 64);
+		for (int i = 0; i < count; ++i)
+		{
+			bits |= (uint64_t) (pixelsPtr[x + i] < threshold) << i;
+		}
+		rowPtr[x >> 6] = bits;
+	}
+}
+
+int ArenaImage::LowestBit(uint64_t bits)
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+	unsigned long index;
+	_BitScanForward64(&index, bits);
+	return (int) index;
+#elif defined(_MSC_VER)
+	unsigned long index;
+	if (_BitScanForward(&index, (unsigned long) bits)) return (int) index;
+	_BitScanForward(&index, (unsigned long) (bits >> 32));
+	return (int) index + 32;
+#else
+	return __builtin_ctzll(bits);
+#endif
+}
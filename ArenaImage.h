@@ -0,0 +1,103 @@
+//-----------------------------------------------------------------
+// ArenaImage Object
+// C++ Header - ArenaImage.h - version 2010 v2_07
+//
+// ArenaImage loads an arena from an 8 bit greyscale or indexed TGA file,
+// raw or RLE compressed, with the TargaLoader of the game engine. Dark
+// pixels are walls: every pixel below the threshold becomes a rigid cell,
+// one pixel per cell. The pixels are turned into rows of 64 bit words in
+// a single pass that compares 16 pixels per SSE2 instruction, and those
+// words go straight into a ChunkedArenaGrid; other grids get the cells
+// one by one.
+//-----------------------------------------------------------------
+
+#pragma once
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#include "ChunkedArenaGrid.h"
+#include <tchar.h>
+#include <vector>
+#include <stdint.h>
+
+//-----------------------------------------------------------------
+// ArenaImage Class
+//-----------------------------------------------------------------
+class ArenaImage
+{
+public:
+	static const int DEFAULT_THRESHOLD = 128;
+
+	//---------------------------
+	// Constructor(s)
+	//---------------------------
+	ArenaImage();
+
+	//---------------------------
+	// Destructor
+	//---------------------------
+	virtual ~ArenaImage();
+
+	//---------------------------
+	// General Methods
+	//---------------------------
+
+	// false when the file is missing, broken, or isn't an 8 bit greyscale or indexed TGA
+	bool Load(TCHAR* filenamePtr, int threshold = DEFAULT_THRESHOLD);
+
+	// the same from 8 bit grey pixels in memory, top row first
+	void Threshold(const unsigned char* pixelsPtr, int width, int height, int threshold = DEFAULT_THRESHOLD);
+
+	int GetWidth() const { return m_width; }
+	int GetHeight() const { return m_height; }
+	int GetWordsPerRow() const { return m_wordsPerRow; }
+	const uint64_t* GetRow(int y) const { return &m_rigidBits[y * m_wordsPerRow]; }	// bit x & 63 of word x >> 6 is set for a rigid cell
+	bool IsRigid(int x, int y) const { return ((GetRow(y)[x >> 6] >> (x & 63)) & 1) != 0; }
+	int CountRigidCells() const;
+
+	// creates the grid with the size of the image and makes the walls rigid
+	void CopyTo(ChunkedArenaGrid& gridRef) const;
+
+	template<class Grid>
+	void CopyTo(Grid& gridRef) const
+	{
+		gridRef.Create(m_width, m_height);
+		for (int y = 0; y < m_height; ++y)
+		{
+			const uint64_t* rowPtr = GetRow(y);
+			for (int word = 0; word < m_wordsPerRow; ++word)
+			{
+				// only the set bits are visited, open floor costs nothing
+				for (uint64_t bits = rowPtr[word]; bits != 0; bits &= bits - 1)
+				{
+					gridRef.SetRigid((word << 6) + LowestBit(bits), y);
+				}
+			}
+		}
+	}
+
+private:
+	// -------------------------
+	// Member functions
+	// -------------------------
+	void Create(int width, int height);
+	void ThresholdRow(const unsigned char* pixelsPtr, int threshold, uint64_t* rowPtr) const;
+	static int LowestBit(uint64_t bits);
+
+	// -------------------------
+	// Datamembers
+	// -------------------------
+	int m_width, m_height;
+	int m_wordsPerRow;
+	std::vector<uint64_t> m_rigidBits;
+	std::vector<unsigned char> m_greyRow;		// an indexed row translated through the palette
+
+	// -------------------------
+	// Disabling default copy constructor and default assignment operator.
+	// If you get a linker error from one of these functions, your class is internally trying to use them. This is
+	// an error in your class, these declarations are deliberately made without implementation because they should never be used.
+	// -------------------------
+	ArenaImage(const ArenaImage& aiRef);
+	ArenaImage& operator=(const ArenaImage& aiRef);
+};
@@ -0,0 +1,1996 @@
+//-----------------------------------------------------------------
+// Benchmark Object
+// C++ Source - Benchmark.cpp - version 2010 v2_07
+//-----------------------------------------------------------------
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#include "Benchmark.h"
+#include "ArenaGrid.h"
+#include "PathFinder.h"
+#include "ChunkedArenaGrid.h"
+#include "DistanceField.h"
+#include "DStarLitePlanner.h"
+#include "HierarchicalPathFinder.h"
+#include "CooperativePlanner.h"
+#include "FlowField.h"
+#include "PathQueryBatch.h"
+#include "PathCache.h"
+#include "CostMap.h"
+#include "WeightedPathFinder.h"
+#include "BitboardSearch.h"
+#include "ArenaImage.h"
+#include "ArenaGenerator.h"
+#include "Match.h"
+#include "MatchStatistics.h"
+#include "LatencyHistogram.h"
+#include "RatingAggregator.h"
+#include "SelfPlay.h"
+#include "ValueNetwork.h"
+#include "NetworkBot.h"
+#include "HeuristicBot.h"
+#include "ParameterTuner.h"
+#include "SymmetryBoard.h"
+#include "SearchBot.h"
+#include "TickResolver.h"
+#include "BitslicedPlayout.h"
+#include "PlayoutBot.h"
+#include "RandomBot.h"
+#include "FillBot.h"
+#include "WorkerPool.h"
+#include "Stopwatch.h"
+#include <unordered_set>
+
+//-----------------------------------------------------------------
+// Benchmark helpers
+//-----------------------------------------------------------------
+// small LCG so every variant of a benchmark sees exactly the same random sequence
+static inline int NextRandom(unsigned int& seedRef)
+{
+	seedRef = seedRef * 1103515245 + 12345;
+	return (seedRef >> 16) & 0x7fff;
+}
+
+// writes an 8 bit TGA, top row first: greyscale, or indexed with a grey palette so the indices are the grey values
+static bool WriteTarga(TCHAR* filenamePtr, const std::vector<unsigned char>& pixelsRef, int width, int height, bool isIndexed, bool isRLE)
+{
+	std::vector<unsigned char> file(18, 0);
+	file[1] = isIndexed ? 1 : 0;
+	file[2] = (unsigned char) ((isIndexed ? 1 : 3) + (isRLE ? 8 : 0));
+	if (isIndexed)
+	{
+		file[6] = 1;		// 256 palette entries of 24 bits
+		file[7] = 24;
+	}
+	file[12] = (unsigned char) (width & 0xff);
+	file[13] = (unsigned char) (width >> 8);
+	file[14] = (unsigned char) (height & 0xff);
+	file[15] = (unsigned char) (height >> 8);
+	file[16] = 8;
+	file[17] = 0x20;		// top row first
+	if (isIndexed)
+	{
+		for (int colour = 0; colour < 256; ++colour) file.insert(file.end(), 3, (unsigned char) colour);
+	}
+
+	if (!isRLE) file.insert(file.end(), pixelsRef.begin(), pixelsRef.end());
+	else
+	{
+		// runs of up to 128 equal pixels, the pixels in between as raw packets
+		size_t i = 0, pixelCount = pixelsRef.size();
+		while (i < pixelCount)
+		{
+			size_t count = 1;
+			while (i + count < pixelCount && count < 128 && pixelsRef[i + count] == pixelsRef[i]) ++count;
+			if (count > 1)
+			{
+				file.push_back((unsigned char) (0x80 | (count - 1)));
+				file.push_back(pixelsRef[i]);
+			}
+			else
+			{
+				while (i + count < pixelCount && count < 128 && (i + count + 1 == pixelCount || pixelsRef[i + count] != pixelsRef[i + count + 1])) ++count;
+				file.push_back((unsigned char) (count - 1));
+				file.insert(file.end(), pixelsRef.begin() + i, pixelsRef.begin() + i + count);
+			}
+			i += count;
+		}
+	}
+
+	HANDLE hFile = CreateFile(filenamePtr, GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (hFile == INVALID_HANDLE_VALUE) return false;
+	DWORD bytesWritten = 0;
+	WriteFile(hFile, &file[0], (DWORD) file.size(), &bytesWritten, NULL);
+	CloseHandle(hFile);
+	return bytesWritten == file.size();
+}
+
+// plays a range of berserker against filler matches on every thread, recording into the thread's own buffer
+class MatchBatchTask : public WorkerTask
+{
+public:
+	MatchBatchTask(const ArenaGrid& arenaRef, CELL firstStart, CELL secondStart, MatchStatistics* statisticsPtr, int threadCount) :
+		m_arenaRef(arenaRef), m_statisticsPtr(statisticsPtr), m_ticks(threadCount, 0)
+	{
+		m_starts[0] = firstStart;
+		m_starts[1] = secondStart;
+	}
+
+	void Execute(int thread, int first, int last)
+	{
+		RandomBot randomBot;
+		FillBot fillBot;
+		Match match;
+		StatisticsBuffer* bufferPtr = m_statisticsPtr != NULL ? m_statisticsPtr->GetThreadBuffer() : NULL;
+		match.SetStatistics(bufferPtr, 0);
+		for (int i = first; i < last; ++i)
+		{
+			match.Start(m_arenaRef, &randomBot, &fillBot, m_starts[0], m_starts[1], i, i);
+			match.Play(100000);
+			m_ticks[thread] += match.GetTickCount();
+		}
+	}
+
+	int GetTickCount() const
+	{
+		int ticks = 0;
+		for (size_t i = 0; i < m_ticks.size(); ++i) ticks += m_ticks[i];
+		return ticks;
+	}
+
+private:
+	const ArenaGrid& m_arenaRef;
+	CELL m_starts[2];
+	MatchStatistics* m_statisticsPtr;
+	std::vector<int> m_ticks;
+
+	MatchBatchTask(const MatchBatchTask& mbtRef);
+	MatchBatchTask& operator=(const MatchBatchTask& mbtRef);
+};
+
+// a filler that thinks for spinMicroseconds on every interval-th move, to put the budget policies to work
+class SlowBot : public Bot
+{
+public:
+	SlowBot(int interval, int spinMicroseconds) : m_interval(interval), m_spinMicroseconds(spinMicroseconds), m_moves(0)
+	{
+	}
+
+	const char* GetName() const { return "slow filler"; }
+
+	int ChooseDirection(const ArenaGrid& arenaRef, const CELL* positionsPtr, int player)
+	{
+		if (++m_moves % m_interval == 0)
+		{
+			Stopwatch stopwatch;
+			while (stopwatch.GetElapsedMilliseconds() * 1000.0 < m_spinMicroseconds)
+			{
+			}
+		}
+		return m_fillBot.ChooseDirection(arenaRef, positionsPtr, player);
+	}
+
+private:
+	FillBot m_fillBot;
+	int m_interval, m_spinMicroseconds, m_moves;
+};
+
+// a berserker that at least never runs into a wall: a random free neighbour every move
+class CautiousBot : public Bot
+{
+public:
+	const char* GetName() const { return "cautious (random free AI)"; }
+	void StartMatch(int player, uint64_t seed) { m_random.Seed(seed); }
+
+	int ChooseDirection(const ArenaGrid& arenaRef, const CELL* positionsPtr, int player)
+	{
+		const CELL& headRef = positionsPtr[player];
+		int directions[4], count = 0;
+		for (int direction = 0; direction < 4; ++direction)
+		{
+			if (!arenaRef.IsRigid(headRef.x + DIRECTION_DX[direction], headRef.y + DIRECTION_DY[direction])) directions[count++] = direction;
+		}
+		return count > 0 ? directions[m_random.NextInt(count)] : 0;
+	}
+
+private:
+	Random m_random;
+};
+
+// round robin between the random, cautious and fill bots, every result goes to the aggregator
+class RatingTournamentTask : public WorkerTask
+{
+public:
+	RatingTournamentTask(const ArenaGrid& arenaRef, CELL firstStart, CELL secondStart, RatingAggregator& ratingsRef, const int* idsPtr) :
+		m_arenaRef(arenaRef), m_ratingsRef(ratingsRef), m_idsPtr(idsPtr)
+	{
+		m_starts[0] = firstStart;
+		m_starts[1] = secondStart;
+	}
+
+	void Execute(int thread, int first, int last)
+	{
+		static const int pairs[6][2] = { { 0, 1 }, { 1, 0 }, { 0, 2 }, { 2, 0 }, { 1, 2 }, { 2, 1 } };
+		RandomBot randomBot;
+		CautiousBot cautiousBot;
+		FillBot fillBot;
+		Bot* botPtrs[3] = { &randomBot, &cautiousBot, &fillBot };
+		Match match;
+		for (int i = first; i < last; ++i)
+		{
+			const int* pairPtr = pairs[i % 6];
+			match.Start(m_arenaRef, botPtrs[pairPtr[0]], botPtrs[pairPtr[1]], m_starts[0], m_starts[1], i, i);
+			int winner = match.Play(100000);
+			m_ratingsRef.Submit(m_idsPtr[pairPtr[0]], m_idsPtr[pairPtr[1]], winner == Match::NO_WINNER ? 0.5 : winner == 0 ? 1.0 : 0.0);
+		}
+	}
+
+private:
+	const ArenaGrid& m_arenaRef;
+	CELL m_starts[2];
+	RatingAggregator& m_ratingsRef;
+	const int* m_idsPtr;
+
+	RatingTournamentTask(const RatingTournamentTask& rttRef);
+	RatingTournamentTask& operator=(const RatingTournamentTask& rttRef);
+};
+
+// only submits made up results, to measure the queue and the rating updates alone
+class RatingSubmitTask : public WorkerTask
+{
+public:
+	RatingSubmitTask(RatingAggregator& ratingsRef, int playerCount) : m_ratingsRef(ratingsRef), m_playerCount(playerCount)
+	{
+	}
+
+	void Execute(int thread, int first, int last)
+	{
+		for (int i = first; i < last; ++i)
+		{
+			int firstPlayer = i % m_playerCount, secondPlayer = (i / m_playerCount + firstPlayer + 1) % m_playerCount;
+			if (secondPlayer == firstPlayer) secondPlayer = (secondPlayer + 1) % m_playerCount;
+			// the lower id is the stronger player three times out of four
+			double score = (i & 3) != 0 ? 1.0 : 0.0;
+			m_ratingsRef.Submit(firstPlayer, secondPlayer, firstPlayer < secondPlayer ? score : 1.0 - score);
+		}
+	}
+
+private:
+	RatingAggregator& m_ratingsRef;
+	int m_playerCount;
+
+	RatingSubmitTask(const RatingSubmitTask& rstRef);
+	RatingSubmitTask& operator=(const RatingSubmitTask& rstRef);
+};
+
+// counts the snapshots, the last one is printed by the benchmark
+class SnapshotCounter : public LeaderboardListener
+{
+public:
+	SnapshotCounter() : m_count(0) {}
+	void LeaderboardUpdated(const std::vector<RATING>& leaderboardRef) { ++m_count; }
+	int GetCount() const { return m_count; }
+
+private:
+	int m_count;
+};
+
+// cautious bot self-play on a fresh 32 arena every match, every thread records into its own SelfPlayRecorder
+class SelfPlayTask : public WorkerTask
+{
+public:
+	SelfPlayTask(SelfPlayWriter& writerRef, int threadCount) : m_ticks(threadCount, 0)
+	{
+		for (int thread = 0; thread < threadCount; ++thread) m_recorderPtrs.push_back(new SelfPlayRecorder(&writerRef));
+	}
+
+	~SelfPlayTask()
+	{
+		for (size_t i = 0; i < m_recorderPtrs.size(); ++i) delete m_recorderPtrs[i];
+	}
+
+	void Execute(int thread, int first, int last)
+	{
+		ArenaGenerator generator;
+		ArenaGrid arena;
+		CautiousBot firstBot, secondBot;
+		Match match;
+		match.SetListener(m_recorderPtrs[thread]);
+		for (int i = first; i < last; ++i)
+		{
+			generator.Generate(arena, ArenaGenerator::OBSTACLES, 32, 32, 0.15, i);
+			match.Start(arena, &firstBot, &secondBot, generator.FindFreeCell(), generator.FindFreeCell(), i, i);
+			match.Play(100000);
+			m_ticks[thread] += match.GetTickCount();
+		}
+	}
+
+	void Flush()
+	{
+		for (size_t i = 0; i < m_recorderPtrs.size(); ++i) m_recorderPtrs[i]->Flush();
+	}
+
+	LONGLONG GetRecordedSampleCount() const
+	{
+		LONGLONG samples = 0;
+		for (size_t i = 0; i < m_recorderPtrs.size(); ++i) samples += m_recorderPtrs[i]->GetRecordedSampleCount();
+		return samples;
+	}
+
+private:
+	std::vector<SelfPlayRecorder*> m_recorderPtrs;
+	std::vector<int> m_ticks;
+
+	SelfPlayTask(const SelfPlayTask& sptRef);
+	SelfPlayTask& operator=(const SelfPlayTask& sptRef);
+};
+
+// the random policy of BitslicedPlayout one game at a time, its baseline: returns the winner, -1 for a draw
+static int PlayScalarPlayout(ArenaGrid& arenaRef, CELL* positionsPtr, int player, Random& randomRef, int maxMoves)
+{
+	arenaRef.SetRigid(positionsPtr[0].x, positionsPtr[0].y);
+	arenaRef.SetRigid(positionsPtr[1].x, positionsPtr[1].y);
+	for (int move = 0; move < maxMoves; ++move)
+	{
+		CELL& headRef = positionsPtr[player];
+		int start = (int) (randomRef.Next() & 3), direction = -1;
+		for (int turn = 0; turn < 4 && direction < 0; ++turn)
+		{
+			int next = (start + turn) & 3;
+			if (!arenaRef.IsRigid(headRef.x + DIRECTION_DX[next], headRef.y + DIRECTION_DY[next])) direction = next;
+		}
+		if (direction < 0) return 1 - player;
+		headRef.x += DIRECTION_DX[direction];
+		headRef.y += DIRECTION_DY[direction];
+		arenaRef.SetRigid(headRef.x, headRef.y);
+		player = 1 - player;
+	}
+	return -1;
+}
+
+//-----------------------------------------------------------------
+// Benchmark methods
+//-----------------------------------------------------------------
+Benchmark::Benchmark()
+{
+	// nothing to create
+}
+
+Benchmark::~Benchmark()
+{
+	// nothing to destroy
+}
+
+void Benchmark::RunAll()
+{
+	OutputDebugString(String("---- AIchallenge benchmark ----\n"));
+	RunSentinelMove();
+	RunGridLayouts();
+	RunChunkedSnapshots();
+	RunDistanceFields();
+	RunReplanning();
+	RunHierarchicalPaths();
+	RunCooperativePlanning();
+	RunFlowFields();
+	RunPathQueryBatch();
+	RunPathCache();
+	RunWeightedSearches();
+	RunReachability();
+	RunArenaImages();
+	RunArenaCorpus();
+	RunMatchStatistics();
+	RunMoveLatency();
+	RunRatings();
+	RunSelfPlay();
+	RunValueNetwork();
+	RunParameterTuner();
+	RunSymmetry();
+	RunParallelSearch();
+	RunMoveOrdering();
+	RunTickResolution();
+	RunPlayouts();
+	OutputDebugString(String("---- benchmark done ----\n"));
+}
+
+void Benchmark::RunSentinelMove()
+{
+	// random walk over a fixed obstacle field: only the neighbour reads and the branches around them are measured
+	const int size = 64;
+	const int moves = 20000000;
+
+	ArenaGrid grid(size, size);
+	grid.AddWallRing();
+	unsigned int seed = 1;
+	for (int y = 1; y < size - 1; ++y)
+	{
+		for (int x = 1; x < size - 1; ++x)
+		{
+			if (NextRandom(seed) % 5 == 0) grid.SetRigid(x, y);
+		}
+	}
+	grid.SetFree(size / 2, size / 2);
+
+	// the old layout: one bool array per column, bounds checked before every read like MoveAIplayer used to do
+	bool** isRigidCell = new bool*[size];
+	for (int x = 0; x < size; ++x)
+	{
+		isRigidCell[x] = new bool[size];
+		for (int y = 0; y < size; ++y) isRigidCell[x][y] = grid.IsRigid(x, y);
+	}
+
+	seed = 7;
+	int x = size / 2, y = size / 2;
+	Stopwatch stopwatch;
+	for (int i = 0; i < moves; ++i)
+	{
+		switch (NextRandom(seed) % 4)
+		{
+		case 0:
+			if (x <= 0) break;
+			if (isRigidCell[x - 1][y]) break;
+			x--;
+			break;
+		case 1:
+			if (y <= 0) break;
+			if (isRigidCell[x][y - 1]) break;
+			y--;
+			break;
+		case 2:
+			if (x >= size - 1) break;
+			if (isRigidCell[x + 1][y]) break;
+			x++;
+			break;
+		case 3:
+			if (y >= size - 1) break;
+			if (isRigidCell[x][y + 1]) break;
+			y++;
+			break;
+		}
+	}
+	Report(String("move loop, bounds checked bool**"), stopwatch.GetElapsedMilliseconds(), moves, x * size + y);
+
+	for (int column = 0; column < size; ++column)
+	{
+		delete [] isRigidCell[column];
+	}
+	delete [] isRigidCell;
+
+	// the sentinel ring makes every neighbour readable, so the step is computed without a single branch
+	seed = 7;
+	x = size / 2;
+	y = size / 2;
+	stopwatch.Restart();
+	for (int i = 0; i < moves; ++i)
+	{
+		int direction = NextRandom(seed) % 4;
+		int step = 1 - grid.GetCell(x + DIRECTION_DX[direction], y + DIRECTION_DY[direction]);
+		x += DIRECTION_DX[direction] * step;
+		y += DIRECTION_DY[direction] * step;
+	}
+	Report(String("move loop, sentinel ArenaGrid"), stopwatch.GetElapsedMilliseconds(), moves, x * size + y);
+}
+
+void Benchmark::RunGridLayouts()
+{
+	// the same random obstacle arena in both layouts, at edge sizes where row-major storage stops fitting in cache
+	for (int size = 1024; size <= 4096; size *= 2)
+	{
+		ArenaGrid rowMajorGrid(size, size);
+		rowMajorGrid.AddWallRing();
+		unsigned int seed = size;
+		for (int y = 1; y < size - 1; ++y)
+		{
+			for (int x = 1; x < size - 1; ++x)
+			{
+				if (NextRandom(seed) % 5 == 0) rowMajorGrid.SetRigid(x, y);
+			}
+		}
+		rowMajorGrid.SetFree(size / 2, size / 2);
+		for (int i = 1; i < 3; ++i)
+		{
+			// keep the corners of the A* query open
+			rowMajorGrid.SetFree(i, 1);
+			rowMajorGrid.SetFree(1, i);
+			rowMajorGrid.SetFree(size - 1 - i, size - 2);
+			rowMajorGrid.SetFree(size - 2, size - 1 - i);
+		}
+
+		RunSearches(rowMajorGrid, String("row-major ") + size);
+
+		TiledArenaGrid tiledGrid;
+		tiledGrid.Assign(rowMajorGrid);
+		RunSearches(tiledGrid, String("8x8 tiled ") + size);
+	}
+}
+
+void Benchmark::RunChunkedSnapshots()
+{
+	// a search line of snapshots: every node copies its parent and makes one cell rigid
+	const int size = 4096;
+	const int fullCopies = 20;
+	const int snapshots = 10000;
+
+	ArenaGrid arena(size, size);
+	arena.AddWallRing();
+
+	unsigned int seed = 3;
+	Stopwatch stopwatch;
+	std::vector<ArenaGrid> fullStates(1, arena);
+	for (int i = 1; i < fullCopies; ++i)
+	{
+		fullStates.push_back(fullStates.back());
+		fullStates.back().SetRigid(1 + NextRandom(seed) % (size - 2), 1 + NextRandom(seed) % (size - 2));
+	}
+	Report(String("full ArenaGrid copy, 4096"), stopwatch.GetElapsedMilliseconds(), fullCopies - 1, (int) fullStates.size());
+	fullStates.clear();
+
+	ChunkedArenaGrid root;
+	root.Assign(arena);
+
+	seed = 3;
+	stopwatch.Restart();
+	std::vector<ChunkedArenaGrid> states(1, root);
+	states.reserve(snapshots);
+	for (int i = 1; i < snapshots; ++i)
+	{
+		states.push_back(states.back());
+		states.back().SetRigid(1 + NextRandom(seed) % (size - 2), 1 + NextRandom(seed) % (size - 2));
+	}
+	double milliseconds = stopwatch.GetElapsedMilliseconds();
+
+	Report(String("copy-on-write chunked copy, 4096"), milliseconds, snapshots - 1, (int) states.size());
+
+	// right after its write a node owns only what it copied: one 512 byte chunk (the pointer rows aside)
+	int privateChunks = 0;
+	for (int i = 1; i < 100; ++i)
+	{
+		ChunkedArenaGrid child = states[i - 1];
+		child.SetRigid(1 + NextRandom(seed) % (size - 2), 1 + NextRandom(seed) % (size - 2));
+		privateChunks += child.CountPrivateChunks();
+	}
+	OutputDebugString(String("private chunks per snapshot: ") + privateChunks / 99.0 + String(" of ") + root.GetChunkCount() + String("\n"));
+}
+
+void Benchmark::RunDistanceFields()
+{
+	// two walkers leave trails like players do; one walker is the source of the distance field
+	const int size = 512;
+	const int ticks = 400;
+
+	for (int ownMoves = 0; ownMoves <= 1; ++ownMoves)
+	{
+		ArenaGrid grid(size, size);
+		grid.AddWallRing();
+		unsigned int seed = 11;
+		for (int i = 0; i < size * size / 10; ++i)
+		{
+			grid.SetRigid(1 + NextRandom(seed) % (size - 2), 1 + NextRandom(seed) % (size - 2));
+		}
+		// the heads are rigid, as in the game
+		CELL walkers[2] = { { size / 2, size / 2 }, { size / 4, size / 4 } };
+		grid.SetRigid(walkers[0].x, walkers[0].y);
+		grid.SetRigid(walkers[1].x, walkers[1].y);
+		ArenaGrid startGrid = grid;
+
+		String scenario = ownMoves ? String("source and opponent move") : String("opponent moves");
+		int fullChecksum = 0, incrementalChecksum = 0;
+		for (int incremental = 0; incremental <= 1; ++incremental)
+		{
+			grid = startGrid;
+			CELL positions[2] = { walkers[0], walkers[1] };
+			DistanceField<ArenaGrid> field;
+			PathFinder<ArenaGrid> pathFinder;
+			field.Initialize(grid, positions[0].x, positions[0].y);
+			field.Update();
+
+			seed = 5;
+			int checksum = 0;
+			Stopwatch stopwatch;
+			for (int tick = 0; tick < ticks; ++tick)
+			{
+				// every walker steps to a free neighbour each tick; a boxed in walker starts again elsewhere
+				for (int walker = 1 - ownMoves; walker < 2; ++walker)
+				{
+					int start = NextRandom(seed) % 4, x = 0, y = 0;
+					bool isMoved = false;
+					for (int turn = 0; turn < 4 && !isMoved; ++turn)
+					{
+						int direction = (start + turn) % 4;
+						x = positions[walker].x + DIRECTION_DX[direction];
+						y = positions[walker].y + DIRECTION_DY[direction];
+						isMoved = !grid.IsRigid(x, y);
+					}
+					while (grid.IsRigid(x, y))
+					{
+						x = 1 + NextRandom(seed) % (size - 2);
+						y = 1 + NextRandom(seed) % (size - 2);
+					}
+					positions[walker].x = x;
+					positions[walker].y = y;
+					if (incremental && walker == 0) field.SetSource(x, y);
+					grid.SetRigid(x, y);
+					if (incremental) field.CellBecameRigid(x, y);
+				}
+				if (incremental)
+				{
+					checksum += field.GetDistance(size / 3, size / 3) & 0xffff;
+				}
+				else
+				{
+					pathFinder.BreadthFirst(grid, positions[0].x, positions[0].y);
+					int distance = pathFinder.GetDistance(size / 3, size / 3);
+					checksum += (distance < 0 ? DistanceField<ArenaGrid>::UNREACHABLE : distance) & 0xffff;
+				}
+			}
+			if (incremental) incrementalChecksum = checksum;
+			else fullChecksum = checksum;
+			Report(scenario + (incremental ? String(", incremental distance field") : String(", full BFS per tick")), stopwatch.GetElapsedMilliseconds(), ticks, checksum);
+		}
+		if (fullChecksum != incrementalChecksum) OutputDebugString(String("distance field MISMATCH\n"));
+	}
+}
+
+void Benchmark::RunReplanning()
+{
+	// an agent follows its path to the far corner while its trail and a random opponent trail appear
+	const int size = 512;
+	const int ticks = 400;
+
+	ArenaGrid startGrid(size, size);
+	startGrid.AddWallRing();
+	unsigned int seed = 13;
+	for (int i = 0; i < size * size / 10; ++i)
+	{
+		startGrid.SetRigid(1 + NextRandom(seed) % (size - 2), 1 + NextRandom(seed) % (size - 2));
+	}
+	// the heads are rigid, as in the game
+	CELL goal = { size - 2, size - 2 };
+	CELL startAgent = { 1, 1 }, startOpponent = { size / 2, size / 2 };
+	startGrid.SetFree(goal.x, goal.y);
+	startGrid.SetRigid(startAgent.x, startAgent.y);
+	startGrid.SetRigid(startOpponent.x, startOpponent.y);
+
+	for (int incremental = 0; incremental <= 1; ++incremental)
+	{
+		ArenaGrid grid = startGrid;
+		CELL agent = startAgent, opponent = startOpponent;
+		DStarLitePlanner<ArenaGrid> planner;
+		PathFinder<ArenaGrid> pathFinder;
+		std::vector<CELL> path;
+		planner.Initialize(grid, agent.x, agent.y, goal.x, goal.y);
+		planner.Replan();
+
+		seed = 17;
+		int checksum = 0;
+		Stopwatch stopwatch;
+		for (int tick = 0; tick < ticks; ++tick)
+		{
+			// plan from the current position, then take the first step
+			int direction = -1;
+			if (incremental)
+			{
+				checksum += planner.Replan() & 0xffff;
+				direction = planner.GetNextDirection();
+			}
+			else
+			{
+				int length = pathFinder.AStar(grid, agent.x, agent.y, goal.x, goal.y, &path);
+				checksum += (length < 0 ? DStarLitePlanner<ArenaGrid>::UNREACHABLE : length) & 0xffff;
+				for (int d = 0; d < 4 && path.size() > 1; ++d)
+				{
+					if (agent.x + DIRECTION_DX[d] == path[1].x && agent.y + DIRECTION_DY[d] == path[1].y) direction = d;
+				}
+			}
+			if (direction < 0) break;
+
+			// the heads move on and their new cells turn rigid, the old ones already are
+			agent.x += DIRECTION_DX[direction];
+			agent.y += DIRECTION_DY[direction];
+			if (agent.x == goal.x && agent.y == goal.y) break;
+			grid.SetRigid(agent.x, agent.y);
+			if (incremental)
+			{
+				planner.UpdateStart(agent.x, agent.y);
+				planner.CellBecameRigid(agent.x, agent.y);
+			}
+
+			int opponentDirection = NextRandom(seed) % 4;
+			int x = opponent.x + DIRECTION_DX[opponentDirection], y = opponent.y + DIRECTION_DY[opponentDirection];
+			if (!grid.IsRigid(x, y) && !(x == goal.x && y == goal.y))
+			{
+				opponent.x = x;
+				opponent.y = y;
+				grid.SetRigid(x, y);
+				if (incremental) planner.CellBecameRigid(x, y);
+			}
+		}
+		Report(incremental ? String("D* Lite replan per tick") : String("fresh A* per tick"), stopwatch.GetElapsedMilliseconds(), ticks, checksum);
+	}
+}
+
+void Benchmark::RunHierarchicalPaths()
+{
+	// long queries from the top left to the bottom right quarter of a large arena with scattered rigid cells
+	const int size = 2048;
+	const int astarQueries = 10;
+	const int queries = 1000;
+
+	ArenaGrid grid(size, size);
+	grid.AddWallRing();
+	unsigned int seed = 19;
+	for (int i = 0; i < size * size / 30; ++i)
+	{
+		grid.SetRigid(1 + NextRandom(seed) % (size - 2), 1 + NextRandom(seed) % (size - 2));
+	}
+
+	Stopwatch stopwatch;
+	HierarchicalPathFinder<ArenaGrid> hierarchicalPathFinder;
+	hierarchicalPathFinder.Initialize(grid, 32);
+	Report(String("HPA* build, 2048, clusters of 32"), stopwatch.GetElapsedMilliseconds(), 1, hierarchicalPathFinder.GetAbstractNodeCount());
+
+	std::vector<CELL> starts, goals;
+	for (int i = 0; i < queries; ++i)
+	{
+		CELL start = { 1 + NextRandom(seed) % (size / 4), 1 + NextRandom(seed) % (size / 4) };
+		CELL goal = { size - 2 - NextRandom(seed) % (size / 4), size - 2 - NextRandom(seed) % (size / 4) };
+		grid.SetFree(start.x, start.y);
+		grid.SetFree(goal.x, goal.y);
+		starts.push_back(start);
+		goals.push_back(goal);
+	}
+	hierarchicalPathFinder.Initialize(grid, 32);
+
+	PathFinder<ArenaGrid> pathFinder;
+	int checksum = 0;
+	stopwatch.Restart();
+	for (int i = 0; i < astarQueries; ++i)
+	{
+		checksum += pathFinder.AStar(grid, starts[i].x, starts[i].y, goals[i].x, goals[i].y);
+	}
+	Report(String("A* long query, 2048"), stopwatch.GetElapsedMilliseconds(), astarQueries, checksum);
+
+	checksum = 0;
+	std::vector<CELL> waypoints;
+	stopwatch.Restart();
+	for (int i = 0; i < astarQueries; ++i)
+	{
+		checksum += hierarchicalPathFinder.FindPath(starts[i].x, starts[i].y, goals[i].x, goals[i].y, &waypoints);
+	}
+	Report(String("HPA* same queries, abstract path"), stopwatch.GetElapsedMilliseconds(), astarQueries, checksum);
+
+	stopwatch.Restart();
+	for (int i = 0; i < queries; ++i)
+	{
+		checksum += hierarchicalPathFinder.FindPath(starts[i].x, starts[i].y, goals[i].x, goals[i].y, &waypoints);
+	}
+	Report(String("HPA* long query, abstract path"), stopwatch.GetElapsedMilliseconds(), queries, checksum);
+
+	// refining only the first piece, as a path follower would each tick
+	std::vector<CELL> cells;
+	stopwatch.Restart();
+	for (int i = 0; i < queries; ++i)
+	{
+		hierarchicalPathFinder.FindPath(starts[i].x, starts[i].y, goals[i].x, goals[i].y, &waypoints);
+		if (waypoints.size() > 1) hierarchicalPathFinder.RefineSegment(waypoints[0], waypoints[1], &cells);
+		checksum += (int) cells.size();
+	}
+	Report(String("HPA* long query, first piece refined"), stopwatch.GetElapsedMilliseconds(), queries, checksum);
+
+	// in the game a query starts on the player's head, which is rigid
+	for (int i = 0; i < astarQueries; ++i)
+	{
+		grid.SetRigid(starts[i].x, starts[i].y);
+		hierarchicalPathFinder.CellBecameRigid(starts[i].x, starts[i].y);
+	}
+	checksum = 0;
+	stopwatch.Restart();
+	for (int i = 0; i < astarQueries; ++i)
+	{
+		checksum += pathFinder.AStar(grid, starts[i].x, starts[i].y, goals[i].x, goals[i].y);
+	}
+	Report(String("A* long query from a rigid head"), stopwatch.GetElapsedMilliseconds(), astarQueries, checksum);
+
+	checksum = 0;
+	stopwatch.Restart();
+	for (int i = 0; i < astarQueries; ++i)
+	{
+		checksum += hierarchicalPathFinder.FindPath(starts[i].x, starts[i].y, goals[i].x, goals[i].y, &waypoints);
+		if (waypoints.size() > 1) hierarchicalPathFinder.RefineSegment(waypoints[0], waypoints[1], &cells);
+	}
+	Report(String("HPA* long query from a rigid head, first piece refined"), stopwatch.GetElapsedMilliseconds(), astarQueries, checksum);
+
+	// a trail of new rigid cells only dirties the clusters it crosses
+	stopwatch.Restart();
+	for (int i = 0; i < queries; ++i)
+	{
+		int x = 1 + NextRandom(seed) % (size - 2), y = 1 + NextRandom(seed) % (size - 2);
+		grid.SetRigid(x, y);
+		hierarchicalPathFinder.CellBecameRigid(x, y);
+		hierarchicalPathFinder.Refresh();
+	}
+	Report(String("HPA* refresh after a rigid cell"), stopwatch.GetElapsedMilliseconds(), queries, 0);
+}
+
+void Benchmark::RunCooperativePlanning()
+{
+	// a few hundred agents, each heading for a goal nearby, on a 512 arena with scattered rigid cells
+	const int size = 512;
+	const int agents = 256;
+	const int window = 16;
+	const int rounds = 20;
+
+	ArenaGrid grid(size, size);
+	grid.AddWallRing();
+	unsigned int seed = 23;
+	for (int i = 0; i < size * size / 10; ++i)
+	{
+		grid.SetRigid(1 + NextRandom(seed) % (size - 2), 1 + NextRandom(seed) % (size - 2));
+	}
+
+	ArenaGrid occupied(size, size);
+	std::vector<CELL> starts, goals;
+	while ((int) starts.size() < agents)
+	{
+		CELL start = { 1 + NextRandom(seed) % (size - 2), 1 + NextRandom(seed) % (size - 2) };
+		CELL goal = { std::min(size - 2, start.x + NextRandom(seed) % 32), std::min(size - 2, start.y + NextRandom(seed) % 32) };
+		if (grid.IsRigid(start.x, start.y) || occupied.IsRigid(start.x, start.y) || grid.IsRigid(goal.x, goal.y)) continue;
+		occupied.SetRigid(start.x, start.y);
+		starts.push_back(start);
+		goals.push_back(goal);
+	}
+
+	// independent A* paths, cut to the window, as the reference for the number of collisions
+	PathFinder<ArenaGrid> pathFinder;
+	std::vector<std::vector<CELL> > independentPaths(agents);
+	Stopwatch stopwatch;
+	for (int agent = 0; agent < agents; ++agent)
+	{
+		std::vector<CELL>& pathRef = independentPaths[agent];
+		if (pathFinder.AStar(grid, starts[agent].x, starts[agent].y, goals[agent].x, goals[agent].y, &pathRef) < 0) pathRef.assign(1, starts[agent]);
+		if ((int) pathRef.size() > window + 1) pathRef.resize(window + 1);
+	}
+	double independentMilliseconds = stopwatch.GetElapsedMilliseconds();
+
+	CooperativePlanner<ArenaGrid> planner;
+	std::vector<std::vector<CELL> > paths;
+	for (int trailMode = 1; trailMode >= 0; --trailMode)
+	{
+		planner.Initialize(grid, window, trailMode != 0);
+		String mode = trailMode ? String("trails") : String("waiting allowed");
+		Report(String("independent A*, 256 agents, conflicts with ") + mode, independentMilliseconds, agents, planner.CountConflicts(independentPaths));
+
+		stopwatch.Restart();
+		for (int round = 0; round < rounds; ++round)
+		{
+			planner.PlanAll(starts, goals, &paths);
+		}
+		Report(String("WHCA* 256 agents, window 16, conflicts with ") + mode, stopwatch.GetElapsedMilliseconds() / rounds, agents, planner.CountConflicts(paths));
+	}
+}
+
+void Benchmark::RunFlowFields()
+{
+	// a crowd of agents spread over a 1024 arena, heading for four shared goals
+	const int size = 1024;
+	const int agents = 256;
+	const int goals = 4;
+	const int ticks = 100;
+
+	ArenaGrid grid(size, size);
+	grid.AddWallRing();
+	unsigned int seed = 29;
+	for (int i = 0; i < size * size / 10; ++i)
+	{
+		grid.SetRigid(1 + NextRandom(seed) % (size - 2), 1 + NextRandom(seed) % (size - 2));
+	}
+	std::vector<CELL> positions, goalCells;
+	while ((int) goalCells.size() < goals)
+	{
+		CELL goal = { 1 + NextRandom(seed) % (size - 2), 1 + NextRandom(seed) % (size - 2) };
+		if (!grid.IsRigid(goal.x, goal.y)) goalCells.push_back(goal);
+	}
+	while ((int) positions.size() < agents)
+	{
+		CELL position = { 1 + NextRandom(seed) % (size - 2), 1 + NextRandom(seed) % (size - 2) };
+		if (!grid.IsRigid(position.x, position.y)) positions.push_back(position);
+	}
+
+	// the next step of every agent with one A* per agent
+	PathFinder<ArenaGrid> pathFinder;
+	std::vector<CELL> path;
+	int checksum = 0;
+	Stopwatch stopwatch;
+	for (int agent = 0; agent < agents; ++agent)
+	{
+		const CELL& goalRef = goalCells[agent % goals];
+		checksum += pathFinder.AStar(grid, positions[agent].x, positions[agent].y, goalRef.x, goalRef.y, &path);
+	}
+	Report(String("A* per agent, 256 agents, 1024"), stopwatch.GetElapsedMilliseconds(), agents, checksum);
+
+	FlowFieldCache<ArenaGrid> cache;
+	cache.Initialize(grid, goals);
+	checksum = 0;
+	stopwatch.Restart();
+	for (int goal = 0; goal < goals; ++goal)
+	{
+		checksum += cache.GetField(goalCells[goal].x, goalCells[goal].y).GetRepairedCellCount();
+	}
+	Report(String("flow field build, 1024"), stopwatch.GetElapsedMilliseconds(), goals, checksum);
+
+	checksum = 0;
+	stopwatch.Restart();
+	for (int agent = 0; agent < agents; ++agent)
+	{
+		const CELL& goalRef = goalCells[agent % goals];
+		checksum += cache.GetField(goalRef.x, goalRef.y).GetDistance(positions[agent].x, positions[agent].y);
+	}
+	Report(String("flow field lookup, 256 agents (same lengths as A*)"), stopwatch.GetElapsedMilliseconds(), agents, checksum);
+
+	// every tick all agents step along their field and a few cells elsewhere become rigid
+	checksum = 0;
+	stopwatch.Restart();
+	for (int tick = 0; tick < ticks; ++tick)
+	{
+		for (int i = 0; i < 8; ++i)
+		{
+			int x = 1 + NextRandom(seed) % (size - 2), y = 1 + NextRandom(seed) % (size - 2);
+			if (grid.IsRigid(x, y)) continue;
+			grid.SetRigid(x, y);
+			cache.CellBecameRigid(x, y);
+		}
+		for (int agent = 0; agent < agents; ++agent)
+		{
+			const CELL& goalRef = goalCells[agent % goals];
+			FlowField<ArenaGrid>& fieldRef = cache.GetField(goalRef.x, goalRef.y);
+			int direction = fieldRef.GetDirection(positions[agent].x, positions[agent].y);
+			if (direction == FlowField<ArenaGrid>::NO_DIRECTION) continue;
+			positions[agent].x += DIRECTION_DX[direction];
+			positions[agent].y += DIRECTION_DY[direction];
+			checksum += direction;
+		}
+	}
+	Report(String("flow field tick, 256 agents, 8 new rigid cells"), stopwatch.GetElapsedMilliseconds(), ticks, checksum);
+
+	// a full rebuild of the fields after the same changes, for comparison
+	stopwatch.Restart();
+	for (int goal = 0; goal < goals; ++goal)
+	{
+		FlowField<ArenaGrid> field;
+		field.Build(grid, goalCells[goal].x, goalCells[goal].y);
+	}
+	Report(String("flow field rebuild of all goals, 1024"), stopwatch.GetElapsedMilliseconds(), 1, cache.GetBuiltFieldCount());
+}
+
+void Benchmark::RunPathQueryBatch()
+{
+	// thousands of short and medium queries on a 512 arena, as a frame full of agents would ask
+	const int size = 512;
+	const int queries = 4096;
+
+	ArenaGrid grid(size, size);
+	grid.AddWallRing();
+	unsigned int seed = 31;
+	for (int i = 0; i < size * size / 10; ++i)
+	{
+		grid.SetRigid(1 + NextRandom(seed) % (size - 2), 1 + NextRandom(seed) % (size - 2));
+	}
+	std::vector<CELL> starts, goals;
+	for (int i = 0; i < queries; ++i)
+	{
+		CELL start = { 1 + NextRandom(seed) % (size - 2), 1 + NextRandom(seed) % (size - 2) };
+		CELL goal = { std::min(size - 2, start.x + NextRandom(seed) % 128), std::min(size - 2, start.y + NextRandom(seed) % 128) };
+		grid.SetFree(start.x, start.y);
+		grid.SetFree(goal.x, goal.y);
+		starts.push_back(start);
+		goals.push_back(goal);
+	}
+
+	PathFinder<ArenaGrid> pathFinder;
+	std::vector<CELL> path;
+	int checksum = 0;
+	Stopwatch stopwatch;
+	for (int i = 0; i < queries; ++i)
+	{
+		checksum += pathFinder.AStar(grid, starts[i].x, starts[i].y, goals[i].x, goals[i].y, &path);
+	}
+	Report(String("A* one by one, 4096 queries"), stopwatch.GetElapsedMilliseconds(), queries, checksum);
+
+	WorkerPool pool;
+	PathQueryBatch<ArenaGrid> batch(pool);
+	for (int i = 0; i < queries; ++i)
+	{
+		batch.Add(starts[i].x, starts[i].y, goals[i].x, goals[i].y);
+	}
+	for (int round = 0; round < 2; ++round)
+	{
+		// the first round also grows the scratch buffers of every thread
+		stopwatch.Restart();
+		batch.Run(grid);
+		double milliseconds = stopwatch.GetElapsedMilliseconds();
+		checksum = 0;
+		for (int i = 0; i < queries; ++i)
+		{
+			checksum += batch.GetLength(i);
+		}
+		String name = String("PathQueryBatch, 4096 queries, threads: ");
+		name += pool.GetThreadCount();
+		if (round == 0) name += String(", cold");
+		Report(name, milliseconds, queries, checksum);
+	}
+}
+
+void Benchmark::RunPathCache()
+{
+	// bots asking for the same few hundred start and goal pairs over and over, while trails keep growing
+	const int size = 512;
+	const int pairs = 512;
+	const int ticks = 200;
+	const int queriesPerTick = 64;
+
+	ArenaGrid grid(size, size);
+	grid.AddWallRing();
+	unsigned int seed = 37;
+	for (int i = 0; i < size * size / 10; ++i)
+	{
+		grid.SetRigid(1 + NextRandom(seed) % (size - 2), 1 + NextRandom(seed) % (size - 2));
+	}
+	std::vector<CELL> starts, goals;
+	for (int i = 0; i < pairs; ++i)
+	{
+		CELL start = { 1 + NextRandom(seed) % (size - 2), 1 + NextRandom(seed) % (size - 2) };
+		CELL goal = { std::min(size - 2, start.x + NextRandom(seed) % 128), std::min(size - 2, start.y + NextRandom(seed) % 128) };
+		grid.SetFree(start.x, start.y);
+		grid.SetFree(goal.x, goal.y);
+		starts.push_back(start);
+		goals.push_back(goal);
+	}
+	std::vector<int> pairOrder;
+	std::vector<CELL> newRigidCells;
+	for (int tick = 0; tick < ticks; ++tick)
+	{
+		for (int i = 0; i < queriesPerTick; ++i)
+		{
+			// most questions go to a small set of popular pairs
+			int pair = NextRandom(seed) % pairs;
+			if (NextRandom(seed) % 4 != 0) pair %= pairs / 8;
+			pairOrder.push_back(pair);
+		}
+		CELL cell = { 1 + NextRandom(seed) % (size - 2), 1 + NextRandom(seed) % (size - 2) };
+		newRigidCells.push_back(cell);
+	}
+
+	for (int useCache = 0; useCache < 2; ++useCache)
+	{
+		ArenaGrid arena;
+		arena.Assign(grid);
+		PathFinder<ArenaGrid> pathFinder;
+		PathCache<ArenaGrid> cache;
+		cache.Initialize(arena, 256);
+
+		int checksum = 0;
+		Stopwatch stopwatch;
+		for (int tick = 0; tick < ticks; ++tick)
+		{
+			for (int i = 0; i < queriesPerTick; ++i)
+			{
+				int pair = pairOrder[tick * queriesPerTick + i];
+				if (useCache) checksum += cache.FindPath(starts[pair].x, starts[pair].y, goals[pair].x, goals[pair].y);
+				else checksum += pathFinder.AStar(arena, starts[pair].x, starts[pair].y, goals[pair].x, goals[pair].y);
+			}
+			const CELL& cellRef = newRigidCells[tick];
+			if (arena.IsRigid(cellRef.x, cellRef.y)) continue;
+			arena.SetRigid(cellRef.x, cellRef.y);
+			cache.CellBecameRigid(cellRef.x, cellRef.y);
+		}
+		Report(useCache ? String("path cache, 256 paths") : String("A* without cache"), stopwatch.GetElapsedMilliseconds(), ticks * queriesPerTick, checksum);
+		if (useCache)
+		{
+			String line = String("path cache hit rate: ");
+			line += cache.GetHitRate() * 100.0;
+			line += String(" %, invalidations: ");
+			line += cache.GetInvalidations();
+			line += String(", evictions: ");
+			line += cache.GetEvictions();
+			line += String("\n");
+			OutputDebugString(line);
+		}
+	}
+}
+
+void Benchmark::RunWeightedSearches()
+{
+	// a 2048 arena with scattered rigid cells, danger around a few hundred heads and extra cost along the walls
+	const int size = 2048;
+	const int heads = 256;
+
+	ArenaGrid grid(size, size);
+	grid.AddWallRing();
+	unsigned int seed = 41;
+	for (int i = 0; i < size * size / 10; ++i)
+	{
+		grid.SetRigid(1 + NextRandom(seed) % (size - 2), 1 + NextRandom(seed) % (size - 2));
+	}
+	CostMap<ArenaGrid> costs;
+	costs.Initialize(grid);
+	for (int y = 0; y < size; ++y)
+	{
+		for (int x = 0; x < size; ++x)
+		{
+			costs.SetCost(x, y, NextRandom(seed) & 3);
+		}
+	}
+	costs.AddWallProximity(2);
+	for (int i = 0; i < heads; ++i)
+	{
+		costs.AddDanger(NextRandom(seed) % size, NextRandom(seed) % size, 12, 60);
+	}
+	int centre = size / 2;
+	grid.SetFree(centre, centre);
+
+	WeightedPathFinder<ArenaGrid> pathFinder;
+	for (int radix = 0; radix < 2; ++radix)
+	{
+		Stopwatch stopwatch;
+		int reached = radix ? pathFinder.Dijkstra(grid, costs, centre, centre) : pathFinder.DijkstraPriorityQueue(grid, costs, centre, centre);
+		double milliseconds = stopwatch.GetElapsedMilliseconds();
+
+		// the same distances come out of both searches
+		int checksum = reached;
+		for (int i = 1; i < size - 1; i += 7)
+		{
+			if (pathFinder.IsReached(i, i)) checksum += (int) pathFinder.GetDistance(i, i);
+		}
+		Report(radix ? String("Dijkstra with radix heap, 2048") : String("Dijkstra with std::priority_queue, 2048"), milliseconds, reached, checksum);
+	}
+}
+
+void Benchmark::RunReachability()
+{
+	// "can I still reach the opponent?" on a 2048 arena: half of the goals are open, half are walled in
+	const int size = 2048;
+	const int queries = 32;
+
+	ArenaGrid grid(size, size);
+	grid.AddWallRing();
+	unsigned int seed = 43;
+	for (int i = 0; i < size * size / 10; ++i)
+	{
+		grid.SetRigid(1 + NextRandom(seed) % (size - 2), 1 + NextRandom(seed) % (size - 2));
+	}
+	std::vector<CELL> starts, goals;
+	for (int i = 0; i < queries; ++i)
+	{
+		CELL start = { 8 + NextRandom(seed) % (size - 16), 8 + NextRandom(seed) % (size - 16) };
+		CELL goal = { 8 + NextRandom(seed) % (size - 16), 8 + NextRandom(seed) % (size - 16) };
+		grid.SetFree(start.x, start.y);
+		grid.SetFree(goal.x, goal.y);
+		if (i & 1)
+		{
+			// a small walled in room around the goal
+			for (int j = -3; j <= 3; ++j)
+			{
+				grid.SetRigid(goal.x + j, goal.y - 3);
+				grid.SetRigid(goal.x + j, goal.y + 3);
+				grid.SetRigid(goal.x - 3, goal.y + j);
+				grid.SetRigid(goal.x + 3, goal.y + j);
+			}
+		}
+		starts.push_back(start);
+		goals.push_back(goal);
+	}
+
+	PathFinder<ArenaGrid> pathFinder;
+	int checksum = 0;
+	Stopwatch stopwatch;
+	for (int i = 0; i < queries; ++i)
+	{
+		pathFinder.BreadthFirst(grid, starts[i].x, starts[i].y);
+		checksum += pathFinder.IsReached(goals[i].x, goals[i].y) ? pathFinder.GetDistance(goals[i].x, goals[i].y) : BitboardSearch::UNREACHABLE;
+	}
+	Report(String("BFS reachability, 2048"), stopwatch.GetElapsedMilliseconds(), queries, checksum);
+
+	BitboardSearch bitboardSearch;
+	bitboardSearch.Load(grid);
+	for (int isBidirectional = 0; isBidirectional < 2; ++isBidirectional)
+	{
+		checksum = 0;
+		stopwatch.Restart();
+		for (int i = 0; i < queries; ++i)
+		{
+			if (isBidirectional) checksum += bitboardSearch.GetDistance(starts[i].x, starts[i].y, goals[i].x, goals[i].y);
+			else checksum += bitboardSearch.GetDistanceOneSided(starts[i].x, starts[i].y, goals[i].x, goals[i].y);
+		}
+		Report(isBidirectional ? String("bitboard BFS from both ends, 2048") : String("bitboard BFS from the start, 2048"), stopwatch.GetElapsedMilliseconds(), queries, checksum);
+	}
+}
+
+void Benchmark::RunArenaImages()
+{
+	// a 2048 arena drawn as an image: black walls and grey rubble on white floor
+	const int size = 2048;
+	const int rounds = 8;
+
+	std::vector<unsigned char> pixels(size * size, 255);
+	unsigned int seed = 47;
+	for (int i = 0; i < 4000; ++i)
+	{
+		int left = NextRandom(seed) % size, top = NextRandom(seed) % size;
+		int right = std::min(left + 1 + NextRandom(seed) % 64, size), bottom = std::min(top + 1 + NextRandom(seed) % 64, size);
+		unsigned char shade = (unsigned char) (NextRandom(seed) % 256);
+		for (int y = top; y < bottom; ++y) std::fill(pixels.begin() + y * size + left, pixels.begin() + y * size + right, shade);
+	}
+
+	// one pixel at a time, as a loader written around SetRigid would do
+	ChunkedArenaGrid grid;
+	int checksum = 0;
+	Stopwatch stopwatch;
+	for (int round = 0; round < rounds; ++round)
+	{
+		grid.Create(size, size);
+		for (int y = 0; y < size; ++y)
+		{
+			for (int x = 0; x < size; ++x)
+			{
+				if (pixels[y * size + x] < ArenaImage::DEFAULT_THRESHOLD) grid.SetRigid(x, y);
+			}
+		}
+		checksum += grid.GetCell(size / 2, size / 2);
+	}
+	Report(String("pixels to grid, per pixel SetRigid"), stopwatch.GetElapsedMilliseconds(), rounds * size * size, checksum);
+
+	ArenaImage image;
+	checksum = 0;
+	stopwatch.Restart();
+	for (int round = 0; round < rounds; ++round)
+	{
+		image.Threshold(&pixels[0], size, size);
+		image.CopyTo(grid);
+		checksum += grid.GetCell(size / 2, size / 2);
+	}
+	Report(String("pixels to grid, packed threshold"), stopwatch.GetElapsedMilliseconds(), rounds * size * size, checksum);
+
+	// the whole file round trip, through TargaLoader
+	TCHAR filename[] = TEXT("temp\\arena.tga");
+	TCHAR* filenamePtr = filename;
+	CreateDirectory(TEXT("temp\\"), NULL);
+	for (int format = 0; format < 4; ++format)
+	{
+		bool isIndexed = (format & 1) != 0, isRLE = (format & 2) != 0;
+		if (!WriteTarga(filenamePtr, pixels, size, size, isIndexed, isRLE)) return;
+		checksum = 0;
+		stopwatch.Restart();
+		for (int round = 0; round < rounds; ++round)
+		{
+			if (image.Load(filenamePtr)) checksum += image.CountRigidCells();
+		}
+		String name("load ");
+		name += isRLE ? "RLE " : "raw ";
+		name += isIndexed ? "indexed" : "greyscale";
+		name += " TGA, 2048";
+		Report(name, stopwatch.GetElapsedMilliseconds(), rounds, checksum);
+	}
+	DeleteFile(filenamePtr);
+}
+
+void Benchmark::RunArenaCorpus()
+{
+	// every generated kind at 1024, timed to build and then flooded from a random free cell
+	const int size = 1024;
+	const double densities[ArenaGenerator::KIND_COUNT] = { 0.9, 0.6, 0.45, 0.2 };
+
+	ArenaGenerator generator;
+	ArenaGrid grid, regenerated;
+	PathFinder<ArenaGrid> pathFinder;
+	for (int kind = 0; kind < ArenaGenerator::KIND_COUNT; ++kind)
+	{
+		ArenaGenerator::Kind arenaKind = (ArenaGenerator::Kind) kind;
+		Stopwatch stopwatch;
+		generator.Generate(grid, arenaKind, size, size, densities[kind], 2010);
+		String name("generate ");
+		name += ArenaGenerator::GetKindName(arenaKind);
+		name += ", 1024";
+		Report(name, stopwatch.GetElapsedMilliseconds(), size * size, generator.CountFreeCells());
+
+		CELL start = generator.FindFreeCell();
+		stopwatch.Restart();
+		int reached = pathFinder.BreadthFirst(grid, start.x, start.y);
+		name = String("BFS in ");
+		name += ArenaGenerator::GetKindName(arenaKind);
+		name += ", 1024";
+		Report(name, stopwatch.GetElapsedMilliseconds(), reached, reached);
+
+		// the same seed has to give the same arena
+		generator.Generate(regenerated, arenaKind, size, size, densities[kind], 2010);
+		for (int y = 0; y < size; ++y)
+		{
+			for (int x = 0; x < size; ++x)
+			{
+				if (grid.IsRigid(x, y) != regenerated.IsRigid(x, y))
+				{
+					OutputDebugString(String("regenerated arena differs\n"));
+					return;
+				}
+			}
+		}
+	}
+}
+
+void Benchmark::RunMatchStatistics()
+{
+	// headless berserker against filler matches on a 64 arena, with and without every move recorded
+	const int size = 64;
+	const int matches = 4000;
+
+	ArenaGenerator generator;
+	ArenaGrid arena;
+	generator.Generate(arena, ArenaGenerator::OBSTACLES, size, size, 0.1, 40);
+	CELL starts[2] = { generator.FindFreeCell(), generator.FindFreeCell() };
+
+	RandomBot randomBot;
+	FillBot fillBot;
+	Match match;
+	MatchStatistics statistics;
+	CreateDirectory(TEXT("temp\\"), NULL);
+	TCHAR binaryFilename[] = TEXT("temp\\statistics.bin");
+	TCHAR textFilename[] = TEXT("temp\\statistics.csv");
+
+	// nothing recorded; recorded into the buffer only, no file open; binary; CSV; binary plus the reachable area every 16 ticks
+	static const char* namesPtr[5] = { "match ticks, no statistics", "match ticks, recorded, no file", "match ticks, binary statistics", "match ticks, CSV statistics", "match ticks, binary + area/16" };
+	for (int variant = 0; variant < 5; ++variant)
+	{
+		if (variant == 2 || variant == 4) statistics.Open(binaryFilename);
+		if (variant == 3) statistics.Open(textFilename, true);
+		match.SetStatistics(variant == 0 ? NULL : statistics.GetThreadBuffer(), variant == 4 ? 16 : 0);
+
+		int ticks = 0;
+		Stopwatch stopwatch;
+		for (int i = 0; i < matches; ++i)
+		{
+			match.Start(arena, &randomBot, &fillBot, starts[0], starts[1], i, i);
+			match.Play(100000);
+			ticks += match.GetTickCount();
+		}
+		statistics.Close();
+		Report(String(namesPtr[variant]), stopwatch.GetElapsedMilliseconds(), ticks, variant < 2 ? ticks : (int) statistics.GetWrittenTickCount());
+	}
+
+	// every thread records into its own buffer, one writer thread for all
+	WorkerPool pool;
+	for (int isRecording = 0; isRecording < 2; ++isRecording)
+	{
+		if (isRecording) statistics.Open(binaryFilename);
+		MatchBatchTask task(arena, starts[0], starts[1], isRecording ? &statistics : NULL, pool.GetThreadCount());
+		Stopwatch stopwatch;
+		pool.Run(task, matches * 4, 64);
+		statistics.Close();
+
+		String name("match ticks on ");
+		name += pool.GetThreadCount();
+		name += isRecording ? " threads, binary statistics" : " threads, no statistics";
+		Report(name, stopwatch.GetElapsedMilliseconds(), task.GetTickCount(), isRecording ? (int) statistics.GetWrittenTickCount() : task.GetTickCount());
+	}
+	DeleteFile(binaryFilename);
+	DeleteFile(textFilename);
+}
+
+void Benchmark::RunMoveLatency()
+{
+	// the cost of recording one decision time, spread over the whole range the histogram covers
+	const int records = 10000000;
+	LatencyHistogram histogram;
+	unsigned int seed = 41;
+	Stopwatch stopwatch;
+	for (int i = 0; i < records; ++i)
+	{
+		int random = NextRandom(seed);
+		histogram.Record((LONGLONG) (random & 0x7ff) << (random >> 11));
+	}
+	Report(String("latency histogram record"), stopwatch.GetElapsedMilliseconds(), records, (int) (histogram.GetPercentile(0.99) >> 10));
+
+	// berserker against a filler that is over its 20 us budget on every 50th move, under every budget policy
+	const int size = 64;
+	const int matches = 400;
+	ArenaGenerator generator;
+	ArenaGrid arena;
+	generator.Generate(arena, ArenaGenerator::OBSTACLES, size, size, 0.1, 41);
+	CELL starts[2] = { generator.FindFreeCell(), generator.FindFreeCell() };
+
+	RandomBot randomBot;
+	SlowBot slowBot(50, 50);
+	LatencyHistogram latencies[2];
+	Match match;
+	match.SetLatencyHistogram(0, &latencies[0]);
+	match.SetLatencyHistogram(1, &latencies[1]);
+
+	static const char* namesPtr[3] = { "warn", "default move", "forfeit" };
+	for (int policy = BUDGET_WARN; policy <= BUDGET_FORFEIT; ++policy)
+	{
+		latencies[0].Clear();
+		latencies[1].Clear();
+		match.SetBudget(20000, (BUDGET_POLICY) policy);
+		int ticks = 0, overruns = 0, forfeits = 0;
+		stopwatch.Restart();
+		for (int i = 0; i < matches; ++i)
+		{
+			match.Start(arena, &randomBot, &slowBot, starts[0], starts[1], i, i);
+			match.Play(100000);
+			ticks += match.GetTickCount();
+			overruns += match.GetOverrunCount(1);
+			if (match.GetLossCause(1) == LOSS_FORFEIT) ++forfeits;
+		}
+		Report(String("match ticks, budget policy ") + namesPtr[policy], stopwatch.GetElapsedMilliseconds(), ticks, overruns * 1000 + forfeits);
+
+		for (int player = 0; player < 2; ++player)
+		{
+			String line(player == 0 ? "  berserker" : "  slow filler");
+			line += String(" decisions: p50 ");
+			line += latencies[player].GetPercentile(0.5) / 1000.0;
+			line += String(" us, p99 ");
+			line += latencies[player].GetPercentile(0.99) / 1000.0;
+			line += String(" us, max ");
+			line += latencies[player].GetMax() / 1000.0;
+			line += String(" us\n");
+			OutputDebugString(line);
+		}
+	}
+}
+
+void Benchmark::RunRatings()
+{
+	// the queue and the Elo/Glicko-2 updates alone: a million results for 64 players from every thread
+	const int results = 1000000;
+	const int playerCount = 64;
+	WorkerPool pool;
+	{
+		RatingAggregator ratings(1000);
+		for (int player = 0; player < playerCount; ++player) ratings.AddPlayer("player");
+		RatingSubmitTask task(ratings, playerCount);
+		Stopwatch stopwatch;
+		ratings.Start(100);
+		pool.Run(task, results, 1024);
+		ratings.Stop();
+		String name("rating updates from ");
+		name += pool.GetThreadCount();
+		name += String(" threads");
+		Report(name, stopwatch.GetElapsedMilliseconds(), results, (int) ratings.GetProcessedCount());
+	}
+
+	// a round robin tournament rated while it is played
+	const int size = 64;
+	const int matches = 30000;
+	ArenaGenerator generator;
+	ArenaGrid arena;
+	generator.Generate(arena, ArenaGenerator::OBSTACLES, size, size, 0.1, 42);
+	CELL starts[2] = { generator.FindFreeCell(), generator.FindFreeCell() };
+
+	RatingAggregator ratings(300);
+	RandomBot randomBot;
+	CautiousBot cautiousBot;
+	FillBot fillBot;
+	int ids[3] = { ratings.AddPlayer(randomBot.GetName()), ratings.AddPlayer(cautiousBot.GetName()), ratings.AddPlayer(fillBot.GetName()) };
+	SnapshotCounter counter;
+	ratings.SetListener(&counter);
+	RatingTournamentTask task(arena, starts[0], starts[1], ratings, ids);
+	Stopwatch stopwatch;
+	ratings.Start(100);
+	pool.Run(task, matches, 64);
+	ratings.Stop();
+	double milliseconds = stopwatch.GetElapsedMilliseconds();
+
+	std::vector<RATING> leaderboard;
+	ratings.GetLeaderboard(leaderboard);
+	String name("rated tournament matches, ");
+	name += counter.GetCount();
+	name += String(" snapshots");
+	Report(name, milliseconds, matches, leaderboard[0].wins);
+	for (size_t i = 0; i < leaderboard.size(); ++i)
+	{
+		const RATING& ratingRef = leaderboard[i];
+		String line("  ");
+		line += String(ratingRef.namePtr);
+		line += String(": Glicko-2 ");
+		line += ratingRef.rating;
+		line += String(" +- ");
+		line += ratingRef.deviation;
+		line += String(", Elo ");
+		line += ratingRef.elo;
+		line += String(", ");
+		line += ratingRef.wins;
+		line += String("/");
+		line += ratingRef.draws;
+		line += String("/");
+		line += ratingRef.losses;
+		line += String(" won/drawn/lost\n");
+		OutputDebugString(line);
+	}
+}
+
+void Benchmark::RunSelfPlay()
+{
+	// self-play on every thread into 4 MB shards, then every shard read back
+	const int matches = 20000;
+	CreateDirectory(TEXT("temp\\"), NULL);
+	TCHAR prefix[] = TEXT("temp\\selfplay");
+
+	WorkerPool pool;
+	SelfPlayWriter writer;
+	writer.Open(prefix, 4 << 20);
+	LONGLONG recordedSamples;
+	Stopwatch stopwatch;
+	{
+		SelfPlayTask task(writer, pool.GetThreadCount());
+		pool.Run(task, matches, 64);
+		task.Flush();
+		recordedSamples = task.GetRecordedSampleCount();
+	}
+	writer.Close();
+	double milliseconds = stopwatch.GetElapsedMilliseconds();
+
+	String name("self-play samples on ");
+	name += pool.GetThreadCount();
+	name += String(" threads, ");
+	name += (double) recordedSamples * sizeof(PLAY_SAMPLE) / writer.GetWrittenBytes();
+	name += String(" times compressed");
+	Report(name, milliseconds, (int) recordedSamples, (int) writer.GetWrittenSampleCount());
+
+	std::vector<PLAY_SAMPLE> samples;
+	int wins = 0;
+	stopwatch.Restart();
+	for (int shard = 0; shard < writer.GetShardCount(); ++shard)
+	{
+		TCHAR shardName[MAX_PATH];
+		SelfPlayWriter::GetShardName(prefix, shard, shardName);
+		samples.clear();
+		if (!SelfPlayWriter::ReadShard(shardName, samples)) OutputDebugString(String("self-play shard damaged\n"));
+		for (size_t i = 0; i < samples.size(); ++i) wins += samples[i].outcome > 0;
+		DeleteFile(shardName);
+	}
+	name = String("self-play samples read from ");
+	name += writer.GetShardCount();
+	name += String(" shards");
+	Report(name, stopwatch.GetElapsedMilliseconds(), (int) recordedSamples, wins);
+}
+
+void Benchmark::RunValueNetwork()
+{
+	// positions from cautious play on generated arenas, evaluated one by one and in batches
+	const int positions = 4096;
+	const int rounds = 25;
+	ValueNetwork network;
+	network.Randomize(44);
+
+	ArenaGenerator generator;
+	ArenaGrid arena;
+	Random random(44);
+	std::vector<unsigned char> inputs(positions * ValueNetwork::INPUTS);
+	for (int i = 0; i < positions; ++i)
+	{
+		if (i % 64 == 0) generator.Generate(arena, ArenaGenerator::CAVE, 48, 48, 0.45, i);
+		CELL cells[2] = { generator.FindFreeCell(), generator.FindFreeCell() };
+		ValueNetwork::EncodeInputs(arena, cells, random.NextInt(2), &inputs[i * ValueNetwork::INPUTS]);
+	}
+
+	std::vector<float> values(positions);
+	for (int batchSize = 1; batchSize <= ValueNetwork::BATCH_SIZE; batchSize *= 8)
+	{
+		Stopwatch stopwatch;
+		for (int round = 0; round < rounds; ++round)
+		{
+			for (int first = 0; first < positions; first += batchSize)
+			{
+				network.Evaluate(&inputs[first * ValueNetwork::INPUTS], batchSize, &values[first]);
+			}
+		}
+		double sum = 0.0;
+		for (int i = 0; i < positions; ++i) sum += values[i];
+		String name("value network ");
+		name += String(ValueNetwork::GetKernelName());
+		name += String(", batches of ");
+		name += batchSize;
+		Report(name, stopwatch.GetElapsedMilliseconds(), positions * rounds, (int) (sum * 1000.0));
+	}
+
+	// one move ahead with the network against the filler
+	const int matches = 200;
+	NetworkBot networkBot(&network);
+	FillBot fillBot;
+	Match match;
+	int ticks = 0, wins = 0;
+	Stopwatch stopwatch;
+	for (int i = 0; i < matches; ++i)
+	{
+		generator.Generate(arena, ArenaGenerator::CAVE, 48, 48, 0.45, i);
+		match.Start(arena, &networkBot, &fillBot, generator.FindFreeCell(), generator.FindFreeCell(), i, i);
+		if (match.Play(100000) == 0) ++wins;
+		ticks += match.GetTickCount();
+	}
+	Report(String("network bot ticks against filler"), stopwatch.GetElapsedMilliseconds(), ticks, wins);
+}
+
+void Benchmark::RunParameterTuner()
+{
+	// a few generations of heuristic bot weights, 64 matches per candidate on 32 caves
+	const int matches = 64;
+	const int generations = 6;
+	WorkerPool pool;
+	ParameterTuner tuner(16);
+	tuner.CreateMatches(matches, ArenaGenerator::CAVE, 32, 0.45, 45);
+	HeuristicBot defaultBot;
+	double defaults[HeuristicBot::WEIGHT_COUNT];
+	for (int weight = 0; weight < HeuristicBot::WEIGHT_COUNT; ++weight) defaults[weight] = defaultBot.GetWeight((HeuristicBot::Weight) weight);
+
+	Stopwatch stopwatch;
+	double defaultScore = tuner.Evaluate(pool, defaults);
+	tuner.Start(defaults, 0.5);
+	for (int generation = 0; generation < generations; ++generation)
+	{
+		double best = tuner.RunGeneration(pool);
+		String line("  generation ");
+		line += generation;
+		line += String(": best score ");
+		line += best;
+		line += String("\n");
+		OutputDebugString(line);
+	}
+	double milliseconds = stopwatch.GetElapsedMilliseconds();
+
+	String name("tuner matches, default score ");
+	name += defaultScore;
+	name += String(", tuned ");
+	name += tuner.GetBestScore();
+	name += String(", ");
+	name += tuner.GetCacheHitCount();
+	name += String(" cache hits");
+	Report(name, milliseconds, tuner.GetPlayedCount() * matches, (int) (tuner.GetBestScore() * 1000.0));
+
+	String weights("  tuned weights:");
+	for (int weight = 0; weight < HeuristicBot::WEIGHT_COUNT; ++weight)
+	{
+		weights += String(" ");
+		weights += tuner.GetBestWeights()[weight];
+	}
+	weights += String("\n");
+	OutputDebugString(weights);
+}
+
+void Benchmark::RunSymmetry()
+{
+	// every state in all 8 symmetries: the raw hashes tell them apart, the canonical ones must not
+	const int states = 512;
+	const int size = 20;
+	ArenaGenerator generator;
+	ArenaGrid arena;
+	std::vector<SymmetryBoard> boards;
+	boards.reserve(states * SymmetryBoard::SYMMETRY_COUNT);
+	for (int state = 0; state < states; ++state)
+	{
+		generator.Generate(arena, ArenaGenerator::OBSTACLES, size, size, 0.2, state);
+		CELL positions[2] = { generator.FindFreeCell(), generator.FindFreeCell() };
+		SymmetryBoard board;
+		board.Load(arena, positions);
+		for (int symmetry = 0; symmetry < SymmetryBoard::SYMMETRY_COUNT; ++symmetry)
+		{
+			boards.push_back(board);
+			boards.back().Transform(symmetry);
+		}
+	}
+
+	std::unordered_set<uint64_t> rawHashes;
+	for (size_t i = 0; i < boards.size(); ++i) rawHashes.insert(boards[i].GetHash());
+
+	Stopwatch stopwatch;
+	int symmetrySum = 0;
+	for (size_t i = 0; i < boards.size(); ++i) symmetrySum += boards[i].Canonicalise();
+	double milliseconds = stopwatch.GetElapsedMilliseconds();
+
+	std::unordered_set<uint64_t> canonicalHashes;
+	for (size_t i = 0; i < boards.size(); ++i) canonicalHashes.insert(boards[i].GetHash());
+
+	String name("canonicalise 20x20, ");
+	name += (int) rawHashes.size();
+	name += String(" states become ");
+	name += (int) canonicalHashes.size();
+	Report(name, milliseconds, (int) boards.size(), symmetrySum);
+}
+
+void Benchmark::RunParallelSearch()
+{
+	// the same positions with 20 ms each, searched by ever more threads: the nodes per second should grow with them
+	const int positionCount = 8;
+	const LONGLONG budget = 20000000;
+	ArenaGenerator generator;
+	std::vector<ArenaGrid> arenas(positionCount);
+	std::vector<CELL> positions;
+	for (int i = 0; i < positionCount; ++i)
+	{
+		generator.Generate(arenas[i], ArenaGenerator::OBSTACLES, 20, 20, 0.1, 47 + i);
+		positions.push_back(generator.FindFreeCell());
+		positions.push_back(generator.FindFreeCell());
+	}
+
+	for (int threads = 1; threads <= 16; threads *= 2)
+	{
+		SearchBot bot(threads);
+		bot.SetLimits(SearchBot::MAX_DEPTH, budget);
+		LONGLONG nodes = 0;
+		int depthSum = 0;
+		Stopwatch stopwatch;
+		for (int i = 0; i < positionCount; ++i)
+		{
+			bot.StartMatch(0, i);
+			bot.ChooseDirection(arenas[i], &positions[i * 2], 0);
+			nodes += bot.GetNodeCount();
+			depthSum += bot.GetDepth();
+		}
+		double milliseconds = stopwatch.GetElapsedMilliseconds();
+
+		String name("lazy SMP nodes, ");
+		name += threads;
+		name += String(" threads, ");
+		name += (int) (nodes * 1000.0 / milliseconds);
+		name += String(" nodes/s");
+		Report(name, milliseconds, (int) nodes, depthSum);
+	}
+
+	// the budget holds as for any bot: the match times every decision
+	LatencyHistogram latency;
+	SearchBot searchBot;
+	searchBot.SetLimits(SearchBot::MAX_DEPTH, 5000000);
+	HeuristicBot heuristicBot;
+	Match match;
+	match.SetBudget(5000000, BUDGET_WARN);
+	match.SetLatencyHistogram(0, &latency);
+	match.Start(arenas[0], &searchBot, &heuristicBot, positions[0], positions[1], 0, 0);
+	Stopwatch stopwatch;
+	int winner = match.Play(1000);
+	double milliseconds = stopwatch.GetElapsedMilliseconds();
+
+	String name("lazy SMP match against heuristic, 5 ms budget, ");
+	name += match.GetOverrunCount(0);
+	name += String(" overruns, slowest ");
+	name += (double) latency.GetMax() / 1000000.0;
+	name += String(" ms");
+	Report(name, milliseconds, match.GetTickCount(), winner);
+}
+
+void Benchmark::RunMoveOrdering()
+{
+	// one thread to a fixed depth, adding one heuristic at a time: the nodes should drop, the scores stay the same
+	const int positionCount = 8;
+	const int depth = 9;
+	static const int heuristics[5] = { 0, MoveOrdering::TABLE_MOVE, MoveOrdering::TABLE_MOVE | MoveOrdering::KILLERS,
+		MoveOrdering::TABLE_MOVE | MoveOrdering::KILLERS | MoveOrdering::HISTORY, MoveOrdering::ALL_HEURISTICS };
+	static const char* namesPtr[5] = { "no ordering", "table move", "table move, killers", "table move, killers, history", "table move, killers, history, territory" };
+	ArenaGenerator generator;
+	std::vector<ArenaGrid> arenas(positionCount);
+	std::vector<CELL> positions;
+	for (int i = 0; i < positionCount; ++i)
+	{
+		generator.Generate(arenas[i], ArenaGenerator::OBSTACLES, 20, 20, 0.1, 48 + i);
+		positions.push_back(generator.FindFreeCell());
+		positions.push_back(generator.FindFreeCell());
+	}
+
+	SearchBot bot(1);
+	bot.SetLimits(depth, 0);
+	for (int config = 0; config < 5; ++config)
+	{
+		bot.SetOrdering(heuristics[config]);
+		LONGLONG nodes = 0;
+		int scoreSum = 0;
+		Stopwatch stopwatch;
+		for (int i = 0; i < positionCount; ++i)
+		{
+			bot.StartMatch(0, i);
+			bot.ChooseDirection(arenas[i], &positions[i * 2], 0);
+			nodes += bot.GetNodeCount();
+			scoreSum += bot.GetScore();
+		}
+		double milliseconds = stopwatch.GetElapsedMilliseconds();
+
+		String name("depth 9 search, ");
+		name += namesPtr[config];
+		name += String(", ");
+		name += (int) nodes;
+		name += String(" nodes");
+		Report(name, milliseconds, (int) nodes, scoreSum);
+	}
+}
+
+void Benchmark::RunTickResolution()
+{
+	const int ticks = 256;
+	const int size = 256;
+	ArenaGrid open;
+	open.Create(size, size);
+	open.AddWallRing();
+	TickResolver resolver;
+
+	// three players claim the same cell and all of them collide, next to a move into the wall, a free move and a player out of the match
+	{
+		ArenaGrid arena(open);
+		CELL positions[6] = { { 9, 10 }, { 11, 10 }, { 10, 9 }, { 1, 5 }, { 20, 20 }, { 30, 30 } };
+		const int directions[6] = { 2, 0, 3, 0, 1, -1 };
+		const MOVE_OUTCOME expected[6] = { MOVE_COLLIDED, MOVE_COLLIDED, MOVE_COLLIDED, MOVE_BLOCKED, MOVE_DONE, MOVE_NONE };
+		resolver.Gather(arena, positions, directions, 6);
+		resolver.Resolve();
+		resolver.Commit(arena, positions);
+		bool isMatching = resolver.GetCollisionCount() == 3 && !arena.IsRigid(10, 10) && arena.IsRigid(20, 19);
+		for (int player = 0; player < 6; ++player)
+		{
+			if (resolver.GetOutcome(player) != expected[player]) isMatching = false;
+		}
+		if (positions[0].x != 9 || positions[1].x != 11 || positions[2].y != 9 || positions[4].y != 19) isMatching = false;
+		if (!isMatching) OutputDebugString(String("tick resolution of a three-way claim MISMATCH\n"));
+	}
+
+	// ever more players with random intents in an open arena, every tick gathered, resolved and committed at once
+	for (int playerCount = 2; playerCount <= 512; playerCount *= 4)
+	{
+		ArenaGrid arena(open);
+		std::vector<CELL> positions(playerCount);
+		std::vector<int> directions(playerCount);
+		unsigned int seed = playerCount;
+		for (int player = 0; player < playerCount; ++player)
+		{
+			positions[player].x = 1 + NextRandom(seed) % (size - 2);
+			positions[player].y = 1 + NextRandom(seed) % (size - 2);
+		}
+
+		int collisions = 0;
+		Stopwatch stopwatch;
+		for (int tick = 0; tick < ticks; ++tick)
+		{
+			for (int player = 0; player < playerCount; ++player) directions[player] = NextRandom(seed) & 3;
+			resolver.Gather(arena, &positions[0], &directions[0], playerCount);
+			resolver.Resolve();
+			resolver.Commit(arena, &positions[0]);
+			collisions += resolver.GetCollisionCount();
+		}
+		String name("resolve ticks, ");
+		name += playerCount;
+		name += String(" players, per player move");
+		Report(name, stopwatch.GetElapsedMilliseconds(), ticks * playerCount, collisions);
+	}
+
+	// the same matches played move after move and all at once: simultaneous matches end in a draw when the heads collide
+	const int matchCount = 1000;
+	ArenaGenerator generator;
+	ArenaGrid arena;
+	RandomBot randomBot;
+	FillBot fillBot;
+	Match match;
+	for (int simultaneous = 0; simultaneous < 2; ++simultaneous)
+	{
+		match.SetSimultaneous(simultaneous != 0);
+		int tickCount = 0, draws = 0, collisions = 0;
+		Stopwatch stopwatch;
+		for (int i = 0; i < matchCount; ++i)
+		{
+			generator.Generate(arena, ArenaGenerator::OBSTACLES, 20, 20, 0.1, 49 + i);
+			CELL firstStart = generator.FindFreeCell(), secondStart = generator.FindFreeCell();
+			match.Start(arena, &randomBot, &fillBot, firstStart, secondStart, i, i);
+			if (match.Play(100000) == Match::NO_WINNER) ++draws;
+			if (match.GetLossCause(0) == LOSS_COLLISION) ++collisions;
+			tickCount += match.GetTickCount();
+		}
+		String name(simultaneous ? "simultaneous matches, " : "sequential matches, ");
+		name += draws;
+		name += String(" draws, ");
+		name += collisions;
+		name += String(" collisions, per tick");
+		Report(name, stopwatch.GetElapsedMilliseconds(), tickCount, tickCount);
+	}
+}
+
+void Benchmark::RunPlayouts()
+{
+	// the same random games one at a time and 64 or 256 at once; the win rates should agree, the times not.
+	// The 10x10 arena fits a word, so its games are bitboards at a few operations a move; the bigger ones
+	// are bit-sliced, where a move costs the cells the heads are spread over
+	const int playouts = 16384;
+	const int maxMoves = 1000;
+	static const int sizes[3] = { 10, 16, 32 };
+	ArenaGenerator generator;
+	ArenaGrid arena;
+	for (int i = 0; i < 3; ++i)
+	{
+		int size = sizes[i];
+		generator.Generate(arena, ArenaGenerator::OBSTACLES, size, size, 0.1, 50);
+		CELL starts[2] = { generator.FindFreeCell(), generator.FindFreeCell() };
+		String arenaName("");
+		arenaName += size;
+		arenaName += String("x");
+		arenaName += size;
+
+		Random random(50);
+		int wins = 0;
+		Stopwatch stopwatch;
+		for (int playout = 0; playout < playouts; ++playout)
+		{
+			ArenaGrid game(arena);
+			CELL positions[2] = { starts[0], starts[1] };
+			if (PlayScalarPlayout(game, positions, 0, random, maxMoves) == 0) ++wins;
+		}
+		Report(String("scalar playouts, ") + arenaName, stopwatch.GetElapsedMilliseconds(), playouts, wins);
+
+		Playout64 playout64;
+		wins = 0;
+		stopwatch.Restart();
+		for (int batch = 0; batch < playouts / Playout64::GAMES; ++batch)
+		{
+			playout64.Start(arena, starts, 0, batch);
+			playout64.Play(maxMoves);
+			wins += playout64.GetWinCount(0);
+		}
+		Report(String("bitsliced playouts, 64 games, ") + arenaName, stopwatch.GetElapsedMilliseconds(), playouts, wins);
+
+		Playout256 playout256;
+		wins = 0;
+		stopwatch.Restart();
+		for (int batch = 0; batch < playouts / Playout256::GAMES; ++batch)
+		{
+			playout256.Start(arena, starts, 0, batch);
+			playout256.Play(maxMoves);
+			wins += playout256.GetWinCount(0);
+		}
+		Report(String("bitsliced playouts, 256 games, ") + arenaName, stopwatch.GetElapsedMilliseconds(), playouts, wins);
+	}
+
+	// the playouts put to use: flat Monte Carlo against the heuristic bot on small caves
+	const int matchCount = 20;
+	PlayoutBot playoutBot;
+	HeuristicBot heuristicBot;
+	Match match;
+	int wins = 0, tickCount = 0;
+	Stopwatch stopwatch;
+	for (int i = 0; i < matchCount; ++i)
+	{
+		generator.Generate(arena, ArenaGenerator::CAVE, 12, 12, 0.4, 50 + i);
+		CELL firstStart = generator.FindFreeCell(), secondStart = generator.FindFreeCell();
+		int side = i & 1;
+		match.Start(arena, side == 0 ? (Bot*) &playoutBot : (Bot*) &heuristicBot, side == 0 ? (Bot*) &heuristicBot : (Bot*) &playoutBot, firstStart, secondStart, i, i);
+		if (match.Play(1000) == side) ++wins;
+		tickCount += match.GetTickCount();
+	}
+	String name("playout bot against heuristic, ");
+	name += wins;
+	name += String(" of ");
+	name += matchCount;
+	name += String(" won, per tick");
+	Report(name, stopwatch.GetElapsedMilliseconds(), tickCount, wins);
+}
+
+template<class Grid>
+void Benchmark::RunSearches(const Grid& gridRef, String const& layoutRef)
+{
+	PathFinder<Grid> pathFinder;
+	int cells = gridRef.GetWidth() * gridRef.GetHeight();
+	int centre = gridRef.GetWidth() / 2;
+
+	Stopwatch stopwatch;
+	int reached = pathFinder.BreadthFirst(gridRef, centre, centre);
+	Report(String(layoutRef) + " BFS", stopwatch.GetElapsedMilliseconds(), cells, reached);
+
+	stopwatch.Restart();
+	int area = pathFinder.FloodFill(gridRef, centre, centre);
+	Report(String(layoutRef) + " flood fill", stopwatch.GetElapsedMilliseconds(), cells, area);
+
+	stopwatch.Restart();
+	int length = pathFinder.AStar(gridRef, 1, 1, gridRef.GetWidth() - 2, gridRef.GetHeight() - 2);
+	Report(String(layoutRef) + " A* corner to corner", stopwatch.GetElapsedMilliseconds(), cells, length);
+}
+
+void Benchmark::Report(String const& nameRef, double milliseconds, int operations, int checksum)
+{
+	String line = nameRef;
+	line += String(": ");
+	line += milliseconds;
+	line += String(" ms, ");
+	line += milliseconds * 1000000.0 / operations;
+	line += String(" ns/op (checksum ");
+	line += checksum;
+	line += String(")\n");
+	OutputDebugString(line);
+}
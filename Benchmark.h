@@ -0,0 +1,79 @@
+//-----------------------------------------------------------------
+// Benchmark Object
+// C++ Header - Benchmark.h - version 2010 v2_07
+//
+// Benchmark times the arena data structures and AI algorythms.
+// Press B while the game runs; the results go to the debug output.
+//-----------------------------------------------------------------
+
+#pragma once
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#include "GameEngine.h"
+
+//-----------------------------------------------------------------
+// Benchmark Class
+//-----------------------------------------------------------------
+class Benchmark
+{
+public:
+	//---------------------------
+	// Constructor(s)
+	//---------------------------
+	Benchmark();
+
+	//---------------------------
+	// Destructor
+	//---------------------------
+	virtual ~Benchmark();
+
+	//---------------------------
+	// General Methods
+	//---------------------------
+	void RunAll();
+
+	void RunSentinelMove();
+	void RunGridLayouts();
+	void RunChunkedSnapshots();
+	void RunDistanceFields();
+	void RunReplanning();
+	void RunHierarchicalPaths();
+	void RunCooperativePlanning();
+	void RunFlowFields();
+	void RunPathQueryBatch();
+	void RunPathCache();
+	void RunWeightedSearches();
+	void RunReachability();
+	void RunArenaImages();
+	void RunArenaCorpus();
+	void RunMatchStatistics();
+	void RunMoveLatency();
+	void RunRatings();
+	void RunSelfPlay();
+	void RunValueNetwork();
+	void RunParameterTuner();
+	void RunSymmetry();
+	void RunParallelSearch();
+	void RunMoveOrdering();
+	void RunTickResolution();
+	void RunPlayouts();
+
+private:
+	// -------------------------
+	// Member functions
+	// -------------------------
+	void Report(String const& nameRef, double milliseconds, int operations, int checksum);
+
+	template<class Grid>
+	void RunSearches(const Grid& gridRef, String const& layoutRef);
+
+	// -------------------------
+	// Disabling default copy constructor and default assignment operator.
+	// If you get a linker error from one of these functions, your class is internally trying to use them. This is
+	// an error in your class, these declarations are deliberately made without implementation because they should never be used.
+	// -------------------------
+	Benchmark(const Benchmark& bRef);
+	Benchmark& operator=(const Benchmark& bRef);
+};
@@ -0,0 +1,157 @@
+//-----------------------------------------------------------------
+// BitboardSearch Object
+// C++ Source - BitboardSearch.cpp - version 2010 v2_07
+//-----------------------------------------------------------------
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#include "BitboardSearch.h"
+#include <algorithm>
+
+//-----------------------------------------------------------------
+// BitboardSearch methods
+//-----------------------------------------------------------------
+BitboardSearch::BitboardSearch() : m_expandedLayers(0)
+{
+	Create(0, 0);
+}
+
+BitboardSearch::~BitboardSearch()
+{
+	// nothing to destroy
+}
+
+void BitboardSearch::Create(int width, int height)
+{
+	m_width = width;
+	m_height = height;
+	m_wordsPerRow = (width + 63) >> 6;
+	m_stride = m_wordsPerRow + 2;
+
+	int wordCount = (height + 2) * m_stride;
+	m_free.assign(wordCount, 0);
+	for (int row = 0; row < height; ++row)
+	{
+		for (int word = 0; word < m_wordsPerRow; ++word)
+		{
+			// the bits past the width of the last word stay rigid
+			int bits = std::min(width - word * 64, 64);
+			m_free[WordIndex(word, row)] = bits == 64 ? ~(uint64_t) 0 : ((uint64_t) 1 << bits) - 1;
+		}
+	}
+	m_reached.assign(wordCount, 0);
+	m_reachedWords.clear();
+
+	for (int side = 0; side < 2; ++side)
+	{
+		Side& sideRef = m_sides[side];
+		sideRef.visited.assign(wordCount, 0);
+		sideRef.frontier.assign(wordCount, 0);
+		sideRef.frontierWords.clear();
+		sideRef.nextWords.clear();
+		sideRef.visitedWords.clear();
+		sideRef.depth = 0;
+	}
+}
+
+int BitboardSearch::GetDistance(int startX, int startY, int goalX, int goalY)
+{
+	return Search(startX, startY, goalX, goalY, true);
+}
+
+int BitboardSearch::GetDistanceOneSided(int startX, int startY, int goalX, int goalY)
+{
+	return Search(startX, startY, goalX, goalY, false);
+}
+
+int BitboardSearch::Search(int startX, int startY, int goalX, int goalY, bool isBidirectional)
+{
+	m_expandedLayers = 0;
+	if (startX == goalX && startY == goalY) return 0;
+
+	Side& startSideRef = m_sides[0];
+	Side& goalSideRef = m_sides[1];
+	Seed(startSideRef, startX, startY);
+	Seed(goalSideRef, goalX, goalY);
+
+	for (;;)
+	{
+		// grow the side with the smaller frontier, it costs less and it is the first to run dry when trapped
+		bool growGoalSide = isBidirectional && goalSideRef.frontierWords.size() < startSideRef.frontierWords.size();
+		Side& sideRef = growGoalSide ? goalSideRef : startSideRef;
+		Side& otherSideRef = growGoalSide ? startSideRef : goalSideRef;
+
+		++m_expandedLayers;
+		if (Step(sideRef, otherSideRef)) return startSideRef.depth + goalSideRef.depth;
+		if (sideRef.frontierWords.empty()) return UNREACHABLE;
+	}
+}
+
+void BitboardSearch::Seed(Side& sideRef, int x, int y)
+{
+	// wipe the previous search, only where it wrote
+	for (size_t i = 0; i < sideRef.visitedWords.size(); ++i)
+	{
+		sideRef.visited[sideRef.visitedWords[i]] = 0;
+	}
+	for (size_t i = 0; i < sideRef.frontierWords.size(); ++i)
+	{
+		sideRef.frontier[sideRef.frontierWords[i]] = 0;
+	}
+	sideRef.visitedWords.clear();
+	sideRef.frontierWords.clear();
+
+	int index = WordIndex(x >> 6, y);
+	sideRef.visited[index] = sideRef.frontier[index] = (uint64_t) 1 << (x & 63);
+	sideRef.visitedWords.push_back(index);
+	sideRef.frontierWords.push_back(index);
+	sideRef.depth = 0;
+}
+
+// grows one layer, returns true when it touches the other side
+bool BitboardSearch::Step(Side& sideRef, const Side& otherSideRef)
+{
+	++sideRef.depth;
+
+	// spread every frontier word to itself, the words left and right (across the border) and the rows above and below
+	for (size_t i = 0; i < sideRef.frontierWords.size(); ++i)
+	{
+		int index = sideRef.frontierWords[i];
+		uint64_t bits = sideRef.frontier[index];
+		sideRef.frontier[index] = 0;
+		Reach(index, bits | (bits << 1) | (bits >> 1));
+		Reach(index - 1, bits << 63);
+		Reach(index + 1, bits >> 63);
+		Reach(index - m_stride, bits);
+		Reach(index + m_stride, bits);
+	}
+
+	// the reached free cells that weren't visited yet are the new frontier
+	bool isTouching = false;
+	sideRef.nextWords.clear();
+	for (size_t i = 0; i < m_reachedWords.size(); ++i)
+	{
+		int index = m_reachedWords[i];
+		uint64_t reached = m_reached[index];
+		m_reached[index] = 0;
+		// the other side's start cell counts even when it is rigid
+		if (reached & otherSideRef.visited[index]) isTouching = true;
+		uint64_t grown = reached & m_free[index] & ~sideRef.visited[index];
+		if (grown == 0) continue;
+		if (sideRef.visited[index] == 0) sideRef.visitedWords.push_back(index);
+		sideRef.visited[index] |= grown;
+		sideRef.frontier[index] = grown;
+		sideRef.nextWords.push_back(index);
+	}
+	m_reachedWords.clear();
+	sideRef.frontierWords.swap(sideRef.nextWords);
+	return isTouching;
+}
+
+void BitboardSearch::Reach(int index, uint64_t bits)
+{
+	if (bits == 0) return;
+	if (m_reached[index] == 0) m_reachedWords.push_back(index);
+	m_reached[index] |= bits;
+}
@@ -0,0 +1,120 @@
+//-----------------------------------------------------------------
+// BitboardSearch Object
+// C++ Header - BitboardSearch.h - version 2010 v2_07
+//
+// BitboardSearch answers "can I still reach that cell, and how far is
+// it?" with a breadth first search on bits. The free cells are kept as
+// rows of 64 bit words, and a whole BFS layer grows at once: shifting a
+// frontier row left and right and or-ing in the rows above and below
+// reaches every neighbour of 64 cells in a few instructions. The search
+// only visits the words the frontier is in and their neighbours, and it
+// runs from both ends, always growing the smaller frontier, and stops as
+// soon as the two meet or one of them runs dry, so a trapped player is
+// recognised after a handful of layers.
+//-----------------------------------------------------------------
+
+#pragma once
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#include "RigidCellListener.h"
+#include <vector>
+#include <stdint.h>
+
+//-----------------------------------------------------------------
+// BitboardSearch Class
+//-----------------------------------------------------------------
+class BitboardSearch : public RigidCellListener
+{
+public:
+	static const int UNREACHABLE = -1;
+
+	//---------------------------
+	// Constructor(s)
+	//---------------------------
+	BitboardSearch();
+
+	//---------------------------
+	// Destructor
+	//---------------------------
+	virtual ~BitboardSearch();
+
+	//---------------------------
+	// General Methods
+	//---------------------------
+	void Create(int width, int height);		// all cells free, everything outside rigid
+
+	template<class Grid>
+	void Load(const Grid& gridRef)			// copies the rigid cells of any arena grid
+	{
+		Create(gridRef.GetWidth(), gridRef.GetHeight());
+		for (int y = 0; y < m_height; ++y)
+		{
+			for (int x = 0; x < m_width; ++x)
+			{
+				if (gridRef.IsRigid(x, y)) SetRigid(x, y);
+			}
+		}
+	}
+
+	void SetRigid(int x, int y) { m_free[WordIndex(x >> 6, y)] &= ~((uint64_t) 1 << (x & 63)); }
+	void SetFree(int x, int y) { m_free[WordIndex(x >> 6, y)] |= (uint64_t) 1 << (x & 63); }
+	bool IsRigid(int x, int y) const { return ((m_free[WordIndex(x >> 6, y)] >> (x & 63)) & 1) == 0; }
+	void CellBecameRigid(int x, int y) { SetRigid(x, y); }
+
+	// shortest distance or UNREACHABLE; start and goal may be rigid themselves (e.g. the heads of two players)
+	int GetDistance(int startX, int startY, int goalX, int goalY);
+	bool IsReachable(int startX, int startY, int goalX, int goalY) { return GetDistance(startX, startY, goalX, goalY) != UNREACHABLE; }
+
+	// the same search growing only the start side, for comparison
+	int GetDistanceOneSided(int startX, int startY, int goalX, int goalY);
+
+	int GetWidth() const { return m_width; }
+	int GetHeight() const { return m_height; }
+	int GetExpandedLayerCount() const { return m_expandedLayers; }
+
+private:
+	// -------------------------
+	// Internal structs
+	// -------------------------
+	// one end of the search
+	struct Side
+	{
+		std::vector<uint64_t> visited, frontier;
+		std::vector<int> frontierWords, nextWords;		// indices of the words that hold frontier cells
+		std::vector<int> visitedWords;					// so the next search only clears what this one set
+		int depth;
+	};
+
+	// -------------------------
+	// Member functions
+	// -------------------------
+
+	// the rows and the words of a row are padded with a zero word on every side, so neighbours never need a bounds check
+	int WordIndex(int word, int row) const { return (row + 1) * m_stride + word + 1; }
+
+	int Search(int startX, int startY, int goalX, int goalY, bool isBidirectional);
+	void Seed(Side& sideRef, int x, int y);
+	bool Step(Side& sideRef, const Side& otherSideRef);
+	void Reach(int index, uint64_t bits);
+
+	// -------------------------
+	// Datamembers
+	// -------------------------
+	int m_width, m_height;
+	int m_wordsPerRow, m_stride;
+	std::vector<uint64_t> m_free;		// one bit per cell, set when free
+	std::vector<uint64_t> m_reached;	// scratch: the cells next to the frontier, zero between steps
+	std::vector<int> m_reachedWords;
+	Side m_sides[2];
+	int m_expandedLayers;
+
+	// -------------------------
+	// Disabling default copy constructor and default assignment operator.
+	// If you get a linker error from one of these functions, your class is internally trying to use them. This is
+	// an error in your class, these declarations are deliberately made without implementation because they should never be used.
+	// -------------------------
+	BitboardSearch(const BitboardSearch& bsRef);
+	BitboardSearch& operator=(const BitboardSearch& bsRef);
+};
@@ -0,0 +1,507 @@
+//-----------------------------------------------------------------
+// BitslicedPlayout Object
+// C++ Header - BitslicedPlayout.h - version 2010 v2_07
+//
+// BitslicedPlayout plays 64 (WORDS 1) or 256 (WORDS 4) random games from
+// the same position. Only the box around the free cells and the heads
+// is kept; nothing outside it can ever be reached.
+//
+// When the box has at most 64 cells, as on small arenas, in endgames and
+// at MCTS leaves, every game is a bitboard of a single word: the rigid
+// cells, and a bit for each head. A move shifts the head one step in
+// every direction, so it is the same few word operations wherever the
+// heads are. The games go through an SSE2 or AVX2 register where the
+// compiler has one, a lane per game; what changes only when a game ends
+// is left out of the turn, so the rest stays in registers. A lane whose
+// game is over starts the next one from the start position, until it
+// has played its share of the games, so no lane waits for the longest.
+//
+// Bigger boxes are bit-sliced: every cell is a word with a bit per game,
+// one for rigid and one per player for the head, and a move is a few
+// word operations per cell that holds a head in any of the 64 games of
+// the word. Those cells, the frontier, are kept in a list per player, so
+// the cost follows the cells the live heads are spread over. The heads
+// of more games spread out further, so the words are played one at a
+// time and 256 games cost four times 64.
+//
+// The rules are those of SearchBot: the players move one after the
+// other, both heads are rigid, and a player without a free neighbour
+// loses. The random policy picks a random direction and, when that one
+// is rigid, the first free one after it clockwise, so a player never
+// runs into a wall while it has a way out. Play once after every Start.
+//-----------------------------------------------------------------
+
+#pragma once
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#include "ArenaGrid.h"
+#include "Random.h"
+#include <vector>
+#include <algorithm>
+#include <stdint.h>
+
+// AVX2 needs /arch:AVX2 (or -mavx2); SSE2 is always there on x64, and on x86 with /arch:SSE2
+#if defined(__AVX2__)
+#define BITSLICED_PLAYOUT_AVX2
+#include <immintrin.h>
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BITSLICED_PLAYOUT_SSE2
+#include <emmintrin.h>
+#endif
+
+//-----------------------------------------------------------------
+// PlayoutVector Structs
+//-----------------------------------------------------------------
+// the widest register that fits in WORDS words, and the operations on its words that the bitboard games need
+template<int WORDS>
+struct PlayoutVector
+{
+	typedef uint64_t Type;
+	static const int STEP = 1;		// words per register
+	static Type Zero() { return 0; }
+	static Type Fill(uint64_t word) { return word; }
+	static Type Load(const uint64_t* wordsPtr) { return *wordsPtr; }
+	static void Store(uint64_t* wordsPtr, Type value) { *wordsPtr = value; }
+	static Type And(Type first, Type second) { return first & second; }
+	static Type AndNot(Type first, Type second) { return first & ~second; }
+	static Type Or(Type first, Type second) { return first | second; }
+	static Type Xor(Type first, Type second) { return first ^ second; }
+	static Type Add(Type first, Type second) { return first + second; }
+	static Type Sub(Type first, Type second) { return first - second; }
+	static Type ShiftLeft(Type value, int count) { return value << count; }
+	static Type ShiftRight(Type value, int count) { return value >> count; }
+	static Type ZeroMask(Type value) { return (uint64_t) 0 - (value == 0); }		// all ones in the words that are 0
+	static bool IsZero(Type value) { return value == 0; }
+};
+
+#if defined(BITSLICED_PLAYOUT_SSE2)
+template<>
+struct PlayoutVector<2>
+{
+	typedef __m128i Type;
+	static const int STEP = 2;
+	static Type Zero() { return _mm_setzero_si128(); }
+	static Type Fill(uint64_t word) { return _mm_set_epi32((int) (word >> 32), (int) word, (int) (word >> 32), (int) word); }
+	static Type Load(const uint64_t* wordsPtr) { return _mm_loadu_si128((const __m128i*) wordsPtr); }
+	static void Store(uint64_t* wordsPtr, Type value) { _mm_storeu_si128((__m128i*) wordsPtr, value); }
+	static Type And(Type first, Type second) { return _mm_and_si128(first, second); }
+	static Type AndNot(Type first, Type second) { return _mm_andnot_si128(second, first); }
+	static Type Or(Type first, Type second) { return _mm_or_si128(first, second); }
+	static Type Xor(Type first, Type second) { return _mm_xor_si128(first, second); }
+	static Type Add(Type first, Type second) { return _mm_add_epi64(first, second); }
+	static Type Sub(Type first, Type second) { return _mm_sub_epi64(first, second); }
+	static Type ShiftLeft(Type value, int count) { return _mm_sll_epi64(value, _mm_cvtsi32_si128(count)); }
+	static Type ShiftRight(Type value, int count) { return _mm_srl_epi64(value, _mm_cvtsi32_si128(count)); }
+	static Type ZeroMask(Type value)
+	{
+		// SSE2 compares 32 bits at most: a word is 0 when both its halves are
+		Type halves = _mm_cmpeq_epi32(value, _mm_setzero_si128());
+		return _mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+	}
+	static bool IsZero(Type value) { return _mm_movemask_epi8(_mm_cmpeq_epi8(value, _mm_setzero_si128())) == 0xffff; }
+};
+#endif
+
+#if defined(BITSLICED_PLAYOUT_AVX2)
+template<>
+struct PlayoutVector<4>
+{
+	typedef __m256i Type;
+	static const int STEP = 4;
+	static Type Zero() { return _mm256_setzero_si256(); }
+	static Type Fill(uint64_t word)
+	{
+		int low = (int) word, high = (int) (word >> 32);
+		return _mm256_set_epi32(high, low, high, low, high, low, high, low);
+	}
+	static Type Load(const uint64_t* wordsPtr) { return _mm256_loadu_si256((const __m256i*) wordsPtr); }
+	static void Store(uint64_t* wordsPtr, Type value) { _mm256_storeu_si256((__m256i*) wordsPtr, value); }
+	static Type And(Type first, Type second) { return _mm256_and_si256(first, second); }
+	static Type AndNot(Type first, Type second) { return _mm256_andnot_si256(second, first); }
+	static Type Or(Type first, Type second) { return _mm256_or_si256(first, second); }
+	static Type Xor(Type first, Type second) { return _mm256_xor_si256(first, second); }
+	static Type Add(Type first, Type second) { return _mm256_add_epi64(first, second); }
+	static Type Sub(Type first, Type second) { return _mm256_sub_epi64(first, second); }
+	static Type ShiftLeft(Type value, int count) { return _mm256_sll_epi64(value, _mm_cvtsi32_si128(count)); }
+	static Type ShiftRight(Type value, int count) { return _mm256_srl_epi64(value, _mm_cvtsi32_si128(count)); }
+	static Type ZeroMask(Type value) { return _mm256_cmpeq_epi64(value, _mm256_setzero_si256()); }
+	static bool IsZero(Type value) { return _mm256_testz_si256(value, value) != 0; }
+};
+#elif defined(BITSLICED_PLAYOUT_SSE2)
+template<>
+struct PlayoutVector<4> : public PlayoutVector<2>
+{
+};
+#endif
+
+//-----------------------------------------------------------------
+// BitslicedPlayout Class
+//-----------------------------------------------------------------
+template<int WORDS>
+class BitslicedPlayout
+{
+public:
+	static const int GAMES = 64 * WORDS;
+
+	//---------------------------
+	// Constructor(s)
+	//---------------------------
+	BitslicedPlayout() : m_isBitboard(false), m_left(0), m_top(0), m_stride(0), m_boxWidth(0), m_startBoard(0), m_firstColumn(0), m_lastColumn(0), m_stamp(0), m_player(0), m_gameMoves(0)
+	{
+		m_winCounts[0] = m_winCounts[1] = 0;
+	}
+
+	//---------------------------
+	// Destructor
+	//---------------------------
+	virtual ~BitslicedPlayout()
+	{
+	}
+
+	//---------------------------
+	// General Methods
+	//---------------------------
+	// every game starts from this position, with player to move
+	template<class Grid>
+	void Start(const Grid& gridRef, const CELL* positionsPtr, int player, uint64_t seed)
+	{
+		// the box around the free cells and the heads
+		int width = gridRef.GetWidth(), height = gridRef.GetHeight();
+		int right = positionsPtr[0].x, bottom = positionsPtr[0].y;
+		m_left = right;
+		m_top = bottom;
+		for (int y = 0; y < height; ++y)
+		{
+			for (int x = 0; x < width; ++x)
+			{
+				if (gridRef.IsRigid(x, y) && (x != positionsPtr[1].x || y != positionsPtr[1].y)) continue;
+				m_left = std::min(m_left, x);
+				m_top = std::min(m_top, y);
+				right = std::max(right, x);
+				bottom = std::max(bottom, y);
+			}
+		}
+		m_boxWidth = right - m_left + 1;
+		int boxHeight = bottom - m_top + 1;
+
+		// a single row of 64 cells would shift a word by its whole width
+		m_isBitboard = m_boxWidth * boxHeight <= 64 && m_boxWidth < 64;
+		if (m_isBitboard) StartBitboards(gridRef, positionsPtr, boxHeight);
+		else StartFrontiers(gridRef, positionsPtr, boxHeight);
+
+		for (int word = 0; word < WORDS; ++word) m_randoms[word].Seed(seed * WORDS + word);
+		m_winCounts[0] = m_winCounts[1] = 0;
+		m_player = player;
+		m_gameMoves = 0;
+	}
+
+	// plays until every game is over or maxMoves moves (of either player) have been made; the games still going are draws
+	void Play(int maxMoves)
+	{
+		if (m_isBitboard) PlayBitboards(maxMoves);
+		else
+		{
+			for (int word = 0; word < WORDS; ++word) PlayFrontier(word, maxMoves);
+		}
+	}
+
+	int GetWinCount(int player) const { return m_winCounts[player]; }
+	int GetDrawCount() const { return GAMES - m_winCounts[0] - m_winCounts[1]; }
+	int64_t GetGameMoveCount() const { return m_gameMoves; }		// the moves made in all games together
+	bool IsBitboard() const { return m_isBitboard; }				// whether the games of the last Start are bitboards of a word
+
+private:
+	// -------------------------
+	// Member functions
+	// -------------------------
+	typedef PlayoutVector<4> Lanes;		// a lane per bitboard game
+
+	int Index(int x, int y) const { return (y - m_top + 1) * m_stride + x - m_left + 1; }
+
+	template<class Grid>
+	void StartBitboards(const Grid& gridRef, const CELL* positionsPtr, int boxHeight)
+	{
+		// bit y * width + x of the box; the bits past its last row are rigid, so a step down from there finds no way out
+		int boxCells = m_boxWidth * boxHeight;
+		m_startBoard = boxCells < 64 ? ~(uint64_t) 0 << boxCells : 0;
+		m_firstColumn = m_lastColumn = 0;
+		for (int y = 0; y < boxHeight; ++y)
+		{
+			m_firstColumn |= (uint64_t) 1 << (y * m_boxWidth);
+			m_lastColumn |= (uint64_t) 1 << (y * m_boxWidth + m_boxWidth - 1);
+			for (int x = 0; x < m_boxWidth; ++x)
+			{
+				if (gridRef.IsRigid(m_left + x, m_top + y)) m_startBoard |= (uint64_t) 1 << (y * m_boxWidth + x);
+			}
+		}
+		for (int i = 0; i < 2; ++i)
+		{
+			m_startHeads[i] = (uint64_t) 1 << ((positionsPtr[i].y - m_top) * m_boxWidth + positionsPtr[i].x - m_left);
+			m_startBoard |= m_startHeads[i];
+		}
+	}
+
+	template<class Grid>
+	void StartFrontiers(const Grid& gridRef, const CELL* positionsPtr, int boxHeight)
+	{
+		// a ring of rigid cells around the box, like the sentinel ring of the arena grids; the heads stay rigid
+		m_stride = m_boxWidth + 2;
+		int cellCount = m_stride * (boxHeight + 2);
+		m_startRigid.assign(cellCount, ~(uint64_t) 0);
+		for (int y = m_top; y < m_top + boxHeight; ++y)
+		{
+			for (int x = m_left; x < m_left + m_boxWidth; ++x)
+			{
+				if (!gridRef.IsRigid(x, y)) m_startRigid[Index(x, y)] = 0;
+			}
+		}
+		for (int i = 0; i < 2; ++i)
+		{
+			m_startCells[i] = Index(positionsPtr[i].x, positionsPtr[i].y);
+			m_startRigid[m_startCells[i]] = ~(uint64_t) 0;
+		}
+		m_rigid.resize(cellCount);
+		m_heads[0].assign(cellCount, 0);
+		m_heads[1].assign(cellCount, 0);
+		m_next.assign(cellCount, 0);
+		m_stamps.assign(cellCount, 0);
+		m_stamp = 0;
+		m_frontiers[0].resize(cellCount);
+		m_frontiers[1].resize(cellCount);
+		m_nextFrontier.resize(cellCount * 4);
+	}
+
+	void PlayBitboards(int maxMoves)
+	{
+		// the lanes draw their own bits with a plain xorshift, which needs no multiply the registers lack; its state must never be 0
+		uint64_t laneWords[Lanes::STEP];
+		for (int lane = 0; lane < Lanes::STEP; ++lane) laneWords[lane] = m_randoms[0].Next() | 1;
+
+		const Lanes::Type ones = Lanes::Fill(~(uint64_t) 0), one = Lanes::Fill(1), moveLimit = Lanes::Fill((uint64_t) maxMoves);
+		const Lanes::Type firstColumn = Lanes::Fill(m_firstColumn), lastColumn = Lanes::Fill(m_lastColumn), startBoard = Lanes::Fill(m_startBoard);
+		const Lanes::Type startMover = Lanes::Fill(m_startHeads[m_player]), startWaiter = Lanes::Fill(m_startHeads[1 - m_player]), startPlayer = Lanes::Fill(m_player);
+		const int width = m_boxWidth;
+
+		// per lane the game it is playing; what changes only when a game ends is kept apart, so the rest stays in registers
+		Lanes::Type rigid = startBoard, mover = startMover, waiter = startWaiter, movesLeft = moveLimit, alive = ones, bits = Lanes::Zero();
+		Lanes::Type randoms = Lanes::Load(laneWords), gamesLeft = Lanes::Fill(GAMES / Lanes::STEP);
+		Lanes::Type moves = Lanes::Zero(), firstWins = Lanes::Zero(), secondWins = Lanes::Zero();
+		for (int turn = 0; !Lanes::IsZero(alive); ++turn)
+		{
+			// the head shifted one step in every direction, where that is free; a head in the first or last column has no neighbour past it
+			Lanes::Type left = Lanes::AndNot(Lanes::ShiftRight(Lanes::AndNot(mover, firstColumn), 1), rigid);
+			Lanes::Type up = Lanes::AndNot(Lanes::ShiftRight(mover, width), rigid);
+			Lanes::Type right = Lanes::AndNot(Lanes::ShiftLeft(Lanes::AndNot(mover, lastColumn), 1), rigid);
+			Lanes::Type down = Lanes::AndNot(Lanes::ShiftLeft(mover, width), rigid);
+			Lanes::Type leftBlocked = Lanes::ZeroMask(left), upBlocked = Lanes::ZeroMask(up), rightBlocked = Lanes::ZeroMask(right), downBlocked = Lanes::ZeroMask(down);
+
+			// a game that reached maxMoves is a draw; a player without a way out loses
+			Lanes::Type drawn = Lanes::And(alive, Lanes::ZeroMask(movesLeft));
+			Lanes::Type stuck = Lanes::And(Lanes::And(leftBlocked, upBlocked), Lanes::And(rightBlocked, downBlocked));
+			stuck = Lanes::AndNot(Lanes::And(alive, stuck), drawn);
+			Lanes::Type ended = Lanes::Or(stuck, drawn), live = Lanes::AndNot(alive, ended);
+
+			// per start direction, the first free neighbour clockwise from it
+			Lanes::Type fromLeft = Lanes::Or(left, Lanes::And(leftBlocked, Lanes::Or(up, Lanes::And(upBlocked, Lanes::Or(right, Lanes::And(rightBlocked, down))))));
+			Lanes::Type fromUp = Lanes::Or(up, Lanes::And(upBlocked, Lanes::Or(right, Lanes::And(rightBlocked, Lanes::Or(down, Lanes::And(downBlocked, left))))));
+			Lanes::Type fromRight = Lanes::Or(right, Lanes::And(rightBlocked, Lanes::Or(down, Lanes::And(downBlocked, Lanes::Or(left, Lanes::And(leftBlocked, up))))));
+			Lanes::Type fromDown = Lanes::Or(down, Lanes::And(downBlocked, Lanes::Or(left, Lanes::And(leftBlocked, Lanes::Or(up, Lanes::And(upBlocked, right))))));
+
+			// two random bits pick the start direction; a draw of the xorshift lasts 32 moves
+			if ((turn & 31) == 0)
+			{
+				randoms = Lanes::Xor(randoms, Lanes::ShiftRight(randoms, 12));
+				randoms = Lanes::Xor(randoms, Lanes::ShiftLeft(randoms, 25));
+				randoms = Lanes::Xor(randoms, Lanes::ShiftRight(randoms, 27));
+				bits = randoms;
+			}
+			Lanes::Type low = Lanes::Sub(Lanes::Zero(), Lanes::And(bits, one));
+			Lanes::Type high = Lanes::Sub(Lanes::Zero(), Lanes::And(Lanes::ShiftRight(bits, 1), one));
+			bits = Lanes::ShiftRight(bits, 2);
+			Lanes::Type next = Lanes::And(Select(high, Select(low, fromDown, fromRight), Select(low, fromUp, fromLeft)), live);
+
+			rigid = Lanes::Or(rigid, next);
+			mover = waiter;
+			waiter = next;
+			movesLeft = Lanes::Sub(movesLeft, Lanes::And(live, one));
+
+			// a lane whose game ended counts it, then starts the next one or retires when it has played its share
+			if (!Lanes::IsZero(ended))
+			{
+				// the moves played tell both the length of the game and, by their parity, who was to move
+				Lanes::Type played = Lanes::Sub(moveLimit, movesLeft);
+				Lanes::Type isSecond = Lanes::Sub(Lanes::Zero(), Lanes::And(Lanes::Add(played, startPlayer), one));
+				firstWins = Lanes::Sub(firstWins, Lanes::And(stuck, isSecond));
+				secondWins = Lanes::Sub(secondWins, Lanes::AndNot(stuck, isSecond));
+				moves = Lanes::Add(moves, Lanes::And(ended, played));
+				gamesLeft = Lanes::Sub(gamesLeft, Lanes::And(ended, one));
+				Lanes::Type restart = Lanes::AndNot(ended, Lanes::ZeroMask(gamesLeft));
+				alive = Lanes::AndNot(alive, Lanes::AndNot(ended, restart));
+				rigid = Select(restart, startBoard, rigid);
+				mover = Select(restart, startMover, mover);
+				waiter = Select(restart, startWaiter, waiter);
+				movesLeft = Select(restart, moveLimit, movesLeft);
+			}
+		}
+
+		// the lanes added up; subtracting all ones is how a lane counted one
+		uint64_t laneWins[2][Lanes::STEP], laneMoves[Lanes::STEP];
+		Lanes::Store(laneWins[0], firstWins);
+		Lanes::Store(laneWins[1], secondWins);
+		Lanes::Store(laneMoves, moves);
+		for (int lane = 0; lane < Lanes::STEP; ++lane)
+		{
+			m_winCounts[0] += (int) laneWins[0][lane];
+			m_winCounts[1] += (int) laneWins[1][lane];
+			m_gameMoves += (int64_t) laneMoves[lane];
+		}
+	}
+
+	// the single word word, over the cells with a head in any of its games
+	void PlayFrontier(int word, int maxMoves)
+	{
+		m_rigid = m_startRigid;
+		for (int i = 0; i < 2; ++i)
+		{
+			m_heads[i][m_startCells[i]] = ~(uint64_t) 0;
+			m_frontiers[i][0] = m_startCells[i];
+			m_frontierCounts[i] = 1;
+		}
+		uint64_t alive = ~(uint64_t) 0;
+
+		const int deltas[4] = { -1, -m_stride, 1, m_stride };
+		int player = m_player;
+		for (int move = 0; move < maxMoves; ++move)
+		{
+			uint64_t* headsPtr = &m_heads[player][0];
+			uint64_t* rigidPtr = &m_rigid[0];
+			uint64_t* nextPtr = &m_next[0];
+			int* frontierPtr = &m_frontiers[player][0];
+			const int frontierCount = m_frontierCounts[player];
+
+			// per game, which neighbours of the head are free
+			uint64_t free[4] = { 0, 0, 0, 0 };
+			for (int i = 0; i < frontierCount; ++i)
+			{
+				int cell = frontierPtr[i];
+				uint64_t head = headsPtr[cell];
+				for (int direction = 0; direction < 4; ++direction) free[direction] |= head & ~rigidPtr[cell + deltas[direction]];
+			}
+
+			// a player without a way out loses; the others pick a direction
+			uint64_t stuck = alive & ~(free[0] | free[1] | free[2] | free[3]);
+			m_winCounts[1 - player] += CountBits(stuck);
+			alive &= ~stuck;
+			if (alive == 0) break;
+			m_gameMoves += CountBits(alive);
+			uint64_t moves[4];
+			ChooseMoves(word, alive, free, moves);
+
+			// every head pushed to the neighbour it moves to; the cells it leaves are cleared, so m_next is all zero again after the swap.
+			// The frontier lists are written without branches: a slot is always written and only counted when it is new
+			++m_stamp;
+			for (int i = 0; i < frontierCount; ++i)
+			{
+				int cell = frontierPtr[i];
+				uint64_t head = headsPtr[cell];
+				for (int direction = 0; direction < 4; ++direction)
+				{
+					nextPtr[cell + deltas[direction]] |= head & moves[direction];
+					m_nextFrontier[i * 4 + direction] = cell + deltas[direction];
+				}
+				headsPtr[cell] = 0;
+			}
+
+			// the new frontier is the targets some head really moved to, and those cells are rigid from now on
+			int nextCount = 0;
+			for (int i = 0; i < frontierCount * 4; ++i)
+			{
+				int cell = m_nextFrontier[i];
+				uint64_t head = nextPtr[cell];
+				rigidPtr[cell] |= head;
+				bool isHead = (head != 0) & (m_stamps[cell] != m_stamp);
+				m_stamps[cell] = isHead ? m_stamp : m_stamps[cell];
+				frontierPtr[nextCount] = cell;
+				nextCount += isHead;
+			}
+			m_frontierCounts[player] = nextCount;
+			m_heads[player].swap(m_next);
+			player = 1 - player;
+		}
+
+		// the heads still standing cleared for the next word
+		for (int i = 0; i < 2; ++i)
+		{
+			for (int j = 0; j < m_frontierCounts[i]; ++j) m_heads[i][m_frontiers[i][j]] = 0;
+		}
+	}
+
+	// a random start direction from two random bits per game, then clockwise to the first free one
+	void ChooseMoves(int word, uint64_t alive, const uint64_t free[4], uint64_t moves[4])
+	{
+		uint64_t low = m_randoms[word].Next(), high = m_randoms[word].Next();
+		uint64_t starts[4] = { ~high & ~low, ~high & low, high & ~low, high & low };
+		uint64_t remaining = alive;
+		for (int direction = 0; direction < 4; ++direction) moves[direction] = 0;
+		for (int turn = 0; turn < 4; ++turn)
+		{
+			for (int start = 0; start < 4; ++start)
+			{
+				int direction = (start + turn) & 3;
+				uint64_t taken = remaining & starts[start] & free[direction];
+				moves[direction] |= taken;
+				remaining &= ~taken;
+			}
+		}
+	}
+
+	// per lane, ifSet where mask is all ones and ifClear where it is 0
+	static Lanes::Type Select(Lanes::Type mask, Lanes::Type ifSet, Lanes::Type ifClear)
+	{
+		return Lanes::Or(Lanes::And(mask, ifSet), Lanes::AndNot(ifClear, mask));
+	}
+
+	static int CountBits(uint64_t bits)
+	{
+		bits = bits - ((bits >> 1) & 0x5555555555555555ULL);
+		bits = (bits & 0x3333333333333333ULL) + ((bits >> 2) & 0x3333333333333333ULL);
+		bits = (bits + (bits >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+		return (int) ((bits * 0x0101010101010101ULL) >> 56);
+	}
+
+	// -------------------------
+	// Datamembers
+	// -------------------------
+	bool m_isBitboard;
+	int m_left, m_top, m_stride, m_boxWidth;
+
+	// bitboard games: a bit per cell of the box
+	uint64_t m_startBoard, m_startHeads[2], m_firstColumn, m_lastColumn;
+
+	// frontier games: a word per cell of the box and its ring, a bit per game of the word being played
+	std::vector<uint64_t> m_startRigid, m_rigid, m_heads[2], m_next;
+	int m_startCells[2];
+	std::vector<int> m_frontiers[2], m_nextFrontier;		// per player the cells with a head in any game, room for every cell
+	int m_frontierCounts[2];
+	std::vector<int> m_stamps;						// the move a cell was last queued for the next frontier
+	int m_stamp;
+
+	Random m_randoms[WORDS];
+	int m_winCounts[2];
+	int m_player;
+	int64_t m_gameMoves;
+
+	// -------------------------
+	// Disabling default copy constructor and default assignment operator.
+	// If you get a linker error from one of these functions, your class is internally trying to use them. This is
+	// an error in your class, these declarations are deliberately made without implementation because they should never be used.
+	// -------------------------
+	BitslicedPlayout(const BitslicedPlayout& bpRef);
+	BitslicedPlayout& operator=(const BitslicedPlayout& bpRef);
+};
+
+typedef BitslicedPlayout<1> Playout64;
+typedef BitslicedPlayout<4> Playout256;
@@ -0,0 +1,28 @@
+//-----------------------------------------------------------------
+// Bot Interface
+// C++ Header - Bot.h - version 2010 v2_07
+//
+// Interface for the strategies that play headless matches (see Match).
+// A bot only sees the arena and the heads of the players, and answers
+// with the index of a direction (left, up, right, down, like DIRECTION).
+//-----------------------------------------------------------------
+
+#pragma once
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#include "ArenaGrid.h"
+#include <stdint.h>
+
+//-----------------------------------------------------------------
+// Bot Class
+//-----------------------------------------------------------------
+class Bot
+{
+public:
+	virtual ~Bot() {}											// virtual destructor for polymorphism
+	virtual const char* GetName() const = 0;
+	virtual void StartMatch(int player, uint64_t seed) {}		// called before the first move, bots that play randomly seed themselves here
+	virtual int ChooseDirection(const ArenaGrid& arenaRef, const CELL* positionsPtr, int player) = 0;	// positionsPtr holds the head of every player
+};
@@ -0,0 +1,130 @@
+//-----------------------------------------------------------------
+// ChunkedArenaGrid Object
+// C++ Source - ChunkedArenaGrid.cpp - version 2010 v2_07
+//-----------------------------------------------------------------
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#include "ChunkedArenaGrid.h"
+
+//-----------------------------------------------------------------
+// ChunkedArenaGrid methods
+//-----------------------------------------------------------------
+ChunkedArenaGrid::ChunkedArenaGrid()
+{
+	Create(0, 0);
+}
+
+ChunkedArenaGrid::ChunkedArenaGrid(int width, int height)
+{
+	Create(width, height);
+}
+
+ChunkedArenaGrid::~ChunkedArenaGrid()
+{
+	// the shared pointers release the chunks
+}
+
+void ChunkedArenaGrid::Create(int width, int height)
+{
+	m_width = width;
+	m_height = height;
+	m_chunksX = (width + 2 + CHUNK_SIZE - 1) >> CHUNK_SHIFT;
+	m_chunksY = (height + 2 + CHUNK_SIZE - 1) >> CHUNK_SHIFT;
+
+	// every chunk starts out as the same shared free chunk
+	std::shared_ptr<Chunk> freeChunkPtr(new Chunk);
+	for (int row = 0; row < CHUNK_SIZE; ++row) freeChunkPtr->rows[row] = 0;
+
+	m_chunkRows.clear();
+	for (int chunkY = 0; chunkY < m_chunksY; ++chunkY)
+	{
+		m_chunkRows.push_back(std::shared_ptr<ChunkRow>(new ChunkRow(m_chunksX, freeChunkPtr)));
+	}
+
+	// the sentinel ring and the padding of the last chunks are rigid
+	int paddedWidth = m_chunksX * CHUNK_SIZE, paddedHeight = m_chunksY * CHUNK_SIZE;
+	for (int py = 0; py < paddedHeight; ++py)
+	{
+		bool isRingRow = py == 0 || py > height;
+		for (int px = 0; px < paddedWidth; ++px)
+		{
+			if (!isRingRow && px == 1) px = width + 1;		// skip the free inside of the row
+			GetWritableChunk(px, py).rows[py & (CHUNK_SIZE - 1)] |= (uint64_t) 1 << (px & (CHUNK_SIZE - 1));
+		}
+	}
+}
+
+void ChunkedArenaGrid::AddWallRing()
+{
+	for (int x = 0; x < m_width; ++x)
+	{
+		SetRigid(x, 0);
+		SetRigid(x, m_height - 1);
+	}
+	for (int y = 0; y < m_height; ++y)
+	{
+		SetRigid(0, y);
+		SetRigid(m_width - 1, y);
+	}
+}
+
+void ChunkedArenaGrid::SetRigid(int x, int y)
+{
+	int px = x + 1, py = y + 1;
+	uint64_t bit = (uint64_t) 1 << (px & (CHUNK_SIZE - 1));
+	if (GetCell(x, y)) return;		// don't unshare a chunk for nothing
+	GetWritableChunk(px, py).rows[py & (CHUNK_SIZE - 1)] |= bit;
+}
+
+void ChunkedArenaGrid::SetFree(int x, int y)
+{
+	int px = x + 1, py = y + 1;
+	uint64_t bit = (uint64_t) 1 << (px & (CHUNK_SIZE - 1));
+	if (!GetCell(x, y)) return;
+	GetWritableChunk(px, py).rows[py & (CHUNK_SIZE - 1)] &= ~bit;
+}
+
+void ChunkedArenaGrid::SetRigidBits(int x, int y, uint64_t bits)
+{
+	// the sentinel ring shifts the cells by one, so the bits usually straddle two chunks
+	int px = x + 1, py = y + 1;
+	int shift = px & (CHUNK_SIZE - 1);
+	uint64_t lowBits = bits << shift;
+	uint64_t highBits = shift == 0 ? 0 : bits >> (CHUNK_SIZE - shift);
+	int row = py & (CHUNK_SIZE - 1);
+
+	// as in SetRigid, chunks that already have these cells rigid stay shared
+	const Chunk& lowChunkRef = *(*m_chunkRows[py >> CHUNK_SHIFT])[px >> CHUNK_SHIFT];
+	if ((lowChunkRef.rows[row] | lowBits) != lowChunkRef.rows[row]) GetWritableChunk(px, py).rows[row] |= lowBits;
+	if (highBits == 0) return;
+	const Chunk& highChunkRef = *(*m_chunkRows[py >> CHUNK_SHIFT])[(px >> CHUNK_SHIFT) + 1];
+	if ((highChunkRef.rows[row] | highBits) != highChunkRef.rows[row]) GetWritableChunk(px + CHUNK_SIZE, py).rows[row] |= highBits;
+}
+
+int ChunkedArenaGrid::CountPrivateChunks() const
+{
+	int count = 0;
+	for (int chunkY = 0; chunkY < m_chunksY; ++chunkY)
+	{
+		const ChunkRow& rowRef = *m_chunkRows[chunkY];
+		for (int chunkX = 0; chunkX < m_chunksX; ++chunkX)
+		{
+			if (m_chunkRows[chunkY].unique() && rowRef[chunkX].unique()) ++count;
+		}
+	}
+	return count;
+}
+
+ChunkedArenaGrid::Chunk& ChunkedArenaGrid::GetWritableChunk(int px, int py)
+{
+	// copy on write, first the row of chunk pointers, then the chunk itself
+	std::shared_ptr<ChunkRow>& rowPtrRef = m_chunkRows[py >> CHUNK_SHIFT];
+	if (!rowPtrRef.unique()) rowPtrRef.reset(new ChunkRow(*rowPtrRef));
+
+	std::shared_ptr<Chunk>& chunkPtrRef = (*rowPtrRef)[px >> CHUNK_SHIFT];
+	if (!chunkPtrRef.unique()) chunkPtrRef.reset(new Chunk(*chunkPtrRef));
+
+	return *chunkPtrRef;
+}
@@ -0,0 +1,111 @@
+//-----------------------------------------------------------------
+// ChunkedArenaGrid Object
+// C++ Header - ChunkedArenaGrid.h - version 2010 v2_07
+//
+// ChunkedArenaGrid answers the same cell queries as ArenaGrid, but keeps
+// the cells as bits in 64x64 chunks that are shared between copies through
+// reference counting. A copy only duplicates the row of chunk pointers and
+// the chunk it writes to, so search trees can keep thousands of arena
+// states alive while paying only for the chunks that changed.
+//-----------------------------------------------------------------
+
+#pragma once
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#include <vector>
+#include <memory>
+#include <stdint.h>
+
+//-----------------------------------------------------------------
+// ChunkedArenaGrid Class
+//-----------------------------------------------------------------
+class ChunkedArenaGrid
+{
+public:
+	static const int CHUNK_SHIFT = 6;
+	static const int CHUNK_SIZE = 1 << CHUNK_SHIFT;		// 64 cells, one uint64_t per chunk row
+
+	//---------------------------
+	// Constructor(s)
+	//---------------------------
+	ChunkedArenaGrid();
+	ChunkedArenaGrid(int width, int height);
+
+	//---------------------------
+	// Destructor
+	//---------------------------
+	~ChunkedArenaGrid();
+
+	//---------------------------
+	// General Methods
+	//---------------------------
+	void Create(int width, int height);		// all cells free, sentinel ring rigid
+	void AddWallRing();
+
+	template<class OtherGrid>
+	void Assign(const OtherGrid& otherRef)	// copies the cells of any arena grid, e.g. the AIchallenge arena
+	{
+		Create(otherRef.GetWidth(), otherRef.GetHeight());
+		for (int y = 0; y < m_height; ++y)
+		{
+			for (int x = 0; x < m_width; ++x)
+			{
+				if (otherRef.IsRigid(x, y)) SetRigid(x, y);
+			}
+		}
+	}
+
+	int GetWidth() const { return m_width; }
+	int GetHeight() const { return m_height; }
+
+	// row-major padded index, for scratch buffers of algorithms like PathFinder
+	int Index(int x, int y) const { return (y + 1) * (m_width + 2) + x + 1; }
+	int GetCellCount() const { return (m_width + 2) * (m_height + 2); }
+
+	// x and y may be anything from -1 up to and including width/height: the sentinel ring is addressable
+	int GetCell(int x, int y) const
+	{
+		int px = x + 1, py = y + 1;
+		const Chunk& chunkRef = *(*m_chunkRows[py >> CHUNK_SHIFT])[px >> CHUNK_SHIFT];
+		return (int) ((chunkRef.rows[py & (CHUNK_SIZE - 1)] >> (px & (CHUNK_SIZE - 1))) & 1);
+	}
+	bool IsRigid(int x, int y) const { return GetCell(x, y) != 0; }
+	void SetRigid(int x, int y);
+	void SetFree(int x, int y);
+	void SetRigidBits(int x, int y, uint64_t bits);	// bit i set makes cell (x + i, y) rigid, a whole row word at a time
+
+	int CountRigidNeighbours(int x, int y) const
+	{
+		return GetCell(x - 1, y) + GetCell(x, y - 1) + GetCell(x + 1, y) + GetCell(x, y + 1);
+	}
+	bool IsImmobilised(int x, int y) const { return CountRigidNeighbours(x, y) == 4; }
+
+	int GetChunkCount() const { return m_chunksX * m_chunksY; }
+	int CountPrivateChunks() const;			// chunks this grid doesn't share with any other copy
+
+	// copying is cheap on purpose: the copy shares every chunk until one of the two writes to it
+
+private:
+	// -------------------------
+	// Internal structs
+	// -------------------------
+	struct Chunk
+	{
+		uint64_t rows[CHUNK_SIZE];
+	};
+	typedef std::vector<std::shared_ptr<Chunk> > ChunkRow;
+
+	// -------------------------
+	// Member functions
+	// -------------------------
+	Chunk& GetWritableChunk(int px, int py);
+
+	// -------------------------
+	// Datamembers
+	// -------------------------
+	int m_width, m_height;
+	int m_chunksX, m_chunksY;
+	std::vector<std::shared_ptr<ChunkRow> > m_chunkRows;
+};
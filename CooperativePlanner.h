@@ -0,0 +1,306 @@
+//-----------------------------------------------------------------
+// CooperativePlanner Object
+// C++ Header - CooperativePlanner.h - version 2010 v2_07
+//
+// CooperativePlanner gives a group of agents paths that don't run into
+// each other, with windowed hierarchical cooperative A* (WHCA*, Silver).
+// The agents are planned one after the other with a space-time A* over
+// (x, y, tick), limited to a window of ticks, and every planned path is
+// written into a hashed reservation table that the later agents plan
+// around. Replanning every tick (or every few ticks) with a fresh window
+// keeps the agents moving towards their goals.
+// In trail mode, the rule of this game, agents can't stand still and a
+// cell stays rigid from the tick an agent enters it, so a reservation
+// blocks the cell for the whole window instead of for one tick: whoever
+// would come later runs into the trail of the other. Not even the goal
+// is a place to stop, so every path runs to the end of the window and
+// ends as close to the goal as the trails allow.
+//-----------------------------------------------------------------
+
+#pragma once
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#include "ArenaGrid.h"
+#include "SpaceTimeTable.h"
+#include <vector>
+#include <algorithm>
+#include <stdlib.h>
+
+//-----------------------------------------------------------------
+// CooperativePlanner Class
+//-----------------------------------------------------------------
+template<class Grid>
+class CooperativePlanner
+{
+public:
+	static const int EXPANSIONS_PER_WINDOW_TICK = 64;	// search budget per agent, relative to the window
+
+	//---------------------------
+	// Constructor(s)
+	//---------------------------
+	CooperativePlanner() : m_gridPtr(NULL), m_window(16), m_leavesTrail(true), m_expandedNodes(0)
+	{
+	}
+
+	//---------------------------
+	// Destructor
+	//---------------------------
+	virtual ~CooperativePlanner()
+	{
+	}
+
+	//---------------------------
+	// General Methods
+	//---------------------------
+
+	// the grid has to outlive the planner; window is the number of ticks every agent plans ahead
+	void Initialize(const Grid& gridRef, int window = 16, bool leavesTrail = true)
+	{
+		m_gridPtr = &gridRef;
+		m_window = window;
+		m_leavesTrail = leavesTrail;
+	}
+
+	// plans all agents in the given order (the first one has the highest priority),
+	// every path starts with the start cell and holds at most window + 1 cells;
+	// returns the number of agents that reach their goal (only without trails) or the end of the window
+	int PlanAll(const std::vector<CELL>& startsRef, const std::vector<CELL>& goalsRef, std::vector<std::vector<CELL> >* pathsPtr)
+	{
+		m_reservations.Clear();
+		m_trails.Clear();
+		m_expandedNodes = 0;
+
+		// nobody may plan through a cell that is still occupied at the start
+		for (int agent = 0; agent < (int) startsRef.size(); ++agent)
+		{
+			Reserve(agent, startsRef[agent].x, startsRef[agent].y, 0);
+		}
+
+		pathsPtr->resize(startsRef.size());
+		int plannedAgents = 0;
+		for (int agent = 0; agent < (int) startsRef.size(); ++agent)
+		{
+			std::vector<CELL>& pathRef = (*pathsPtr)[agent];
+			if (PlanAgent(agent, startsRef[agent], goalsRef[agent], &pathRef)) ++plannedAgents;
+			for (int tick = 1; tick < (int) pathRef.size(); ++tick)
+			{
+				Reserve(agent, pathRef[tick].x, pathRef[tick].y, tick);
+			}
+			if (!m_leavesTrail)
+			{
+				// the agent waits at the end of its path for the rest of the window
+				const CELL& lastRef = pathRef.back();
+				for (int tick = (int) pathRef.size(); tick <= m_window; ++tick)
+				{
+					Reserve(agent, lastRef.x, lastRef.y, tick);
+				}
+			}
+		}
+		return plannedAgents;
+	}
+
+	// counts the pairs of moves in the paths that would collide: two agents in one cell at the same tick,
+	// two agents swapping cells, and in trail mode an agent entering a cell that was entered before
+	int CountConflicts(const std::vector<std::vector<CELL> >& pathsRef) const
+	{
+		SpaceTimeTable occupants, firstEntries;
+		for (int agent = 0; agent < (int) pathsRef.size(); ++agent)
+		{
+			const std::vector<CELL>& pathRef = pathsRef[agent];
+			for (int tick = 0; tick < (int) pathRef.size(); ++tick)
+			{
+				occupants.Set(pathRef[tick].x, pathRef[tick].y, tick, agent);
+				int firstTick = firstEntries.Get(pathRef[tick].x, pathRef[tick].y, 0);
+				if (firstTick == SpaceTimeTable::NOT_FOUND || tick < firstTick) firstEntries.Set(pathRef[tick].x, pathRef[tick].y, 0, tick);
+			}
+		}
+
+		int conflicts = 0;
+		for (int agent = 0; agent < (int) pathsRef.size(); ++agent)
+		{
+			const std::vector<CELL>& pathRef = pathsRef[agent];
+			for (int tick = 0; tick < (int) pathRef.size(); ++tick)
+			{
+				int x = pathRef[tick].x, y = pathRef[tick].y;
+				if (occupants.Get(x, y, tick) != agent) ++conflicts;
+				if (m_leavesTrail && firstEntries.Get(x, y, 0) < tick) ++conflicts;
+				if (!m_leavesTrail && tick > 0)
+				{
+					int other = occupants.Get(x, y, tick - 1);
+					if (other != SpaceTimeTable::NOT_FOUND && other != agent && occupants.Get(pathRef[tick - 1].x, pathRef[tick - 1].y, tick) == other) ++conflicts;
+				}
+			}
+		}
+		return conflicts;
+	}
+
+	int GetExpandedNodeCount() const { return m_expandedNodes; }
+	int GetReservationCount() const { return m_reservations.GetCount(); }
+
+private:
+	// -------------------------
+	// Internal structs
+	// -------------------------
+	struct SearchNode
+	{
+		int x, y, tick;
+		int parent;
+	};
+
+	struct OpenNode
+	{
+		int f, h;
+		int node;
+		// the open list is a max heap, so the comparison is reversed; ties go to the node closest to the goal
+		bool operator<(const OpenNode& otherRef) const
+		{
+			if (f != otherRef.f) return f > otherRef.f;
+			return h > otherRef.h;
+		}
+	};
+
+	// -------------------------
+	// Member functions
+	// -------------------------
+	static int Heuristic(int x1, int y1, int x2, int y2)
+	{
+		return abs(x1 - x2) + abs(y1 - y2);
+	}
+
+	void Reserve(int agent, int x, int y, int tick)
+	{
+		m_reservations.Set(x, y, tick, agent);
+		if (m_leavesTrail) m_trails.Set(x, y, 0, agent);
+	}
+
+	// true when the agent may not move from one cell into the next one, arriving there at the given tick
+	bool IsBlocked(int agent, int fromX, int fromY, int x, int y, int tick) const
+	{
+		if (m_gridPtr->IsRigid(x, y)) return true;
+
+		if (m_leavesTrail) return m_trails.Contains(x, y, 0);
+
+		int occupant = m_reservations.Get(x, y, tick);
+		if (occupant != SpaceTimeTable::NOT_FOUND && occupant != agent) return true;
+
+		// two agents can't swap cells
+		int previousOccupant = m_reservations.Get(x, y, tick - 1);
+		return previousOccupant != SpaceTimeTable::NOT_FOUND && previousOccupant != agent && m_reservations.Get(fromX, fromY, tick) == previousOccupant;
+	}
+
+	// in trail mode an agent can't cross its own path either
+	bool IsOnOwnPath(int node, int x, int y) const
+	{
+		for (; node >= 0; node = m_nodes[node].parent)
+		{
+			if (m_nodes[node].x == x && m_nodes[node].y == y) return true;
+		}
+		return false;
+	}
+
+	// an agent that reaches its goal early has to be able to stay there, which in trail mode it never can
+	bool CanStayUntilWindowEnd(int agent, int x, int y, int tick) const
+	{
+		if (m_leavesTrail) return false;
+		for (; tick <= m_window; ++tick)
+		{
+			int occupant = m_reservations.Get(x, y, tick);
+			if (occupant != SpaceTimeTable::NOT_FOUND && occupant != agent) return false;
+		}
+		return true;
+	}
+
+	bool PlanAgent(int agent, const CELL& startRef, const CELL& goalRef, std::vector<CELL>* pathPtr)
+	{
+		m_nodes.clear();
+		m_open.clear();
+		m_visited.Clear();
+
+		SearchNode startNode = { startRef.x, startRef.y, 0, -1 };
+		m_nodes.push_back(startNode);
+		m_visited.Set(startRef.x, startRef.y, 0, 0);
+		int startH = Heuristic(startRef.x, startRef.y, goalRef.x, goalRef.y);
+		OpenNode openNode = { startH, startH, 0 };
+		m_open.push_back(openNode);
+
+		// when the search runs out of budget or room, the agent takes the deepest node closest to the goal
+		int resultNode = -1, fallbackNode = 0, fallbackH = startH;
+		int expansionLimit = EXPANSIONS_PER_WINDOW_TICK * m_window;
+		int actions = m_leavesTrail ? 4 : 5;
+		for (int expansions = 0; !m_open.empty() && expansions < expansionLimit; ++expansions)
+		{
+			OpenNode top = m_open.front();
+			std::pop_heap(m_open.begin(), m_open.end());
+			m_open.pop_back();
+
+			SearchNode node = m_nodes[top.node];
+			if (node.tick == m_window || (top.h == 0 && CanStayUntilWindowEnd(agent, node.x, node.y, node.tick)))
+			{
+				resultNode = top.node;
+				break;
+			}
+			if (node.tick > m_nodes[fallbackNode].tick || (node.tick == m_nodes[fallbackNode].tick && top.h < fallbackH))
+			{
+				fallbackNode = top.node;
+				fallbackH = top.h;
+			}
+			++m_expandedNodes;
+
+			for (int action = 0; action < actions; ++action)
+			{
+				// actions 0 to 3 follow DIRECTION, action 4 waits
+				int x = node.x, y = node.y, tick = node.tick + 1;
+				if (action < 4)
+				{
+					x += DIRECTION_DX[action];
+					y += DIRECTION_DY[action];
+				}
+				if (m_visited.Contains(x, y, tick) || IsBlocked(agent, node.x, node.y, x, y, tick)) continue;
+				if (m_leavesTrail && IsOnOwnPath(top.node, x, y)) continue;
+
+				SearchNode child = { x, y, tick, top.node };
+				m_visited.Set(x, y, tick, (int) m_nodes.size());
+				m_nodes.push_back(child);
+
+				OpenNode childOpenNode;
+				childOpenNode.h = Heuristic(x, y, goalRef.x, goalRef.y);
+				childOpenNode.f = tick + childOpenNode.h;
+				childOpenNode.node = (int) m_nodes.size() - 1;
+				m_open.push_back(childOpenNode);
+				std::push_heap(m_open.begin(), m_open.end());
+			}
+		}
+
+		int node = resultNode >= 0 ? resultNode : fallbackNode;
+		pathPtr->resize(m_nodes[node].tick + 1);
+		for (; node >= 0; node = m_nodes[node].parent)
+		{
+			CELL cell = { m_nodes[node].x, m_nodes[node].y };
+			(*pathPtr)[m_nodes[node].tick] = cell;
+		}
+		return resultNode >= 0;
+	}
+
+	// -------------------------
+	// Datamembers
+	// -------------------------
+	const Grid* m_gridPtr;
+	int m_window;
+	bool m_leavesTrail;
+	int m_expandedNodes;
+	SpaceTimeTable m_reservations;		// (x, y, tick) -> agent
+	SpaceTimeTable m_trails;			// (x, y, 0) -> agent that leaves a trail in the cell, trail mode only
+	SpaceTimeTable m_visited;			// (x, y, tick) -> search node of the agent being planned
+	std::vector<SearchNode> m_nodes;
+	std::vector<OpenNode> m_open;
+
+	// -------------------------
+	// Disabling default copy constructor and default assignment operator.
+	// If you get a linker error from one of these functions, your class is internally trying to use them. This is
+	// an error in your class, these declarations are deliberately made without implementation because they should never be used.
+	// -------------------------
+	CooperativePlanner(const CooperativePlanner& cpRef);
+	CooperativePlanner& operator=(const CooperativePlanner& cpRef);
+};
@@ -0,0 +1,113 @@
+//-----------------------------------------------------------------
+// CostMap Object
+// C++ Header - CostMap.h - version 2010 v2_07
+//
+// CostMap adds a traversal cost to every cell of an arena grid, one byte
+// per cell in the same layout as the grid. Entering a cell costs one
+// step plus its extra cost, so bots can prefer paths that keep away from
+// the heads of the opponents or from walls. The rigid cells stay in the
+// grid itself.
+//-----------------------------------------------------------------
+
+#pragma once
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#include "ArenaGrid.h"
+#include <vector>
+#include <algorithm>
+#include <stdlib.h>
+
+//-----------------------------------------------------------------
+// CostMap Class
+//-----------------------------------------------------------------
+template<class Grid>
+class CostMap
+{
+public:
+	static const int MAX_COST = 255;
+
+	//---------------------------
+	// Constructor(s)
+	//---------------------------
+	CostMap() : m_gridPtr(NULL)
+	{
+	}
+
+	//---------------------------
+	// Destructor
+	//---------------------------
+	virtual ~CostMap()
+	{
+	}
+
+	//---------------------------
+	// General Methods
+	//---------------------------
+
+	// the grid has to outlive the cost map, all extra costs start at 0
+	void Initialize(const Grid& gridRef)
+	{
+		m_gridPtr = &gridRef;
+		m_costs.assign(gridRef.GetCellCount(), 0);
+	}
+
+	void Clear()
+	{
+		std::fill(m_costs.begin(), m_costs.end(), 0);
+	}
+
+	int GetCost(int x, int y) const { return m_costs[m_gridPtr->Index(x, y)]; }
+	int GetStepCost(int x, int y) const { return 1 + m_costs[m_gridPtr->Index(x, y)]; }	// the cost of entering the cell
+	int GetStepCostAt(int index) const { return 1 + m_costs[index]; }						// index as given by the grid
+	void SetCost(int x, int y, int cost) { m_costs[m_gridPtr->Index(x, y)] = (unsigned char) std::min(std::max(cost, 0), (int) MAX_COST); }
+
+	// adds to the cost of a cell, stopping at MAX_COST
+	void AddCost(int x, int y, int cost)
+	{
+		unsigned char& costRef = m_costs[m_gridPtr->Index(x, y)];
+		costRef = (unsigned char) std::min((int) costRef + cost, (int) MAX_COST);
+	}
+
+	// a diamond of danger around a cell, e.g. an opponent's head: peak in the centre, falling off to 0 beyond radius
+	void AddDanger(int centreX, int centreY, int radius, int peak)
+	{
+		for (int y = std::max(centreY - radius, 0); y <= std::min(centreY + radius, m_gridPtr->GetHeight() - 1); ++y)
+		{
+			int rest = radius - abs(y - centreY);
+			for (int x = std::max(centreX - rest, 0); x <= std::min(centreX + rest, m_gridPtr->GetWidth() - 1); ++x)
+			{
+				int distance = abs(x - centreX) + abs(y - centreY);
+				AddCost(x, y, peak * (radius + 1 - distance) / (radius + 1));
+			}
+		}
+	}
+
+	// every free cell next to a rigid one gets the extra cost
+	void AddWallProximity(int cost)
+	{
+		for (int y = 0; y < m_gridPtr->GetHeight(); ++y)
+		{
+			for (int x = 0; x < m_gridPtr->GetWidth(); ++x)
+			{
+				if (!m_gridPtr->IsRigid(x, y) && m_gridPtr->CountRigidNeighbours(x, y) > 0) AddCost(x, y, cost);
+			}
+		}
+	}
+
+private:
+	// -------------------------
+	// Datamembers
+	// -------------------------
+	const Grid* m_gridPtr;
+	std::vector<unsigned char> m_costs;
+
+	// -------------------------
+	// Disabling default copy constructor and default assignment operator.
+	// If you get a linker error from one of these functions, your class is internally trying to use them. This is
+	// an error in your class, these declarations are deliberately made without implementation because they should never be used.
+	// -------------------------
+	CostMap(const CostMap& cmRef);
+	CostMap& operator=(const CostMap& cmRef);
+};
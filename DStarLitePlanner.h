@@ -0,0 +1,300 @@
+//-----------------------------------------------------------------
+// DStarLitePlanner Object
+// C++ Header - DStarLitePlanner.h - version 2010 v2_07
+//
+// DStarLitePlanner plans a path from an agent to a fixed goal and keeps it
+// valid while the arena changes, following D* Lite (Koenig & Likhachev).
+// The search runs backwards from the goal, so when the agent moves and
+// cells become rigid only the part of the search tree that depended on
+// those cells is repaired, instead of running a fresh A* every tick.
+//-----------------------------------------------------------------
+
+#pragma once
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#include "ArenaGrid.h"
+#include "RigidCellListener.h"
+#include <vector>
+#include <algorithm>
+#include <stdlib.h>
+
+//-----------------------------------------------------------------
+// DStarLitePlanner Class
+//-----------------------------------------------------------------
+template<class Grid>
+class DStarLitePlanner : public RigidCellListener
+{
+public:
+	static const int UNREACHABLE = 0x3fffffff;
+
+	//---------------------------
+	// Constructor(s)
+	//---------------------------
+	DStarLitePlanner() : m_gridPtr(NULL), m_startX(0), m_startY(0), m_goalX(0), m_goalY(0), m_km(0), m_expandedCells(0)
+	{
+	}
+
+	//---------------------------
+	// Destructor
+	//---------------------------
+	virtual ~DStarLitePlanner()
+	{
+	}
+
+	//---------------------------
+	// General Methods
+	//---------------------------
+
+	// the grid has to outlive the planner, and every new rigid cell has to be reported
+	void Initialize(const Grid& gridRef, int startX, int startY, int goalX, int goalY)
+	{
+		m_gridPtr = &gridRef;
+		m_g.assign(gridRef.GetCellCount(), (int) UNREACHABLE);
+		m_rhs.assign(gridRef.GetCellCount(), (int) UNREACHABLE);
+		m_open.clear();
+		m_km = 0;
+		m_startX = startX;
+		m_startY = startY;
+		m_goalX = goalX;
+		m_goalY = goalY;
+
+		m_rhs[gridRef.Index(goalX, goalY)] = 0;
+		Push(goalX, goalY);
+	}
+
+	// call when the agent has moved, before Replan()
+	void UpdateStart(int x, int y)
+	{
+		// queued keys must never be larger than their current key, so km grows with every step of the start
+		int oldX = m_startX, oldY = m_startY;
+		m_km += Heuristic(oldX, oldY, x, y);
+		m_startX = x;
+		m_startY = y;
+
+		// a rigid cell only leads anywhere while it is the start
+		UpdateCell(oldX, oldY);
+		UpdateCell(x, y);
+	}
+
+	void CellBecameRigid(int x, int y)
+	{
+		UpdateCell(x, y);
+		for (int direction = 0; direction < 4; ++direction)
+		{
+			UpdateCell(x + DIRECTION_DX[direction], y + DIRECTION_DY[direction]);
+		}
+	}
+
+	// repairs the search tree, returns the path length from the start or UNREACHABLE
+	int Replan()
+	{
+		m_expandedCells = 0;
+		int startIndex = m_gridPtr->Index(m_startX, m_startY);
+		while (!m_open.empty())
+		{
+			Key topKey;
+			if (!PeekTop(&topKey)) break;
+			Key startKey = CalculateKey(m_startX, m_startY);
+			if (!(topKey < startKey) && m_rhs[startIndex] == m_g[startIndex]) break;
+
+			OpenNode node = m_open.front();
+			std::pop_heap(m_open.begin(), m_open.end());
+			m_open.pop_back();
+
+			int index = m_gridPtr->Index(node.x, node.y);
+			Key newKey = CalculateKey(node.x, node.y);
+			if (node.key < newKey)
+			{
+				// the key grew since it was queued (the start moved)
+				Push(node.x, node.y);
+			}
+			else if (m_g[index] > m_rhs[index])
+			{
+				m_g[index] = m_rhs[index];
+				UpdateNeighbours(node.x, node.y);
+			}
+			else
+			{
+				m_g[index] = UNREACHABLE;
+				UpdateCell(node.x, node.y);
+				UpdateNeighbours(node.x, node.y);
+			}
+			++m_expandedCells;
+		}
+		return std::min(m_rhs[startIndex], (int) UNREACHABLE);
+	}
+
+	// direction (like DIRECTION) of the next step on the planned path, -1 when the goal can't be reached
+	int GetNextDirection() const
+	{
+		int bestDirection = -1, bestDistance = UNREACHABLE;
+		for (int direction = 0; direction < 4; ++direction)
+		{
+			int x = m_startX + DIRECTION_DX[direction], y = m_startY + DIRECTION_DY[direction];
+			if (m_gridPtr->IsRigid(x, y)) continue;
+			int distance = m_g[m_gridPtr->Index(x, y)];
+			if (distance < bestDistance)
+			{
+				bestDistance = distance;
+				bestDirection = direction;
+			}
+		}
+		return bestDirection;
+	}
+
+	// follows the planned path from the start to the goal, start and goal included
+	bool GetPath(std::vector<CELL>* pathPtr) const
+	{
+		pathPtr->clear();
+		int x = m_startX, y = m_startY;
+		if (m_rhs[m_gridPtr->Index(x, y)] >= UNREACHABLE) return false;
+
+		CELL cell = { x, y };
+		pathPtr->push_back(cell);
+		while (x != m_goalX || y != m_goalY)
+		{
+			int bestDirection = -1, bestDistance = m_g[m_gridPtr->Index(x, y)];
+			if (x == m_startX && y == m_startY) bestDistance = m_rhs[m_gridPtr->Index(x, y)];
+			for (int direction = 0; direction < 4; ++direction)
+			{
+				int neighbourX = x + DIRECTION_DX[direction], neighbourY = y + DIRECTION_DY[direction];
+				if (m_gridPtr->IsRigid(neighbourX, neighbourY)) continue;
+				if (m_g[m_gridPtr->Index(neighbourX, neighbourY)] + 1 == bestDistance)
+				{
+					bestDirection = direction;
+					break;
+				}
+			}
+			if (bestDirection < 0) return false;
+			x += DIRECTION_DX[bestDirection];
+			y += DIRECTION_DY[bestDirection];
+			cell.x = x;
+			cell.y = y;
+			pathPtr->push_back(cell);
+		}
+		return true;
+	}
+
+	int GetExpandedCellCount() const { return m_expandedCells; }
+
+private:
+	// -------------------------
+	// Internal structs
+	// -------------------------
+	struct Key
+	{
+		int primary, secondary;
+		bool operator<(const Key& otherRef) const
+		{
+			if (primary != otherRef.primary) return primary < otherRef.primary;
+			return secondary < otherRef.secondary;
+		}
+	};
+
+	struct OpenNode
+	{
+		Key key;
+		int x, y;
+		// the open list is a max heap, so the comparison is reversed
+		bool operator<(const OpenNode& otherRef) const { return otherRef.key < key; }
+	};
+
+	// -------------------------
+	// Member functions
+	// -------------------------
+	static int Heuristic(int x1, int y1, int x2, int y2)
+	{
+		return abs(x1 - x2) + abs(y1 - y2);
+	}
+
+	Key CalculateKey(int x, int y) const
+	{
+		int index = m_gridPtr->Index(x, y);
+		Key key;
+		key.secondary = std::min(m_g[index], m_rhs[index]);
+		key.primary = key.secondary + Heuristic(m_startX, m_startY, x, y) + m_km;
+		return key;
+	}
+
+	void Push(int x, int y)
+	{
+		OpenNode node;
+		node.key = CalculateKey(x, y);
+		node.x = x;
+		node.y = y;
+		m_open.push_back(node);
+		std::push_heap(m_open.begin(), m_open.end());
+	}
+
+	// drops queue entries of consistent cells and entries overtaken by a newer one
+	bool PeekTop(Key* keyPtr)
+	{
+		while (!m_open.empty())
+		{
+			const OpenNode& topRef = m_open.front();
+			int index = m_gridPtr->Index(topRef.x, topRef.y);
+			if (m_g[index] != m_rhs[index] && !(CalculateKey(topRef.x, topRef.y) < topRef.key))
+			{
+				*keyPtr = topRef.key;
+				return true;
+			}
+			std::pop_heap(m_open.begin(), m_open.end());
+			m_open.pop_back();
+		}
+		return false;
+	}
+
+	void UpdateNeighbours(int x, int y)
+	{
+		for (int direction = 0; direction < 4; ++direction)
+		{
+			UpdateCell(x + DIRECTION_DX[direction], y + DIRECTION_DY[direction]);
+		}
+	}
+
+	void UpdateCell(int x, int y)
+	{
+		int index = m_gridPtr->Index(x, y);
+		if (x != m_goalX || y != m_goalY)
+		{
+			// the start is the agent's head, which is rigid in the game, but it still leaves through its free neighbours
+			int rhs = UNREACHABLE;
+			if (!m_gridPtr->IsRigid(x, y) || (x == m_startX && y == m_startY))
+			{
+				for (int direction = 0; direction < 4; ++direction)
+				{
+					int neighbourX = x + DIRECTION_DX[direction], neighbourY = y + DIRECTION_DY[direction];
+					if (m_gridPtr->IsRigid(neighbourX, neighbourY)) continue;
+					rhs = std::min(rhs, m_g[m_gridPtr->Index(neighbourX, neighbourY)] + 1);
+				}
+			}
+			m_rhs[index] = std::min(rhs, (int) UNREACHABLE);
+		}
+		else if (m_gridPtr->IsRigid(x, y))
+		{
+			m_rhs[index] = UNREACHABLE;
+		}
+		if (m_g[index] != m_rhs[index]) Push(x, y);
+	}
+
+	// -------------------------
+	// Datamembers
+	// -------------------------
+	const Grid* m_gridPtr;
+	int m_startX, m_startY;
+	int m_goalX, m_goalY;
+	int m_km;						// key modifier, grows as the start moves
+	std::vector<int> m_g, m_rhs;
+	std::vector<OpenNode> m_open;
+	int m_expandedCells;
+
+	// -------------------------
+	// Disabling default copy constructor and default assignment operator.
+	// If you get a linker error from one of these functions, your class is internally trying to use them. This is
+	// an error in your class, these declarations are deliberately made without implementation because they should never be used.
+	// -------------------------
+	DStarLitePlanner(const DStarLitePlanner& dsRef);
+	DStarLitePlanner& operator=(const DStarLitePlanner& dsRef);
+};
@@ -0,0 +1,389 @@
+//-----------------------------------------------------------------
+// DistanceField Object
+// C++ Header - DistanceField.h - version 2010 v2_07
+//
+// DistanceField keeps the distance from a source cell (a player) to every
+// cell of the arena up to date while cells become rigid and the source
+// moves. It is a dynamic single source shortest path in the style of LPA*:
+// every cell has a distance g and a one step lookahead rhs, changes only
+// put the cells next to them in a bucket queue, and the queue is worked
+// off lazily: a distance query settles the queued cells up to the asked for
+// distance and leaves the rest for later. Only the cells whose distance
+// really changes are touched.
+// Moving the source re-roots the field. A step to a neighbouring cell
+// changes every distance by exactly one, as the grid is bipartite: all of
+// them grow by one in a single pass, and only the cells with a shortest
+// path through the new source are walked to take two off again. When the
+// old source is rigid, the cells only it carried lose their distance and
+// take a new one from the cells around them. Any other source move goes
+// through the queue: the old source loses its fixed distance of zero and
+// the new one gets it.
+// The source itself may be rigid, as the head of a player always is.
+//-----------------------------------------------------------------
+
+#pragma once
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#include "ArenaGrid.h"
+#include "RigidCellListener.h"
+#include <vector>
+#include <algorithm>
+#include <stdlib.h>
+
+//-----------------------------------------------------------------
+// DistanceField Class
+//-----------------------------------------------------------------
+template<class Grid>
+class DistanceField : public RigidCellListener
+{
+public:
+	static const int UNREACHABLE = 0x3fffffff;
+
+	//---------------------------
+	// Constructor(s)
+	//---------------------------
+	DistanceField() : m_gridPtr(NULL), m_sourceX(0), m_sourceY(0), m_currentKey(0), m_isDirty(false), m_mustRebuild(false), m_updatedCells(0)
+	{
+	}
+
+	//---------------------------
+	// Destructor
+	//---------------------------
+	virtual ~DistanceField()
+	{
+	}
+
+	//---------------------------
+	// General Methods
+	//---------------------------
+
+	// the grid has to outlive the field, and every change to it has to be reported
+	void Initialize(const Grid& gridRef, int sourceX, int sourceY)
+	{
+		m_gridPtr = &gridRef;
+		m_g.assign(gridRef.GetCellCount(), (int) UNREACHABLE);
+		m_rhs.assign(gridRef.GetCellCount(), (int) UNREACHABLE);
+		m_buckets.clear();
+		m_currentKey = 0;
+		m_sourceX = sourceX;
+		m_sourceY = sourceY;
+		m_mustRebuild = true;
+		m_isDirty = true;
+	}
+
+	void SetSource(int x, int y)
+	{
+		if (x == m_sourceX && y == m_sourceY) return;
+		int oldX = m_sourceX, oldY = m_sourceY;
+		bool isStep = !m_mustRebuild && abs(x - oldX) + abs(y - oldY) == 1 && !m_gridPtr->IsRigid(x, y);
+
+		// a step needs settled distances around the old source, what is still queued is mostly a trail cell or two
+		if (isStep && m_isDirty) Settle(-1);
+		m_sourceX = x;
+		m_sourceY = y;
+		if (m_mustRebuild) return;
+		if (isStep)
+		{
+			StepSource(oldX, oldY, x, y);
+			return;
+		}
+
+		// a rigid old source stops passing its distance on, and a rigid new source starts to
+		UpdateCell(oldX, oldY);
+		UpdateNeighbours(oldX, oldY);
+		UpdateCell(x, y);
+		UpdateNeighbours(x, y);
+	}
+
+	void CellBecameRigid(int x, int y)
+	{
+		if (m_mustRebuild) return;
+		UpdateCell(x, y);
+		UpdateNeighbours(x, y);
+	}
+
+	void CellBecameFree(int x, int y)
+	{
+		if (m_mustRebuild) return;
+		UpdateCell(x, y);
+	}
+
+	// works off the queued changes, returns the number of cells that were (re)settled
+	int Update()
+	{
+		return Settle(-1);
+	}
+
+	// settles only the part of the queue the asked for cell depends on, the cells farther away wait for a later query
+	int GetDistance(int x, int y)
+	{
+		int index = m_gridPtr->Index(x, y);
+		if (m_isDirty) Settle(index);
+		return m_g[index];
+	}
+
+	int GetSourceX() const { return m_sourceX; }
+	int GetSourceY() const { return m_sourceY; }
+	int GetUpdatedCellCount() const { return m_updatedCells; }
+
+private:
+	// -------------------------
+	// Member functions
+	// -------------------------
+
+	// works off the queue in key order; with a target cell it stops once no queued cell can still change that cell
+	int Settle(int targetIndex)
+	{
+		if (m_mustRebuild) return Rebuild();
+
+		m_updatedCells = 0;
+		while (m_currentKey < (int) m_buckets.size())
+		{
+			if (targetIndex >= 0 && m_g[targetIndex] == m_rhs[targetIndex] && m_currentKey >= m_g[targetIndex]) return m_updatedCells;
+
+			std::vector<CELL>& bucketRef = m_buckets[m_currentKey];
+			if (bucketRef.empty())
+			{
+				++m_currentKey;
+				continue;
+			}
+			CELL cell = bucketRef.back();
+			bucketRef.pop_back();
+
+			int index = m_gridPtr->Index(cell.x, cell.y);
+			int g = m_g[index], rhs = m_rhs[index];
+			if (g == rhs || std::min(g, rhs) != m_currentKey) continue;	// outdated queue entry
+
+			if (g > rhs)
+			{
+				// the cell came closer: settle it
+				m_g[index] = rhs;
+			}
+			else
+			{
+				// the cell moved away: forget its distance and let the neighbours offer a new one
+				m_g[index] = UNREACHABLE;
+				UpdateCell(cell.x, cell.y);
+			}
+			UpdateNeighbours(cell.x, cell.y);
+			++m_updatedCells;
+		}
+		m_currentKey = 0;
+		m_isDirty = false;
+		return m_updatedCells;
+	}
+
+	int Rebuild()
+	{
+		std::fill(m_g.begin(), m_g.end(), (int) UNREACHABLE);
+		std::fill(m_rhs.begin(), m_rhs.end(), (int) UNREACHABLE);
+		for (size_t key = 0; key < m_buckets.size(); ++key)
+		{
+			m_buckets[key].clear();
+		}
+
+		m_queue.clear();
+		int sourceIndex = m_gridPtr->Index(m_sourceX, m_sourceY);
+		m_g[sourceIndex] = m_rhs[sourceIndex] = 0;
+		CELL source = { m_sourceX, m_sourceY };
+		m_queue.push_back(source);
+		for (size_t head = 0; head < m_queue.size(); ++head)
+		{
+			CELL cell = m_queue[head];
+			int distance = m_g[m_gridPtr->Index(cell.x, cell.y)] + 1;
+			for (int direction = 0; direction < 4; ++direction)
+			{
+				CELL neighbour = { cell.x + DIRECTION_DX[direction], cell.y + DIRECTION_DY[direction] };
+				int index = m_gridPtr->Index(neighbour.x, neighbour.y);
+				if (m_g[index] != UNREACHABLE || m_gridPtr->IsRigid(neighbour.x, neighbour.y)) continue;
+				m_g[index] = m_rhs[index] = distance;
+				m_queue.push_back(neighbour);
+			}
+		}
+
+		m_currentKey = 0;
+		m_isDirty = false;
+		m_mustRebuild = false;
+		m_updatedCells = (int) m_queue.size();
+		return m_updatedCells;
+	}
+
+	// the source moved to a free neighbour of the old one: every distance grows by one, except for the
+	// cells behind the new source on a shortest path, which come one closer
+	void StepSource(int oldX, int oldY, int x, int y)
+	{
+		for (size_t index = 0; index < m_g.size(); ++index)
+		{
+			if (m_g[index] != UNREACHABLE) m_rhs[index] = ++m_g[index];
+		}
+
+		// a neighbour is behind a walked cell when it used to be one step farther away; walking it takes off two
+		m_queue.clear();
+		int sourceIndex = m_gridPtr->Index(x, y);
+		m_g[sourceIndex] = m_rhs[sourceIndex] = 0;
+		CELL source = { x, y };
+		m_queue.push_back(source);
+		for (size_t head = 0; head < m_queue.size(); ++head)
+		{
+			CELL cell = m_queue[head];
+			int behind = m_g[m_gridPtr->Index(cell.x, cell.y)] + 3;
+			for (int direction = 0; direction < 4; ++direction)
+			{
+				CELL neighbour = { cell.x + DIRECTION_DX[direction], cell.y + DIRECTION_DY[direction] };
+				int index = m_gridPtr->Index(neighbour.x, neighbour.y);
+				if (m_g[index] != behind) continue;
+				m_g[index] = m_rhs[index] = behind - 2;
+				m_queue.push_back(neighbour);
+			}
+		}
+		m_updatedCells = (int) m_queue.size();
+
+		if (m_gridPtr->IsRigid(oldX, oldY)) DropOldSource(oldX, oldY);
+	}
+
+	// the rigid old source no longer passes distances on: the cells without a neighbour one step closer lose
+	// their distance, and so do the cells only they carried, then all of them take a new one from around them
+	void DropOldSource(int oldX, int oldY)
+	{
+		int oldIndex = m_gridPtr->Index(oldX, oldY);
+		m_g[oldIndex] = m_rhs[oldIndex] = UNREACHABLE;
+
+		m_queue.clear();
+		m_orphans.clear();
+		for (int direction = 0; direction < 4; ++direction)
+		{
+			CELL neighbour = { oldX + DIRECTION_DX[direction], oldY + DIRECTION_DY[direction] };
+			m_queue.push_back(neighbour);
+		}
+		for (size_t head = 0; head < m_queue.size(); ++head)
+		{
+			CELL cell = m_queue[head];
+			int index = m_gridPtr->Index(cell.x, cell.y);
+			if (m_g[index] == UNREACHABLE || IsSource(cell.x, cell.y)) continue;
+
+			int closer = m_g[index] - 1;
+			bool isCarried = false;
+			for (int direction = 0; direction < 4 && !isCarried; ++direction)
+			{
+				isCarried = m_g[m_gridPtr->Index(cell.x + DIRECTION_DX[direction], cell.y + DIRECTION_DY[direction])] == closer;
+			}
+			if (isCarried) continue;
+
+			m_g[index] = m_rhs[index] = UNREACHABLE;
+			m_orphans.push_back(cell);
+			for (int direction = 0; direction < 4; ++direction)
+			{
+				CELL neighbour = { cell.x + DIRECTION_DX[direction], cell.y + DIRECTION_DY[direction] };
+				m_queue.push_back(neighbour);
+			}
+		}
+
+		// the cut off cells find their way back from the cells around them, nearest first
+		int key = UNREACHABLE;
+		for (size_t i = 0; i < m_orphans.size(); ++i)
+		{
+			CELL cell = m_orphans[i];
+			int rhs = UNREACHABLE;
+			for (int direction = 0; direction < 4; ++direction)
+			{
+				rhs = std::min(rhs, m_g[m_gridPtr->Index(cell.x + DIRECTION_DX[direction], cell.y + DIRECTION_DY[direction])] + 1);
+			}
+			if (rhs >= UNREACHABLE) continue;
+			m_rhs[m_gridPtr->Index(cell.x, cell.y)] = rhs;
+			PushBucket(rhs, cell);
+			key = std::min(key, rhs);
+		}
+		for (; key < (int) m_buckets.size(); ++key)
+		{
+			std::vector<CELL>& bucketRef = m_buckets[key];
+			while (!bucketRef.empty())
+			{
+				CELL cell = bucketRef.back();
+				bucketRef.pop_back();
+				int index = m_gridPtr->Index(cell.x, cell.y);
+				if (m_g[index] != UNREACHABLE || m_rhs[index] != key) continue;	// settled from a nearer cell already
+				m_g[index] = key;
+				for (int direction = 0; direction < 4; ++direction)
+				{
+					CELL neighbour = { cell.x + DIRECTION_DX[direction], cell.y + DIRECTION_DY[direction] };
+					int neighbourIndex = m_gridPtr->Index(neighbour.x, neighbour.y);
+					if (m_g[neighbourIndex] != UNREACHABLE || m_rhs[neighbourIndex] <= key + 1 || m_gridPtr->IsRigid(neighbour.x, neighbour.y)) continue;
+					m_rhs[neighbourIndex] = key + 1;
+					PushBucket(key + 1, neighbour);
+				}
+			}
+		}
+		m_updatedCells += (int) m_orphans.size();
+	}
+
+	void PushBucket(int key, CELL cell)
+	{
+		if (key >= (int) m_buckets.size()) m_buckets.resize(key + 1);
+		m_buckets[key].push_back(cell);
+	}
+
+	bool IsSource(int x, int y) const { return x == m_sourceX && y == m_sourceY; }
+
+	void UpdateNeighbours(int x, int y)
+	{
+		for (int direction = 0; direction < 4; ++direction)
+		{
+			UpdateCell(x + DIRECTION_DX[direction], y + DIRECTION_DY[direction]);
+		}
+	}
+
+	// recomputes the lookahead of a cell and queues it when it no longer matches its distance
+	void UpdateCell(int x, int y)
+	{
+		int index = m_gridPtr->Index(x, y);
+		int rhs = UNREACHABLE;
+		if (IsSource(x, y))
+		{
+			rhs = 0;
+		}
+		else if (!m_gridPtr->IsRigid(x, y))
+		{
+			for (int direction = 0; direction < 4; ++direction)
+			{
+				int neighbourX = x + DIRECTION_DX[direction], neighbourY = y + DIRECTION_DY[direction];
+				if (m_gridPtr->IsRigid(neighbourX, neighbourY) && !IsSource(neighbourX, neighbourY)) continue;
+				rhs = std::min(rhs, m_g[m_gridPtr->Index(neighbourX, neighbourY)] + 1);
+			}
+			if (rhs > UNREACHABLE) rhs = UNREACHABLE;
+		}
+		m_rhs[index] = rhs;
+
+		if (m_g[index] != rhs)
+		{
+			int key = std::min(m_g[index], rhs);
+			CELL cell = { x, y };
+			PushBucket(key, cell);
+			if (key < m_currentKey) m_currentKey = key;
+			m_isDirty = true;
+		}
+	}
+
+	// -------------------------
+	// Datamembers
+	// -------------------------
+	const Grid* m_gridPtr;
+	int m_sourceX, m_sourceY;
+	std::vector<int> m_g, m_rhs;
+	std::vector<std::vector<CELL> > m_buckets;		// cells queued by key min(g, rhs)
+	int m_currentKey;
+	bool m_isDirty;
+	bool m_mustRebuild;							// set by Initialize: the first update is a breadth first search
+	int m_updatedCells;
+	std::vector<CELL> m_queue;						// scratch queue of the rebuild and of a source step
+	std::vector<CELL> m_orphans;					// scratch list of the cells a source step cut off
+
+	// -------------------------
+	// Disabling default copy constructor and default assignment operator.
+	// If you get a linker error from one of these functions, your class is internally trying to use them. This is
+	// an error in your class, these declarations are deliberately made without implementation because they should never be used.
+	// -------------------------
+	DistanceField(const DistanceField& dfRef);
+	DistanceField& operator=(const DistanceField& dfRef);
+};
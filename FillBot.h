@@ -0,0 +1,59 @@
+//-----------------------------------------------------------------
+// FillBot Object
+// C++ Header - FillBot.h - version 2010 v2_07
+//
+// FillBot is the filler of AIchallenge: it moves to the first free
+// neighbour in the order left, up, right, down.
+//-----------------------------------------------------------------
+
+#pragma once
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#include "Bot.h"
+
+//-----------------------------------------------------------------
+// FillBot Class
+//-----------------------------------------------------------------
+class FillBot : public Bot
+{
+public:
+	//---------------------------
+	// Constructor(s)
+	//---------------------------
+	FillBot()
+	{
+	}
+
+	//---------------------------
+	// Destructor
+	//---------------------------
+	virtual ~FillBot()
+	{
+	}
+
+	//---------------------------
+	// General Methods
+	//---------------------------
+	const char* GetName() const { return "filler (fill AI)"; }
+
+	int ChooseDirection(const ArenaGrid& arenaRef, const CELL* positionsPtr, int player)
+	{
+		const CELL& headRef = positionsPtr[player];
+		for (int direction = 0; direction < 4; ++direction)
+		{
+			if (!arenaRef.IsRigid(headRef.x + DIRECTION_DX[direction], headRef.y + DIRECTION_DY[direction])) return direction;
+		}
+		return 0;
+	}
+
+private:
+	// -------------------------
+	// Disabling default copy constructor and default assignment operator.
+	// If you get a linker error from one of these functions, your class is internally trying to use them. This is
+	// an error in your class, these declarations are deliberately made without implementation because they should never be used.
+	// -------------------------
+	FillBot(const FillBot& fbRef);
+	FillBot& operator=(const FillBot& fbRef);
+};
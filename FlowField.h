@@ -0,0 +1,352 @@
+//-----------------------------------------------------------------
+// FlowField Object
+// C++ Header - FlowField.h - version 2010 v2_07
+//
+// FlowField steers any number of agents to one shared goal. A breadth
+// first wavefront from the goal fills an integration field (the distance
+// to the goal) and a direction field (the step to take), so an agent
+// only has to look up its cell every tick instead of running an A*.
+// A new rigid cell only invalidates the cells that were routed through
+// it; they are repaired from the valid cells around them by the next
+// lookup, or up front by Repair.
+// FlowFieldCache keeps the fields of the most recently used goals.
+//-----------------------------------------------------------------
+
+#pragma once
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#include "ArenaGrid.h"
+#include "RigidCellListener.h"
+#include <vector>
+#include <algorithm>
+
+//-----------------------------------------------------------------
+// FlowField Class
+//-----------------------------------------------------------------
+template<class Grid>
+class FlowField : public RigidCellListener
+{
+public:
+	static const int UNREACHABLE = 0x3fffffff;
+	static const int NO_DIRECTION = -1;
+
+	//---------------------------
+	// Constructor(s)
+	//---------------------------
+	FlowField() : m_gridPtr(NULL), m_goalX(0), m_goalY(0), m_repairedCells(0)
+	{
+	}
+
+	//---------------------------
+	// Destructor
+	//---------------------------
+	virtual ~FlowField()
+	{
+	}
+
+	//---------------------------
+	// General Methods
+	//---------------------------
+
+	// the grid has to outlive the field, and every new rigid cell has to be reported
+	void Build(const Grid& gridRef, int goalX, int goalY)
+	{
+		m_gridPtr = &gridRef;
+		m_goalX = goalX;
+		m_goalY = goalY;
+		m_distance.assign(gridRef.GetCellCount(), (int) UNREACHABLE);
+		m_direction.assign(gridRef.GetCellCount(), (unsigned char) NONE);
+		m_pendingCells.clear();
+
+		m_queue.clear();
+		if (!gridRef.IsRigid(goalX, goalY))
+		{
+			m_distance[gridRef.Index(goalX, goalY)] = 0;
+			CELL goal = { goalX, goalY };
+			m_queue.push_back(goal);
+		}
+		for (size_t head = 0; head < m_queue.size(); ++head)
+		{
+			CELL cell = m_queue[head];
+			int distance = m_distance[gridRef.Index(cell.x, cell.y)] + 1;
+			for (int direction = 0; direction < 4; ++direction)
+			{
+				CELL neighbour = { cell.x + DIRECTION_DX[direction], cell.y + DIRECTION_DY[direction] };
+				int index = gridRef.Index(neighbour.x, neighbour.y);
+				if (m_distance[index] != UNREACHABLE || gridRef.IsRigid(neighbour.x, neighbour.y)) continue;
+				m_distance[index] = distance;
+				m_direction[index] = (unsigned char) ((direction + 2) & 3);	// back the way the wave came
+				m_queue.push_back(neighbour);
+			}
+		}
+		m_repairedCells = (int) m_queue.size();
+	}
+
+	void CellBecameRigid(int x, int y)
+	{
+		// a cell no path ran through changes nothing for the others
+		if (m_distance[m_gridPtr->Index(x, y)] == UNREACHABLE) return;
+		CELL cell = { x, y };
+		m_pendingCells.push_back(cell);
+	}
+
+	// repairs the cells routed through new rigid cells, returns the number of cells that got a new distance
+	int Repair()
+	{
+		m_repairedCells = 0;
+		if (m_pendingCells.empty()) return 0;
+
+		// the rigid cells and everything whose direction leads through them lose their distance
+		m_queue.clear();
+		for (size_t i = 0; i < m_pendingCells.size(); ++i)
+		{
+			int index = m_gridPtr->Index(m_pendingCells[i].x, m_pendingCells[i].y);
+			if (m_distance[index] == UNREACHABLE) continue;
+			m_distance[index] = UNREACHABLE;
+			m_direction[index] = NONE;
+			m_queue.push_back(m_pendingCells[i]);
+		}
+		m_pendingCells.clear();
+		for (size_t head = 0; head < m_queue.size(); ++head)
+		{
+			CELL cell = m_queue[head];
+			for (int direction = 0; direction < 4; ++direction)
+			{
+				CELL neighbour = { cell.x + DIRECTION_DX[direction], cell.y + DIRECTION_DY[direction] };
+				int index = m_gridPtr->Index(neighbour.x, neighbour.y);
+				if (m_direction[index] != ((direction + 2) & 3) || m_distance[index] == UNREACHABLE) continue;
+				m_distance[index] = UNREACHABLE;
+				m_direction[index] = NONE;
+				m_queue.push_back(neighbour);
+			}
+		}
+
+		// the invalidated cells take the best offer of their valid neighbours, then the wave spreads in distance order
+		m_open.clear();
+		for (size_t i = 0; i < m_queue.size(); ++i)
+		{
+			const CELL& cellRef = m_queue[i];
+			if (m_gridPtr->IsRigid(cellRef.x, cellRef.y)) continue;
+			if (Relax(cellRef.x, cellRef.y)) PushOpen(cellRef.x, cellRef.y);
+		}
+		while (!m_open.empty())
+		{
+			OpenNode node = m_open.front();
+			std::pop_heap(m_open.begin(), m_open.end());
+			m_open.pop_back();
+			int distance = m_distance[m_gridPtr->Index(node.x, node.y)];
+			if (node.distance != distance) continue;		// outdated entry
+			++m_repairedCells;
+
+			for (int direction = 0; direction < 4; ++direction)
+			{
+				int x = node.x + DIRECTION_DX[direction], y = node.y + DIRECTION_DY[direction];
+				int index = m_gridPtr->Index(x, y);
+				if (m_distance[index] <= distance + 1 || m_gridPtr->IsRigid(x, y)) continue;
+				m_distance[index] = distance + 1;
+				m_direction[index] = (unsigned char) ((direction + 2) & 3);
+				PushOpen(x, y);
+			}
+		}
+		return m_repairedCells;
+	}
+
+	bool IsDirty() const { return !m_pendingCells.empty(); }
+
+	// direction (like DIRECTION) of the next step towards the goal, NO_DIRECTION at the goal or when it can't be reached;
+	// the lookups repair the field first when new rigid cells are pending
+	int GetDirection(int x, int y)
+	{
+		if (IsDirty()) Repair();
+		unsigned char direction = m_direction[m_gridPtr->Index(x, y)];
+		return direction == NONE ? NO_DIRECTION : direction;
+	}
+
+	int GetDistance(int x, int y)
+	{
+		if (IsDirty()) Repair();
+		return m_distance[m_gridPtr->Index(x, y)];
+	}
+
+	int GetGoalX() const { return m_goalX; }
+	int GetGoalY() const { return m_goalY; }
+	int GetRepairedCellCount() const { return m_repairedCells; }
+
+private:
+	// -------------------------
+	// Internal structs
+	// -------------------------
+	static const unsigned char NONE = 0xff;
+
+	struct OpenNode
+	{
+		int distance;
+		int x, y;
+		// the open list is a max heap, so the comparison is reversed
+		bool operator<(const OpenNode& otherRef) const { return distance > otherRef.distance; }
+	};
+
+	// -------------------------
+	// Member functions
+	// -------------------------
+
+	// takes the best distance a valid neighbour offers, returns true when there was one
+	bool Relax(int x, int y)
+	{
+		int index = m_gridPtr->Index(x, y);
+		for (int direction = 0; direction < 4; ++direction)
+		{
+			int neighbourX = x + DIRECTION_DX[direction], neighbourY = y + DIRECTION_DY[direction];
+			int distance = m_distance[m_gridPtr->Index(neighbourX, neighbourY)];
+			if (distance + 1 < m_distance[index] && !m_gridPtr->IsRigid(neighbourX, neighbourY))
+			{
+				m_distance[index] = distance + 1;
+				m_direction[index] = (unsigned char) direction;
+			}
+		}
+		return m_distance[index] != UNREACHABLE;
+	}
+
+	void PushOpen(int x, int y)
+	{
+		OpenNode node = { m_distance[m_gridPtr->Index(x, y)], x, y };
+		m_open.push_back(node);
+		std::push_heap(m_open.begin(), m_open.end());
+	}
+
+	// -------------------------
+	// Datamembers
+	// -------------------------
+	const Grid* m_gridPtr;
+	int m_goalX, m_goalY;
+	std::vector<int> m_distance;				// integration field
+	std::vector<unsigned char> m_direction;		// direction field, NONE at the goal and where it can't be reached
+	std::vector<CELL> m_pendingCells;			// new rigid cells that still have to be repaired
+	std::vector<CELL> m_queue;					// scratch queue of the build and of the invalidation
+	std::vector<OpenNode> m_open;				// scratch open list of the repair
+	int m_repairedCells;
+
+	// -------------------------
+	// Disabling default copy constructor and default assignment operator.
+	// If you get a linker error from one of these functions, your class is internally trying to use them. This is
+	// an error in your class, these declarations are deliberately made without implementation because they should never be used.
+	// -------------------------
+	FlowField(const FlowField& ffRef);
+	FlowField& operator=(const FlowField& ffRef);
+};
+
+//-----------------------------------------------------------------
+// FlowFieldCache Class
+//-----------------------------------------------------------------
+template<class Grid>
+class FlowFieldCache : public RigidCellListener
+{
+public:
+	//---------------------------
+	// Constructor(s)
+	//---------------------------
+	FlowFieldCache() : m_gridPtr(NULL), m_maxFields(8), m_useCount(0), m_builtFields(0)
+	{
+	}
+
+	//---------------------------
+	// Destructor
+	//---------------------------
+	virtual ~FlowFieldCache()
+	{
+		Clear();
+	}
+
+	//---------------------------
+	// General Methods
+	//---------------------------
+
+	// the grid has to outlive the cache, and every new rigid cell has to be reported;
+	// every field takes 5 bytes per cell, so maxFields bounds the memory
+	void Initialize(const Grid& gridRef, int maxFields = 8)
+	{
+		Clear();
+		m_gridPtr = &gridRef;
+		m_maxFields = maxFields;
+	}
+
+	void Clear()
+	{
+		for (size_t i = 0; i < m_entries.size(); ++i)
+		{
+			delete m_entries[i].fieldPtr;
+		}
+		m_entries.clear();
+	}
+
+	// the up to date field of a goal; builds it the first time, dropping the least recently used field when the cache is full
+	FlowField<Grid>& GetField(int goalX, int goalY)
+	{
+		++m_useCount;
+		for (size_t i = 0; i < m_entries.size(); ++i)
+		{
+			FlowField<Grid>* fieldPtr = m_entries[i].fieldPtr;
+			if (fieldPtr->GetGoalX() != goalX || fieldPtr->GetGoalY() != goalY) continue;
+			m_entries[i].lastUse = m_useCount;
+			if (fieldPtr->IsDirty()) fieldPtr->Repair();
+			return *fieldPtr;
+		}
+
+		if ((int) m_entries.size() >= m_maxFields)
+		{
+			size_t oldest = 0;
+			for (size_t i = 1; i < m_entries.size(); ++i)
+			{
+				if (m_entries[i].lastUse < m_entries[oldest].lastUse) oldest = i;
+			}
+			delete m_entries[oldest].fieldPtr;
+			m_entries.erase(m_entries.begin() + oldest);
+		}
+
+		Entry entry = { new FlowField<Grid>(), m_useCount };
+		entry.fieldPtr->Build(*m_gridPtr, goalX, goalY);
+		m_entries.push_back(entry);
+		++m_builtFields;
+		return *entry.fieldPtr;
+	}
+
+	void CellBecameRigid(int x, int y)
+	{
+		for (size_t i = 0; i < m_entries.size(); ++i)
+		{
+			m_entries[i].fieldPtr->CellBecameRigid(x, y);
+		}
+	}
+
+	int GetFieldCount() const { return (int) m_entries.size(); }
+	int GetBuiltFieldCount() const { return m_builtFields; }
+
+private:
+	// -------------------------
+	// Internal structs
+	// -------------------------
+	struct Entry
+	{
+		FlowField<Grid>* fieldPtr;
+		int lastUse;
+	};
+
+	// -------------------------
+	// Datamembers
+	// -------------------------
+	const Grid* m_gridPtr;
+	int m_maxFields;
+	int m_useCount;
+	int m_builtFields;
+	std::vector<Entry> m_entries;
+
+	// -------------------------
+	// Disabling default copy constructor and default assignment operator.
+	// If you get a linker error from one of these functions, your class is internally trying to use them. This is
+	// an error in your class, these declarations are deliberately made without implementation because they should never be used.
+	// -------------------------
+	FlowFieldCache(const FlowFieldCache& ffcRef);
+	FlowFieldCache& operator=(const FlowFieldCache& ffcRef);
+};
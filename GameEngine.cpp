@@ -2582,6 +2582,7 @@ TargaLoader::TargaLoader()
 	pImage=pPalette=pData=NULL;
 	iWidth=iHeight=iBPP=bEnc=0;
 	lImageSize=0;
+	lDataSize=0;
 }
  
 TargaLoader::~TargaLoader()
@@ -2650,6 +2651,7 @@ int TargaLoader::Load(TCHAR* szFilename)
  
 	// Read the file into memory
 	fIn.read((char*)pData,ulSize);
+	lDataSize=ulSize;
  
 	fIn.close();
  
@@ -2693,7 +2695,21 @@ int TargaLoader::Load(TCHAR* szFilename)
  
 		//BGRtoRGB(); // Convert to RGB
 		break;
- 
+
+	case 3: // Raw greyscale
+		// Check filesize against header values
+		if((lImageSize+18+pData[0])>ulSize) return IMG_ERR_BAD_FORMAT;
+
+		// Double check image type field
+		if(pData[1]!=0) return IMG_ERR_BAD_FORMAT;
+
+		// Load image data, there is no palette
+		iRet=LoadRawData();
+
+		if(iRet!=IMG_OK) return iRet;
+
+		break;
+
     case 9: // RLE Indexed
       	// Double check image type field
         if(pData[1]!=1) return IMG_ERR_BAD_FORMAT;
@@ -2721,7 +2737,18 @@ int TargaLoader::Load(TCHAR* szFilename)
  
        //BGRtoRGB(); // Convert to RGB
        break;
- 
+
+	case 11: // RLE greyscale
+		// Double check image type field
+		if(pData[1]!=0) return IMG_ERR_BAD_FORMAT;
+
+		// Load image data, there is no palette
+		iRet=LoadTgaRLEData();
+
+		if(iRet!=IMG_OK) return iRet;
+
+		break;
+
 	default:
 		return IMG_ERR_UNSUPPORTED;
     }
@@ -2743,6 +2770,10 @@ int TargaLoader::ReadHeader() // Examine the header and populate our class attri
  
 	if(pData==NULL)
 		return IMG_ERR_NO_FILE;
+
+	// The header alone is 18 bytes
+	if(lDataSize<18)
+		return IMG_ERR_BAD_FORMAT;
  
 	if(pData[1]>1)    // 0 (RGB) and 1 (Indexed) are the only types we know about
 		return IMG_ERR_UNSUPPORTED;
@@ -2817,7 +2848,7 @@ int TargaLoader::LoadRawData() // Load uncompressed image data
 int TargaLoader::LoadTgaRLEData() // Load RLE compressed image data
 {
 	short iOffset,iPixelSize;
-	unsigned char *pCur;
+	unsigned char *pCur,*pEnd;
 	unsigned long Index=0;
 	unsigned char bLength,bLoop;
  
@@ -2830,8 +2861,12 @@ int TargaLoader::LoadTgaRLEData() // Load RLE compressed image data
 	// Get pixel size in bytes
 	iPixelSize=iBPP/8;
  
+	// The image data, and the palette before it, must start inside the file
+	if((unsigned long)iOffset>=lDataSize) return IMG_ERR_BAD_FORMAT;
+
 	// Set our pointer to the beginning of the image data
 	pCur=&pData[iOffset];
+	pEnd=&pData[lDataSize];
  
 	// Allocate space for the image data
 	if(pImage!=NULL) delete [] pImage;
@@ -2843,10 +2878,19 @@ int TargaLoader::LoadTgaRLEData() // Load RLE compressed image data
 	// Decode
 	while(Index<lImageSize) 
     {
+		// A truncated file runs out of packets before the image is full
+		if(pCur>=pEnd) return IMG_ERR_BAD_FORMAT;
+
 		if(*pCur & 0x80) // Run length chunk (High bit = 1)
 		{
 			bLength=*pCur-127; // Get run length
 			pCur++;            // Move to pixel data  
+
+			// A run must not write past the end of the image
+			if(Index+bLength*iPixelSize>lImageSize) return IMG_ERR_BAD_FORMAT;
+
+			// and must not read its pixel past the end of the file
+			if(pEnd-pCur<iPixelSize) return IMG_ERR_BAD_FORMAT;
  
 			// Repeat the next pixel bLength times
 			for(bLoop=0;bLoop!=bLength;++bLoop,Index+=iPixelSize)
@@ -2858,6 +2902,9 @@ int TargaLoader::LoadTgaRLEData() // Load RLE compressed image data
 		{
 			bLength=*pCur+1; // Get run length
 			pCur++;          // Move to pixel data
+
+			if(Index+bLength*iPixelSize>lImageSize) return IMG_ERR_BAD_FORMAT;
+			if(pEnd-pCur<bLength*iPixelSize) return IMG_ERR_BAD_FORMAT;
  
 			// Write the next bLength pixels directly
 			for(bLoop=0;bLoop!=bLength;++bLoop,Index+=iPixelSize,pCur+=iPixelSize)
@@ -619,6 +619,7 @@ public:
 private:
 	short int iWidth,iHeight,iBPP;
 	unsigned long lImageSize;
+	unsigned long lDataSize; // Size of the file loaded into pData
 	char bEnc;
 	unsigned char *pImage, *pPalette, *pData;
    
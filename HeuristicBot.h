@@ -0,0 +1,138 @@
+//-----------------------------------------------------------------
+// HeuristicBot Object
+// C++ Header - HeuristicBot.h - version 2010 v2_07
+//
+// HeuristicBot scores every free neighbour with a weighted sum of cheap
+// features and moves to the best one; a tie goes to the first in the
+// order left, up, right, down. Its weights are what ParameterTuner tunes:
+//	SPACE		free neighbours of the cell, 0 means walking into a dead end
+//	HUGGING		rigid cells among the 8 around it, filling compactly like the filler
+//	AGGRESSION	+1 when the move closes in on the opponent, -1 when it moves away
+//	STRAIGHT	1 when it keeps the direction of the last move
+//	ROOM		free cells in the 5 x 5 square around it, divided by 5
+//	ORDER		1 for left down to 0 for down, the tie-break order as a weight
+//-----------------------------------------------------------------
+
+#pragma once
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#include "Bot.h"
+
+//-----------------------------------------------------------------
+// HeuristicBot Class
+//-----------------------------------------------------------------
+class HeuristicBot : public Bot
+{
+public:
+	enum Weight
+	{
+		SPACE,
+		HUGGING,
+		AGGRESSION,
+		STRAIGHT,
+		ROOM,
+		ORDER
+	};
+	static const int WEIGHT_COUNT = 6;
+
+	//---------------------------
+	// Constructor(s)
+	//---------------------------
+	HeuristicBot() : m_lastDirection(-1)
+	{
+		static const double defaults[WEIGHT_COUNT] = { 1.0, 0.5, 0.0, 0.2, 0.5, 0.1 };
+		SetWeights(defaults);
+	}
+
+	//---------------------------
+	// Destructor
+	//---------------------------
+	virtual ~HeuristicBot()
+	{
+	}
+
+	//---------------------------
+	// General Methods
+	//---------------------------
+	const char* GetName() const { return "heuristic (weighted AI)"; }
+	void StartMatch(int player, uint64_t seed) { m_lastDirection = -1; }
+
+	void SetWeights(const double* weightsPtr)
+	{
+		for (int i = 0; i < WEIGHT_COUNT; ++i) m_weights[i] = weightsPtr[i];
+	}
+
+	double GetWeight(Weight weight) const { return m_weights[weight]; }
+
+	int ChooseDirection(const ArenaGrid& arenaRef, const CELL* positionsPtr, int player)
+	{
+		const CELL& headRef = positionsPtr[player];
+		const CELL& opponentRef = positionsPtr[1 - player];
+		int distance = Distance(headRef, opponentRef);
+		int width = arenaRef.GetWidth(), height = arenaRef.GetHeight();
+
+		int bestDirection = 0;
+		double bestScore = -1e300;
+		for (int direction = 0; direction < 4; ++direction)
+		{
+			CELL cell = { headRef.x + DIRECTION_DX[direction], headRef.y + DIRECTION_DY[direction] };
+			if (arenaRef.IsRigid(cell.x, cell.y)) continue;
+
+			// the sentinel ring keeps the 8 neighbours of a free cell readable
+			int rigidAround = 0;
+			for (int dy = -1; dy <= 1; ++dy)
+			{
+				for (int dx = -1; dx <= 1; ++dx) rigidAround += arenaRef.GetCell(cell.x + dx, cell.y + dy);
+			}
+			int freeNeighbours = 4 - arenaRef.CountRigidNeighbours(cell.x, cell.y);
+			int room = 0;
+			for (int y = cell.y - 2; y <= cell.y + 2; ++y)
+			{
+				for (int x = cell.x - 2; x <= cell.x + 2; ++x)
+				{
+					if (x >= 0 && y >= 0 && x < width && y < height && !arenaRef.IsRigid(x, y)) ++room;
+				}
+			}
+
+			double score = m_weights[SPACE] * freeNeighbours
+				+ m_weights[HUGGING] * (rigidAround - 1)
+				+ m_weights[AGGRESSION] * (distance - Distance(cell, opponentRef))
+				+ m_weights[STRAIGHT] * (direction == m_lastDirection ? 1 : 0)
+				+ m_weights[ROOM] * room / 5.0
+				+ m_weights[ORDER] * (3 - direction) / 3.0;
+			if (score > bestScore)
+			{
+				bestScore = score;
+				bestDirection = direction;
+			}
+		}
+		m_lastDirection = bestDirection;
+		return bestDirection;
+	}
+
+private:
+	// -------------------------
+	// Member functions
+	// -------------------------
+	static int Distance(const CELL& firstRef, const CELL& secondRef)
+	{
+		int dx = firstRef.x - secondRef.x, dy = firstRef.y - secondRef.y;
+		return (dx < 0 ? -dx : dx) + (dy < 0 ? -dy : dy);
+	}
+
+	// -------------------------
+	// Datamembers
+	// -------------------------
+	double m_weights[WEIGHT_COUNT];
+	int m_lastDirection;
+
+	// -------------------------
+	// Disabling default copy constructor and default assignment operator.
+	// If you get a linker error from one of these functions, your class is internally trying to use them. This is
+	// an error in your class, these declarations are deliberately made without implementation because they should never be used.
+	// -------------------------
+	HeuristicBot(const HeuristicBot& hbRef);
+	HeuristicBot& operator=(const HeuristicBot& hbRef);
+};
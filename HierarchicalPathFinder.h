@@ -0,0 +1,527 @@
+//-----------------------------------------------------------------
+// HierarchicalPathFinder Object
+// C++ Header - HierarchicalPathFinder.h - version 2010 v2_07
+//
+// HierarchicalPathFinder answers long range path queries with HPA*
+// (Botea, Mueller & Schaeffer). The arena is cut into square clusters;
+// the free stretches along the border of two clusters become entrances,
+// and every cluster stores the distances between its own entrance cells.
+// A query searches this small abstract graph and returns waypoints; each
+// piece between two waypoints stays inside one cluster and is only
+// turned into cells when RefineSegment asks for it.
+// A new rigid cell only marks its cluster (and the neighbour across a
+// border it lies on) as dirty, and dirty clusters are rebuilt at the next
+// query.
+// The start and the goal may be rigid, as the head of a player always is:
+// a path leaves the start and ends on the goal, but never passes through
+// another rigid cell. A rigid cell is no entrance, so the free cells next
+// to the start or the goal across a cluster border are linked directly.
+//-----------------------------------------------------------------
+
+#pragma once
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#include "ArenaGrid.h"
+#include "RigidCellListener.h"
+#include <vector>
+#include <algorithm>
+#include <stdlib.h>
+
+//-----------------------------------------------------------------
+// HierarchicalPathFinder Class
+//-----------------------------------------------------------------
+template<class Grid>
+class HierarchicalPathFinder : public RigidCellListener
+{
+public:
+	static const int UNREACHABLE = 0x3fffffff;
+
+	//---------------------------
+	// Constructor(s)
+	//---------------------------
+	HierarchicalPathFinder() : m_gridPtr(NULL), m_clusterSize(32), m_clustersX(0), m_clustersY(0), m_stamp(0), m_goalDoorCount(0)
+	{
+	}
+
+	//---------------------------
+	// Destructor
+	//---------------------------
+	virtual ~HierarchicalPathFinder()
+	{
+	}
+
+	//---------------------------
+	// General Methods
+	//---------------------------
+
+	// the grid has to outlive the path finder, and every new rigid cell has to be reported
+	void Initialize(const Grid& gridRef, int clusterSize = 32)
+	{
+		m_gridPtr = &gridRef;
+		m_clusterSize = clusterSize;
+		m_clustersX = (gridRef.GetWidth() + clusterSize - 1) / clusterSize;
+		m_clustersY = (gridRef.GetHeight() + clusterSize - 1) / clusterSize;
+
+		m_clusters.assign(m_clustersX * m_clustersY, Cluster());
+		m_nodeIndexAt.assign(gridRef.GetCellCount(), -1);
+		m_stamps.assign(gridRef.GetCellCount(), 0);
+		m_g.resize(gridRef.GetCellCount());
+		m_parent.resize(gridRef.GetCellCount());
+		m_stamp = 0;
+		m_localDistance.resize(clusterSize * clusterSize);
+		m_localParent.resize(clusterSize * clusterSize);
+
+		m_dirtyClusters.clear();
+		for (int cluster = 0; cluster < (int) m_clusters.size(); ++cluster)
+		{
+			MarkDirty(cluster);
+		}
+		Refresh();
+	}
+
+	void CellBecameRigid(int x, int y)
+	{
+		int clusterX = x / m_clusterSize, clusterY = y / m_clusterSize;
+		MarkDirty(clusterY * m_clustersX + clusterX);
+
+		// a border cell also changes the entrances of the cluster on the other side
+		if (x % m_clusterSize == 0 && clusterX > 0) MarkDirty(clusterY * m_clustersX + clusterX - 1);
+		if (x % m_clusterSize == m_clusterSize - 1 && clusterX < m_clustersX - 1) MarkDirty(clusterY * m_clustersX + clusterX + 1);
+		if (y % m_clusterSize == 0 && clusterY > 0) MarkDirty((clusterY - 1) * m_clustersX + clusterX);
+		if (y % m_clusterSize == m_clusterSize - 1 && clusterY < m_clustersY - 1) MarkDirty((clusterY + 1) * m_clustersX + clusterX);
+	}
+
+	// rebuilds the dirty clusters, returns how many there were
+	int Refresh()
+	{
+		int count = (int) m_dirtyClusters.size();
+		for (int i = 0; i < count; ++i)
+		{
+			ClearNodes(m_dirtyClusters[i]);
+		}
+		for (int i = 0; i < count; ++i)
+		{
+			BuildNodes(m_dirtyClusters[i]);
+		}
+		for (int i = 0; i < count; ++i)
+		{
+			BuildDistances(m_dirtyClusters[i]);
+			m_clusters[m_dirtyClusters[i]].isDirty = false;
+		}
+		m_dirtyClusters.clear();
+		return count;
+	}
+
+	// searches the abstract graph, returns the path length or UNREACHABLE
+	// the waypoints (start and goal included) are written to waypointsPtr when it isn't NULL
+	int FindPath(int startX, int startY, int goalX, int goalY, std::vector<CELL>* waypointsPtr = NULL)
+	{
+		Refresh();
+		if (waypointsPtr != NULL) waypointsPtr->clear();
+
+		NewSearch();
+		int startCluster = GetCluster(startX, startY), goalCluster = GetCluster(goalX, goalY);
+		CELL start = MakeCell(startX, startY);
+
+		// the goal is linked to the entrances of its own cluster
+		ClusterBreadthFirst(goalCluster, goalX, goalY);
+		const Cluster& goalClusterRef = m_clusters[goalCluster];
+		m_goalDistance.resize(goalClusterRef.nodes.size());
+		for (size_t i = 0; i < goalClusterRef.nodes.size(); ++i)
+		{
+			m_goalDistance[i] = GetLocalDistance(goalCluster, goalClusterRef.nodes[i].x, goalClusterRef.nodes[i].y);
+		}
+
+		// as are the free cells next to the goal across a border: the goal is one step on from them
+		m_goalDoorCount = 0;
+		for (int direction = 0; direction < 4; ++direction)
+		{
+			CELL door = MakeCell(goalX + DIRECTION_DX[direction], goalY + DIRECTION_DY[direction]);
+			int doorCluster = GetCluster(door.x, door.y);
+			if (doorCluster == goalCluster || m_gridPtr->IsRigid(door.x, door.y)) continue;
+
+			GoalDoor& doorRef = m_goalDoors[m_goalDoorCount++];
+			doorRef.cell = door;
+			doorRef.cluster = doorCluster;
+			ClusterBreadthFirst(doorCluster, door.x, door.y);
+			const Cluster& doorClusterRef = m_clusters[doorCluster];
+			doorRef.distances.resize(doorClusterRef.nodes.size());
+			for (size_t i = 0; i < doorClusterRef.nodes.size(); ++i)
+			{
+				doorRef.distances[i] = GetLocalDistance(doorCluster, doorClusterRef.nodes[i].x, doorClusterRef.nodes[i].y);
+			}
+		}
+
+		// and so is the start, which may also reach the goal without leaving its cluster
+		Relax(start, 0, start, goalX, goalY);
+		LinkToCluster(startCluster, start, 0, goalX, goalY);
+
+		// the free cells next to the start across a border are one step away
+		for (int direction = 0; direction < 4; ++direction)
+		{
+			CELL next = MakeCell(startX + DIRECTION_DX[direction], startY + DIRECTION_DY[direction]);
+			if (GetCluster(next.x, next.y) == startCluster) continue;
+			if (next.x == goalX && next.y == goalY)
+			{
+				Relax(next, 1, start, goalX, goalY);
+			}
+			else if (!m_gridPtr->IsRigid(next.x, next.y))
+			{
+				Relax(next, 1, start, goalX, goalY);
+				LinkToCluster(GetCluster(next.x, next.y), next, 1, goalX, goalY);
+			}
+		}
+
+		int length = UNREACHABLE;
+		while (!m_open.empty())
+		{
+			OpenNode node = m_open.front();
+			std::pop_heap(m_open.begin(), m_open.end());
+			m_open.pop_back();
+			if (m_g[m_gridPtr->Index(node.cell.x, node.cell.y)] != node.g) continue;	// outdated heap entry
+			if (node.cell.x == goalX && node.cell.y == goalY)
+			{
+				length = node.g;
+				break;
+			}
+			if (IsGoalDoor(node.cell)) Relax(MakeCell(goalX, goalY), node.g + 1, node.cell, goalX, goalY);
+
+			int nodeIndex = m_nodeIndexAt[m_gridPtr->Index(node.cell.x, node.cell.y)];
+			if (nodeIndex < 0) continue;		// the start and the cells next to it, already expanded above
+			int cluster = GetCluster(node.cell.x, node.cell.y);
+			const Cluster& clusterRef = m_clusters[cluster];
+			int nodeCount = (int) clusterRef.nodes.size();
+
+			// inside the cluster
+			for (int other = 0; other < nodeCount; ++other)
+			{
+				int distance = clusterRef.distances[nodeIndex * nodeCount + other];
+				if (other != nodeIndex && distance < UNREACHABLE) Relax(clusterRef.nodes[other], node.g + distance, node.cell, goalX, goalY);
+			}
+			if (cluster == goalCluster && m_goalDistance[nodeIndex] < UNREACHABLE)
+			{
+				Relax(MakeCell(goalX, goalY), node.g + m_goalDistance[nodeIndex], node.cell, goalX, goalY);
+			}
+			for (int door = 0; door < m_goalDoorCount; ++door)
+			{
+				const GoalDoor& doorRef = m_goalDoors[door];
+				if (doorRef.cluster == cluster && doorRef.distances[nodeIndex] < UNREACHABLE) Relax(doorRef.cell, node.g + doorRef.distances[nodeIndex], node.cell, goalX, goalY);
+			}
+
+			// across the border to the entrance cell on the other side
+			for (int direction = 0; direction < 4; ++direction)
+			{
+				CELL neighbour = MakeCell(node.cell.x + DIRECTION_DX[direction], node.cell.y + DIRECTION_DY[direction]);
+				if (m_gridPtr->IsRigid(neighbour.x, neighbour.y)) continue;
+				if (GetCluster(neighbour.x, neighbour.y) == cluster) continue;
+				if (m_nodeIndexAt[m_gridPtr->Index(neighbour.x, neighbour.y)] < 0) continue;
+				Relax(neighbour, node.g + 1, node.cell, goalX, goalY);
+			}
+		}
+
+		if (waypointsPtr != NULL && length < UNREACHABLE)
+		{
+			CELL cell = MakeCell(goalX, goalY);
+			waypointsPtr->push_back(cell);
+			while (cell.x != startX || cell.y != startY)
+			{
+				cell = m_parent[m_gridPtr->Index(cell.x, cell.y)];
+				waypointsPtr->push_back(cell);
+			}
+			std::reverse(waypointsPtr->begin(), waypointsPtr->end());
+		}
+		return length;
+	}
+
+	// turns two consecutive waypoints into cells, from included, to excluded
+	bool RefineSegment(const CELL& fromRef, const CELL& toRef, std::vector<CELL>* cellsPtr)
+	{
+		cellsPtr->clear();
+		int cluster = GetCluster(fromRef.x, fromRef.y);
+		if (cluster != GetCluster(toRef.x, toRef.y))
+		{
+			// an edge between two entrances
+			cellsPtr->push_back(fromRef);
+			return true;
+		}
+
+		ClusterBreadthFirst(cluster, fromRef.x, fromRef.y, toRef.x, toRef.y);
+		int length = GetLocalDistance(cluster, toRef.x, toRef.y);
+		if (length >= UNREACHABLE) return false;
+
+		cellsPtr->resize(length);
+		int x = toRef.x, y = toRef.y;
+		for (int i = length - 1; i >= 0; --i)
+		{
+			int direction = m_localParent[LocalIndex(cluster, x, y)];
+			x -= DIRECTION_DX[direction];
+			y -= DIRECTION_DY[direction];
+			(*cellsPtr)[i] = MakeCell(x, y);
+		}
+		return true;
+	}
+
+	int GetClusterSize() const { return m_clusterSize; }
+	int GetAbstractNodeCount() const
+	{
+		int count = 0;
+		for (size_t cluster = 0; cluster < m_clusters.size(); ++cluster)
+		{
+			count += (int) m_clusters[cluster].nodes.size();
+		}
+		return count;
+	}
+
+private:
+	// -------------------------
+	// Internal structs
+	// -------------------------
+	struct Cluster
+	{
+		Cluster() : isDirty(false) {}
+		std::vector<CELL> nodes;		// entrance cells of this cluster
+		std::vector<int> distances;		// nodes x nodes, distances inside the cluster
+		bool isDirty;
+	};
+
+	struct GoalDoor
+	{
+		CELL cell;						// free cell next to the goal in another cluster
+		int cluster;
+		std::vector<int> distances;		// from every node of that cluster to the door
+	};
+
+	struct OpenNode
+	{
+		int f, g;
+		CELL cell;
+		// the open list is a max heap: lowest f first, deepest g first on ties
+		bool operator<(const OpenNode& otherRef) const
+		{
+			if (f != otherRef.f) return f > otherRef.f;
+			return g < otherRef.g;
+		}
+	};
+
+	// -------------------------
+	// Member functions
+	// -------------------------
+	static CELL MakeCell(int x, int y)
+	{
+		CELL cell = { x, y };
+		return cell;
+	}
+
+	int GetCluster(int x, int y) const { return (y / m_clusterSize) * m_clustersX + x / m_clusterSize; }
+	int GetClusterLeft(int cluster) const { return (cluster % m_clustersX) * m_clusterSize; }
+	int GetClusterTop(int cluster) const { return (cluster / m_clustersX) * m_clusterSize; }
+	int GetClusterRight(int cluster) const { return std::min(GetClusterLeft(cluster) + m_clusterSize, m_gridPtr->GetWidth()) - 1; }
+	int GetClusterBottom(int cluster) const { return std::min(GetClusterTop(cluster) + m_clusterSize, m_gridPtr->GetHeight()) - 1; }
+	int LocalIndex(int cluster, int x, int y) const { return (y - GetClusterTop(cluster)) * m_clusterSize + x - GetClusterLeft(cluster); }
+	int GetLocalDistance(int cluster, int x, int y) const { return m_localDistance[LocalIndex(cluster, x, y)]; }
+
+	bool IsGoalDoor(const CELL& cellRef) const
+	{
+		for (int door = 0; door < m_goalDoorCount; ++door)
+		{
+			if (m_goalDoors[door].cell.x == cellRef.x && m_goalDoors[door].cell.y == cellRef.y) return true;
+		}
+		return false;
+	}
+
+	// relaxes everything a cell reaches inside its cluster: the entrances, the goal and the doors to it
+	void LinkToCluster(int cluster, const CELL& fromRef, int g, int goalX, int goalY)
+	{
+		ClusterBreadthFirst(cluster, fromRef.x, fromRef.y, goalX, goalY);
+		const Cluster& clusterRef = m_clusters[cluster];
+		for (size_t i = 0; i < clusterRef.nodes.size(); ++i)
+		{
+			int distance = GetLocalDistance(cluster, clusterRef.nodes[i].x, clusterRef.nodes[i].y);
+			if (distance < UNREACHABLE) Relax(clusterRef.nodes[i], g + distance, fromRef, goalX, goalY);
+		}
+		if (cluster == GetCluster(goalX, goalY))
+		{
+			int distance = GetLocalDistance(cluster, goalX, goalY);
+			if (distance < UNREACHABLE) Relax(MakeCell(goalX, goalY), g + distance, fromRef, goalX, goalY);
+		}
+		for (int door = 0; door < m_goalDoorCount; ++door)
+		{
+			const GoalDoor& doorRef = m_goalDoors[door];
+			if (doorRef.cluster != cluster) continue;
+			int distance = GetLocalDistance(cluster, doorRef.cell.x, doorRef.cell.y);
+			if (distance < UNREACHABLE) Relax(doorRef.cell, g + distance, fromRef, goalX, goalY);
+		}
+	}
+
+	void MarkDirty(int cluster)
+	{
+		if (m_clusters[cluster].isDirty) return;
+		m_clusters[cluster].isDirty = true;
+		m_dirtyClusters.push_back(cluster);
+	}
+
+	void ClearNodes(int cluster)
+	{
+		Cluster& clusterRef = m_clusters[cluster];
+		for (size_t i = 0; i < clusterRef.nodes.size(); ++i)
+		{
+			m_nodeIndexAt[m_gridPtr->Index(clusterRef.nodes[i].x, clusterRef.nodes[i].y)] = -1;
+		}
+		clusterRef.nodes.clear();
+	}
+
+	void BuildNodes(int cluster)
+	{
+		int left = GetClusterLeft(cluster), top = GetClusterTop(cluster);
+		int right = GetClusterRight(cluster), bottom = GetClusterBottom(cluster);
+		int width = right - left + 1, height = bottom - top + 1;
+
+		if (left > 0) AddEntrances(cluster, left, top, 0, 1, height, -1, 0);
+		if (right < m_gridPtr->GetWidth() - 1) AddEntrances(cluster, right, top, 0, 1, height, 1, 0);
+		if (top > 0) AddEntrances(cluster, left, top, 1, 0, width, 0, -1);
+		if (bottom < m_gridPtr->GetHeight() - 1) AddEntrances(cluster, left, bottom, 1, 0, width, 0, 1);
+	}
+
+	// walks one border; every run of open cell pairs becomes one entrance in the middle, or two at its ends when it is long
+	// both clusters walk the same pairs in the same order, so they pick matching cells
+	void AddEntrances(int cluster, int x, int y, int stepX, int stepY, int length, int acrossX, int acrossY)
+	{
+		int runStart = -1;
+		for (int i = 0; i <= length; ++i)
+		{
+			int cellX = x + i * stepX, cellY = y + i * stepY;
+			bool isOpen = i < length && !m_gridPtr->IsRigid(cellX, cellY) && !m_gridPtr->IsRigid(cellX + acrossX, cellY + acrossY);
+			if (isOpen && runStart < 0) runStart = i;
+			if (!isOpen && runStart >= 0)
+			{
+				int runEnd = i - 1;
+				if (runEnd - runStart + 1 >= 6)
+				{
+					AddNode(cluster, x + runStart * stepX, y + runStart * stepY);
+					AddNode(cluster, x + runEnd * stepX, y + runEnd * stepY);
+				}
+				else
+				{
+					int middle = (runStart + runEnd) / 2;
+					AddNode(cluster, x + middle * stepX, y + middle * stepY);
+				}
+				runStart = -1;
+			}
+		}
+	}
+
+	void AddNode(int cluster, int x, int y)
+	{
+		int index = m_gridPtr->Index(x, y);
+		if (m_nodeIndexAt[index] >= 0) return;		// a corner cell can be an entrance of two borders
+		Cluster& clusterRef = m_clusters[cluster];
+		m_nodeIndexAt[index] = (int) clusterRef.nodes.size();
+		clusterRef.nodes.push_back(MakeCell(x, y));
+	}
+
+	void BuildDistances(int cluster)
+	{
+		Cluster& clusterRef = m_clusters[cluster];
+		int nodeCount = (int) clusterRef.nodes.size();
+		clusterRef.distances.assign(nodeCount * nodeCount, (int) UNREACHABLE);
+		for (int from = 0; from < nodeCount; ++from)
+		{
+			ClusterBreadthFirst(cluster, clusterRef.nodes[from].x, clusterRef.nodes[from].y);
+			for (int to = 0; to < nodeCount; ++to)
+			{
+				clusterRef.distances[from * nodeCount + to] = GetLocalDistance(cluster, clusterRef.nodes[to].x, clusterRef.nodes[to].y);
+			}
+		}
+	}
+
+	// breadth first search that never leaves the cluster, results in m_localDistance and m_localParent
+	// the start and the end cell are reached even when they are rigid, but a rigid end isn't passed through
+	void ClusterBreadthFirst(int cluster, int startX, int startY, int endX = -1, int endY = -1)
+	{
+		int left = GetClusterLeft(cluster), top = GetClusterTop(cluster);
+		int width = GetClusterRight(cluster) - left + 1, height = GetClusterBottom(cluster) - top + 1;
+		std::fill(m_localDistance.begin(), m_localDistance.end(), (int) UNREACHABLE);
+
+		m_localQueue.clear();
+		m_localDistance[(startY - top) * m_clusterSize + startX - left] = 0;
+		m_localQueue.push_back(MakeCell(startX - left, startY - top));
+		for (size_t head = 0; head < m_localQueue.size(); ++head)
+		{
+			CELL cell = m_localQueue[head];
+			int distance = m_localDistance[cell.y * m_clusterSize + cell.x] + 1;
+			for (int direction = 0; direction < 4; ++direction)
+			{
+				int x = cell.x + DIRECTION_DX[direction], y = cell.y + DIRECTION_DY[direction];
+				if ((unsigned int) x >= (unsigned int) width || (unsigned int) y >= (unsigned int) height) continue;
+				int local = y * m_clusterSize + x;
+				if (m_localDistance[local] != UNREACHABLE) continue;
+				bool isRigid = m_gridPtr->IsRigid(left + x, top + y);
+				if (isRigid && (left + x != endX || top + y != endY)) continue;
+				m_localDistance[local] = distance;
+				m_localParent[local] = (unsigned char) direction;
+				if (!isRigid) m_localQueue.push_back(MakeCell(x, y));
+			}
+		}
+	}
+
+	void NewSearch()
+	{
+		m_open.clear();
+		if (++m_stamp == 0)
+		{
+			std::fill(m_stamps.begin(), m_stamps.end(), 0);
+			m_stamp = 1;
+		}
+	}
+
+	void Relax(const CELL& cellRef, int g, const CELL& parentRef, int goalX, int goalY)
+	{
+		int index = m_gridPtr->Index(cellRef.x, cellRef.y);
+		if (m_stamps[index] == m_stamp && m_g[index] <= g) return;
+		m_stamps[index] = m_stamp;
+		m_g[index] = g;
+		m_parent[index] = parentRef;
+
+		OpenNode node;
+		node.g = g;
+		node.f = g + abs(goalX - cellRef.x) + abs(goalY - cellRef.y);
+		node.cell = cellRef;
+		m_open.push_back(node);
+		std::push_heap(m_open.begin(), m_open.end());
+	}
+
+	// -------------------------
+	// Datamembers
+	// -------------------------
+	const Grid* m_gridPtr;
+	int m_clusterSize;
+	int m_clustersX, m_clustersY;
+	std::vector<Cluster> m_clusters;
+	std::vector<int> m_dirtyClusters;
+	std::vector<int> m_nodeIndexAt;			// per cell: index in the node list of its cluster, -1 when it isn't an entrance
+
+	// abstract search scratch
+	unsigned int m_stamp;
+	std::vector<unsigned int> m_stamps;
+	std::vector<int> m_g;
+	std::vector<CELL> m_parent;
+	std::vector<OpenNode> m_open;
+	std::vector<int> m_goalDistance;
+	GoalDoor m_goalDoors[4];
+	int m_goalDoorCount;
+
+	// cluster search scratch
+	std::vector<int> m_localDistance;
+	std::vector<unsigned char> m_localParent;
+	std::vector<CELL> m_localQueue;
+
+	// -------------------------
+	// Disabling default copy constructor and default assignment operator.
+	// If you get a linker error from one of these functions, your class is internally trying to use them. This is
+	// an error in your class, these declarations are deliberately made without implementation because they should never be used.
+	// -------------------------
+	HierarchicalPathFinder(const HierarchicalPathFinder& hpRef);
+	HierarchicalPathFinder& operator=(const HierarchicalPathFinder& hpRef);
+};
@@ -0,0 +1,100 @@
+//-----------------------------------------------------------------
+// LatencyHistogram Object
+// C++ Source - LatencyHistogram.cpp - version 2010 v2_07
+//-----------------------------------------------------------------
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#include "LatencyHistogram.h"
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+//-----------------------------------------------------------------
+// LatencyHistogram methods
+//-----------------------------------------------------------------
+LatencyHistogram::LatencyHistogram()
+{
+	Clear();
+}
+
+LatencyHistogram::~LatencyHistogram()
+{
+	// nothing to destroy
+}
+
+void LatencyHistogram::Record(LONGLONG nanoseconds)
+{
+	InterlockedIncrement(&m_counts[GetBucket(nanoseconds)]);
+
+	// the maximum is exact: raise it until no other thread raised it further in between
+	LONGLONG max = m_max;
+	while (nanoseconds > max)
+	{
+		LONGLONG seen = InterlockedCompareExchange64(&m_max, nanoseconds, max);
+		if (seen == max) break;
+		max = seen;
+	}
+}
+
+void LatencyHistogram::Clear()
+{
+	for (int bucket = 0; bucket < BUCKET_COUNT; ++bucket) m_counts[bucket] = 0;
+	m_max = 0;
+}
+
+LONGLONG LatencyHistogram::GetCount() const
+{
+	LONGLONG count = 0;
+	for (int bucket = 0; bucket < BUCKET_COUNT; ++bucket) count += m_counts[bucket];
+	return count;
+}
+
+LONGLONG LatencyHistogram::GetPercentile(double fraction) const
+{
+	LONGLONG count = GetCount();
+	if (count == 0) return 0;
+	LONGLONG rank = (LONGLONG) (fraction * count + 0.5);
+	if (rank < 1) rank = 1;
+
+	LONGLONG seen = 0;
+	for (int bucket = 0; bucket < BUCKET_COUNT; ++bucket)
+	{
+		seen += m_counts[bucket];
+		if (seen >= rank)
+		{
+			LONGLONG top = GetBucketTop(bucket);
+			return top < m_max ? top : m_max;
+		}
+	}
+	return m_max;
+}
+
+// the value with its highest 6 bits: values below 64 are their own bucket, then 32 buckets per power of two
+int LatencyHistogram::GetBucket(LONGLONG nanoseconds)
+{
+	if (nanoseconds < 2 * SUB_BUCKETS) return nanoseconds < 0 ? 0 : (int) nanoseconds;
+	ULONGLONG value = (ULONGLONG) nanoseconds;
+#if defined(_MSC_VER) && defined(_M_X64)
+	unsigned long highestBit;
+	_BitScanReverse64(&highestBit, value);
+#elif defined(_MSC_VER)
+	unsigned long highestBit;
+	if (_BitScanReverse(&highestBit, (unsigned long) (value >> 32))) highestBit += 32;
+	else _BitScanReverse(&highestBit, (unsigned long) value);
+#else
+	int highestBit = 63 - __builtin_clzll(value);
+#endif
+	int shift = (int) highestBit - SUB_BUCKET_BITS;
+	if (shift > MAX_SHIFT) return BUCKET_COUNT - 1;
+	return shift * SUB_BUCKETS + (int) (value >> shift);
+}
+
+LONGLONG LatencyHistogram::GetBucketTop(int bucket)
+{
+	if (bucket < 2 * SUB_BUCKETS) return bucket;
+	int shift = bucket / SUB_BUCKETS - 1;
+	LONGLONG mantissa = bucket - shift * SUB_BUCKETS;
+	return ((mantissa + 1) << shift) - 1;
+}
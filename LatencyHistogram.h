@@ -0,0 +1,88 @@
+//-----------------------------------------------------------------
+// LatencyHistogram Object
+// C++ Header - LatencyHistogram.h - version 2010 v2_07
+//
+// LatencyHistogram counts durations in nanoseconds in the style of an
+// HDR histogram: below 64 ns every value has its own bucket, above that
+// every power of two is split into 32 buckets, so any percentile is
+// known to within about 3% while the whole range up to half an hour
+// fits in 1184 counters. Recording is one interlocked increment, so
+// any number of threads can record into the same histogram.
+//
+// BUDGET_POLICY tells a match what happens to a bot that takes longer
+// than its move budget: the move counts anyway (WARN), a safe default
+// move is made instead, or the bot forfeits the match.
+//-----------------------------------------------------------------
+
+#pragma once
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+
+//-----------------------------------------------------------------
+// Enums
+//-----------------------------------------------------------------
+enum BUDGET_POLICY
+{
+	BUDGET_WARN,
+	BUDGET_DEFAULT_MOVE,
+	BUDGET_FORFEIT
+};
+
+//-----------------------------------------------------------------
+// LatencyHistogram Class
+//-----------------------------------------------------------------
+class LatencyHistogram
+{
+public:
+	static const int SUB_BUCKET_BITS = 5;
+	static const int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+	static const int MAX_SHIFT = 35;								// values go up to 2^41 - 1 ns, longer ones are counted there
+	static const int BUCKET_COUNT = (MAX_SHIFT + 2) * SUB_BUCKETS;
+
+	//---------------------------
+	// Constructor(s)
+	//---------------------------
+	LatencyHistogram();
+
+	//---------------------------
+	// Destructor
+	//---------------------------
+	virtual ~LatencyHistogram();
+
+	//---------------------------
+	// General Methods
+	//---------------------------
+	void Record(LONGLONG nanoseconds);		// lock free, from any thread
+	void Clear();							// not while anyone records
+
+	LONGLONG GetCount() const;
+	LONGLONG GetMax() const { return m_max; }
+
+	// the smallest value at or above the given fraction (0.5 for the median) of the recorded values, rounded up to its bucket
+	LONGLONG GetPercentile(double fraction) const;
+
+private:
+	// -------------------------
+	// Member functions
+	// -------------------------
+	static int GetBucket(LONGLONG nanoseconds);
+	static LONGLONG GetBucketTop(int bucket);
+
+	// -------------------------
+	// Datamembers
+	// -------------------------
+	volatile LONG m_counts[BUCKET_COUNT];
+	volatile LONGLONG m_max;
+
+	// -------------------------
+	// Disabling default copy constructor and default assignment operator.
+	// If you get a linker error from one of these functions, your class is internally trying to use them. This is
+	// an error in your class, these declarations are deliberately made without implementation because they should never be used.
+	// -------------------------
+	LatencyHistogram(const LatencyHistogram& lhRef);
+	LatencyHistogram& operator=(const LatencyHistogram& lhRef);
+};
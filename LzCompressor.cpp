@@ -0,0 +1,129 @@
+//-----------------------------------------------------------------
+// LzCompressor Object
+// C++ Source - LzCompressor.cpp - version 2010 v2_07
+//-----------------------------------------------------------------
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#include "LzCompressor.h"
+#include <string.h>
+#include <stdint.h>
+
+static inline uint32_t Read32(const unsigned char* bytesPtr)
+{
+	uint32_t value;
+	memcpy(&value, bytesPtr, sizeof(value));
+	return value;
+}
+
+//-----------------------------------------------------------------
+// LzCompressor methods
+//-----------------------------------------------------------------
+LzCompressor::LzCompressor() : m_table(1 << HASH_BITS)
+{
+}
+
+LzCompressor::~LzCompressor()
+{
+	// nothing to destroy
+}
+
+void LzCompressor::Compress(const unsigned char* inputPtr, int size, std::vector<unsigned char>& outputRef)
+{
+	m_table.assign(m_table.size(), -1);
+	int anchor = 0, position = 0;
+	while (position + MIN_MATCH <= size)
+	{
+		uint32_t sequence = Read32(inputPtr + position);
+		int& entryRef = m_table[(sequence * 2654435761U) >> (32 - HASH_BITS)];
+		int candidate = entryRef;
+		entryRef = position;
+		if (candidate < 0 || position - candidate > MAX_OFFSET || Read32(inputPtr + candidate) != sequence)
+		{
+			++position;
+			continue;
+		}
+
+		int length = MIN_MATCH;
+		while (position + length < size && inputPtr[candidate + length] == inputPtr[position + length]) ++length;
+
+		int literals = position - anchor;
+		int extraLength = length - MIN_MATCH;
+		outputRef.push_back((unsigned char) (((literals < 15 ? literals : 15) << 4) | (extraLength < 15 ? extraLength : 15)));
+		if (literals >= 15) PutLength(outputRef, literals - 15);
+		outputRef.insert(outputRef.end(), inputPtr + anchor, inputPtr + position);
+		int offset = position - candidate;
+		outputRef.push_back((unsigned char) offset);
+		outputRef.push_back((unsigned char) (offset >> 8));
+		if (extraLength >= 15) PutLength(outputRef, extraLength - 15);
+
+		position += length;
+		anchor = position;
+	}
+
+	int literals = size - anchor;
+	outputRef.push_back((unsigned char) ((literals < 15 ? literals : 15) << 4));
+	if (literals >= 15) PutLength(outputRef, literals - 15);
+	outputRef.insert(outputRef.end(), inputPtr + anchor, inputPtr + size);
+}
+
+int LzCompressor::Decompress(const unsigned char* inputPtr, int size, unsigned char* outputPtr, int outputSize)
+{
+	const unsigned char* endPtr = inputPtr + size;
+	int written = 0;
+	while (inputPtr < endPtr)
+	{
+		int token = *inputPtr++;
+		int literals = token >> 4;
+		if (literals == 15)
+		{
+			int part;
+			do
+			{
+				if (inputPtr == endPtr) return -1;
+				part = *inputPtr++;
+				literals += part;
+			}
+			while (part == 255);
+		}
+		if (literals > endPtr - inputPtr || literals > outputSize - written) return -1;
+		memcpy(outputPtr + written, inputPtr, literals);
+		inputPtr += literals;
+		written += literals;
+		if (inputPtr == endPtr) break;		// the last sequence has no match
+
+		if (endPtr - inputPtr < 2) return -1;
+		int offset = inputPtr[0] | (inputPtr[1] << 8);
+		inputPtr += 2;
+		int length = (token & 15) + MIN_MATCH;
+		if ((token & 15) == 15)
+		{
+			int part;
+			do
+			{
+				if (inputPtr == endPtr) return -1;
+				part = *inputPtr++;
+				length += part;
+			}
+			while (part == 255);
+		}
+		if (offset == 0 || offset > written || length > outputSize - written) return -1;
+
+		// byte by byte, a match may overlap the bytes it produces
+		const unsigned char* matchPtr = outputPtr + written - offset;
+		for (int i = 0; i < length; ++i) outputPtr[written + i] = matchPtr[i];
+		written += length;
+	}
+	return written;
+}
+
+void LzCompressor::PutLength(std::vector<unsigned char>& outputRef, int length)
+{
+	while (length >= 255)
+	{
+		outputRef.push_back(255);
+		length -= 255;
+	}
+	outputRef.push_back((unsigned char) length);
+}
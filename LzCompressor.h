@@ -0,0 +1,67 @@
+//-----------------------------------------------------------------
+// LzCompressor Object
+// C++ Header - LzCompressor.h - version 2010 v2_07
+//
+// LzCompressor is a small byte oriented LZ77 compressor in the spirit of
+// LZ4: every sequence is a token byte (literal count in the high nibble,
+// match length - 4 in the low one, 15 meaning more length bytes follow),
+// the literals, and a 16 bit offset back to the match. The last sequence
+// has literals only. It trades ratio for speed, so compressing output
+// costs little next to producing it.
+//-----------------------------------------------------------------
+
+#pragma once
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#include <vector>
+
+//-----------------------------------------------------------------
+// LzCompressor Class
+//-----------------------------------------------------------------
+class LzCompressor
+{
+public:
+	static const int HASH_BITS = 12;
+	static const int MIN_MATCH = 4;
+	static const int MAX_OFFSET = 65535;
+
+	//---------------------------
+	// Constructor(s)
+	//---------------------------
+	LzCompressor();
+
+	//---------------------------
+	// Destructor
+	//---------------------------
+	virtual ~LzCompressor();
+
+	//---------------------------
+	// General Methods
+	//---------------------------
+	// appends the compressed bytes to outputRef
+	void Compress(const unsigned char* inputPtr, int size, std::vector<unsigned char>& outputRef);
+
+	// returns the number of bytes written to outputPtr, or -1 when the input is damaged or doesn't fit
+	static int Decompress(const unsigned char* inputPtr, int size, unsigned char* outputPtr, int outputSize);
+
+private:
+	// -------------------------
+	// Member functions
+	// -------------------------
+	static void PutLength(std::vector<unsigned char>& outputRef, int length);
+
+	// -------------------------
+	// Datamembers
+	// -------------------------
+	std::vector<int> m_table;		// the last position of every hashed 4 byte sequence
+
+	// -------------------------
+	// Disabling default copy constructor and default assignment operator.
+	// If you get a linker error from one of these functions, your class is internally trying to use them. This is
+	// an error in your class, these declarations are deliberately made without implementation because they should never be used.
+	// -------------------------
+	LzCompressor(const LzCompressor& lcRef);
+	LzCompressor& operator=(const LzCompressor& lcRef);
+};
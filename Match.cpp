@@ -0,0 +1,259 @@
+//-----------------------------------------------------------------
+// Match Object
+// C++ Source - Match.cpp - version 2010 v2_07
+//-----------------------------------------------------------------
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#include "Match.h"
+
+//-----------------------------------------------------------------
+// Match methods
+//-----------------------------------------------------------------
+Match::Match() : m_tick(0), m_winner(NO_WINNER), m_isOver(true), m_matchId(0), m_statisticsPtr(NULL), m_areaInterval(0), m_budget(0), m_budgetPolicy(BUDGET_WARN), m_listenerPtr(NULL), m_isSimultaneous(false)
+{
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+	m_nanosecondsPerCount = 1e9 / (double) frequency.QuadPart;
+	for (int player = 0; player < PLAYER_COUNT; ++player)
+	{
+		m_botPtrs[player] = NULL;
+		m_histogramPtrs[player] = NULL;
+		m_lossCauses[player] = LOSS_NONE;
+		m_cellsFilled[player] = m_survivalTicks[player] = m_overruns[player] = 0;
+	}
+}
+
+Match::~Match()
+{
+	// the bots belong to the caller
+}
+
+void Match::Start(const ArenaGrid& arenaRef, Bot* firstBotPtr, Bot* secondBotPtr, CELL firstStart, CELL secondStart, uint32_t matchId, uint64_t seed)
+{
+	m_arena = arenaRef;
+	m_botPtrs[0] = firstBotPtr;
+	m_botPtrs[1] = secondBotPtr;
+	m_positions[0] = firstStart;
+	m_positions[1] = secondStart;
+	for (int player = 0; player < PLAYER_COUNT; ++player)
+	{
+		m_lossCauses[player] = LOSS_NONE;
+		m_cellsFilled[player] = m_survivalTicks[player] = m_overruns[player] = 0;
+		m_botPtrs[player]->StartMatch(player, seed * PLAYER_COUNT + player);
+	}
+	m_tick = 0;
+	m_winner = NO_WINNER;
+	m_isOver = false;
+	m_matchId = matchId;
+}
+
+bool Match::Tick()
+{
+	if (m_isOver) return false;
+	if (m_isSimultaneous) return TickSimultaneously();
+
+	for (int player = 0; player < PLAYER_COUNT && !m_isOver; ++player)
+	{
+		CELL& headRef = m_positions[player];
+		if (!m_arena.IsRigid(headRef.x, headRef.y))
+		{
+			m_arena.SetRigid(headRef.x, headRef.y);
+			++m_cellsFilled[player];
+		}
+		if (m_arena.IsImmobilised(headRef.x, headRef.y))
+		{
+			Lose(player, LOSS_IMMOBILISED);
+			break;
+		}
+
+		LONGLONG nanoseconds = 0;
+		int direction = ChooseTimedDirection(player, nanoseconds);
+		if (direction < 0)
+		{
+			Lose(player, LOSS_FORFEIT);
+			break;
+		}
+
+		if (m_listenerPtr != NULL) m_listenerPtr->MoveChosen(*this, player, direction);
+
+		// the sentinel ring keeps every neighbour readable, a rigid one keeps the player in place
+		int step = 1 - m_arena.GetCell(headRef.x + DIRECTION_DX[direction], headRef.y + DIRECTION_DY[direction]);
+		headRef.x += DIRECTION_DX[direction] * step;
+		headRef.y += DIRECTION_DY[direction] * step;
+		m_survivalTicks[player] = m_tick + 1;
+		RecordTickSample(player, nanoseconds);
+	}
+	++m_tick;
+
+	if (m_isOver) Finish();
+	return !m_isOver;
+}
+
+// every head is rigid and every bot decides on the same arena before anybody moves; players that lose in the same tick draw
+bool Match::TickSimultaneously()
+{
+	for (int player = 0; player < PLAYER_COUNT; ++player)
+	{
+		CELL& headRef = m_positions[player];
+		if (!m_arena.IsRigid(headRef.x, headRef.y))
+		{
+			m_arena.SetRigid(headRef.x, headRef.y);
+			++m_cellsFilled[player];
+		}
+	}
+	for (int player = 0; player < PLAYER_COUNT; ++player)
+	{
+		if (m_arena.IsImmobilised(m_positions[player].x, m_positions[player].y)) m_lossCauses[player] = LOSS_IMMOBILISED;
+	}
+
+	int directions[PLAYER_COUNT];
+	LONGLONG nanoseconds[PLAYER_COUNT];
+	if (!LoseSimultaneously())
+	{
+		for (int player = 0; player < PLAYER_COUNT; ++player)
+		{
+			nanoseconds[player] = 0;
+			directions[player] = ChooseTimedDirection(player, nanoseconds[player]);
+			if (directions[player] < 0) m_lossCauses[player] = LOSS_FORFEIT;
+		}
+	}
+	if (!LoseSimultaneously())
+	{
+		if (m_listenerPtr != NULL)
+		{
+			for (int player = 0; player < PLAYER_COUNT; ++player) m_listenerPtr->MoveChosen(*this, player, directions[player]);
+		}
+
+		m_resolver.Gather(m_arena, m_positions, directions, PLAYER_COUNT);
+		m_resolver.Resolve();
+		m_resolver.Commit(m_arena, m_positions);
+		for (int player = 0; player < PLAYER_COUNT; ++player)
+		{
+			MOVE_OUTCOME outcome = m_resolver.GetOutcome(player);
+			if (outcome == MOVE_DONE) ++m_cellsFilled[player];
+			else if (outcome == MOVE_COLLIDED) m_lossCauses[player] = LOSS_COLLISION;
+			m_survivalTicks[player] = m_tick + 1;
+			RecordTickSample(player, nanoseconds[player]);
+		}
+		LoseSimultaneously();
+	}
+	++m_tick;
+
+	if (m_isOver) Finish();
+	return !m_isOver;
+}
+
+int Match::Play(int maxTicks)
+{
+	while (m_tick < maxTicks && Tick())
+	{
+	}
+	if (!m_isOver)
+	{
+		// out of time: a draw
+		m_isOver = true;
+		Finish();
+	}
+	return m_winner;
+}
+
+void Match::SetStatistics(StatisticsBuffer* bufferPtr, int areaInterval)
+{
+	m_statisticsPtr = bufferPtr;
+	m_areaInterval = areaInterval;
+}
+
+void Match::SetBudget(LONGLONG nanoseconds, BUDGET_POLICY policy)
+{
+	m_budget = nanoseconds;
+	m_budgetPolicy = policy;
+}
+
+void Match::Lose(int player, LOSS_CAUSE cause)
+{
+	m_lossCauses[player] = cause;
+	m_winner = 1 - player;
+	m_isOver = true;
+}
+
+// ends the match when a loss cause has been set this tick; true when it did
+bool Match::LoseSimultaneously()
+{
+	int loser = NO_WINNER, loserCount = 0;
+	for (int player = 0; player < PLAYER_COUNT; ++player)
+	{
+		if (m_lossCauses[player] == LOSS_NONE) continue;
+		loser = player;
+		++loserCount;
+	}
+	if (loserCount == 0) return false;
+	m_winner = loserCount == 1 ? 1 - loser : NO_WINNER;
+	m_isOver = true;
+	return true;
+}
+
+// times the decision and applies the budget policy; -1 when the bot forfeits
+int Match::ChooseTimedDirection(int player, LONGLONG& nanosecondsRef)
+{
+	LARGE_INTEGER before, after;
+	QueryPerformanceCounter(&before);
+	int direction = m_botPtrs[player]->ChooseDirection(m_arena, m_positions, player) & 3;
+	QueryPerformanceCounter(&after);
+	nanosecondsRef = (LONGLONG) ((after.QuadPart - before.QuadPart) * m_nanosecondsPerCount);
+	if (m_histogramPtrs[player] != NULL) m_histogramPtrs[player]->Record(nanosecondsRef);
+
+	if (m_budget > 0 && nanosecondsRef > m_budget)
+	{
+		++m_overruns[player];
+		if (m_budgetPolicy == BUDGET_FORFEIT) return -1;
+		if (m_budgetPolicy == BUDGET_DEFAULT_MOVE) direction = ChooseDefaultDirection(player);
+	}
+	return direction;
+}
+
+void Match::RecordTickSample(int player, LONGLONG nanoseconds)
+{
+	if (m_statisticsPtr == NULL) return;
+
+	const CELL& headRef = m_positions[player];
+	TICK_SAMPLE sample;
+	sample.matchId = m_matchId;
+	sample.tick = m_tick;
+	sample.player = player;
+	sample.cellsFilled = m_cellsFilled[player];
+	sample.reachableArea = -1;
+	if (m_areaInterval > 0 && m_tick % m_areaInterval == 0) sample.reachableArea = m_pathFinder.BreadthFirst(m_arena, headRef.x, headRef.y) - 1;
+	sample.decisionNanoseconds = (uint32_t) nanoseconds;
+	m_statisticsPtr->RecordTick(sample);
+}
+
+void Match::Finish()
+{
+	if (m_listenerPtr != NULL) m_listenerPtr->MatchFinished(*this);
+	if (m_statisticsPtr == NULL) return;
+
+	MATCH_SAMPLE sample;
+	sample.matchId = m_matchId;
+	sample.tickCount = m_tick;
+	sample.winner = m_winner;
+	for (int player = 0; player < PLAYER_COUNT; ++player)
+	{
+		sample.lossCauses[player] = m_lossCauses[player];
+		sample.cellsFilled[player] = m_cellsFilled[player];
+		sample.survivalTicks[player] = m_survivalTicks[player];
+	}
+	m_statisticsPtr->RecordMatch(sample);
+}
+
+// the move a bot makes when it runs out of time: the first free neighbour, left, up, right, down
+int Match::ChooseDefaultDirection(int player) const
+{
+	const CELL& headRef = m_positions[player];
+	for (int direction = 0; direction < 4; ++direction)
+	{
+		if (!m_arena.IsRigid(headRef.x + DIRECTION_DX[direction], headRef.y + DIRECTION_DY[direction])) return direction;
+	}
+	return 0;
+}
@@ -0,0 +1,136 @@
+//-----------------------------------------------------------------
+// Match Object
+// C++ Header - Match.h - version 2010 v2_07
+//
+// Match plays AIchallenge between two bots without the game engine, so
+// tournaments, tuners and benchmarks can run thousands of matches a
+// second. By default the players move one after the other, as GameCycle
+// used to: each leaves its cell rigid when it moves on, a move into a
+// rigid cell keeps the player where it is, and a player without a free
+// neighbour loses. Every move can be recorded in a StatisticsBuffer and
+// followed by a MatchListener.
+//
+// Every decision is timed. A match can give the bots a move budget: a
+// bot can't be interrupted halfway, so a slow decision is dealt with
+// once it returns, by its BUDGET_POLICY, and counted as an overrun.
+// The times can be collected per bot in LatencyHistograms.
+//
+// A simultaneous match has the rules GameCycle has now: every bot decides
+// on the same arena and a TickResolver moves them all at once, so nobody
+// sees another's new wall first. Players moving into the same cell both
+// lose, a draw.
+//-----------------------------------------------------------------
+
+#pragma once
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#include "ArenaGrid.h"
+#include "Bot.h"
+#include "MatchStatistics.h"
+#include "LatencyHistogram.h"
+#include "MatchListener.h"
+#include "PathFinder.h"
+#include "TickResolver.h"
+#include <stdint.h>
+
+//-----------------------------------------------------------------
+// Match Class
+//-----------------------------------------------------------------
+class Match
+{
+public:
+	static const int PLAYER_COUNT = 2;
+	static const int NO_WINNER = -1;
+
+	//---------------------------
+	// Constructor(s)
+	//---------------------------
+	Match();
+
+	//---------------------------
+	// Destructor
+	//---------------------------
+	virtual ~Match();
+
+	//---------------------------
+	// General Methods
+	//---------------------------
+
+	// copies the arena; the bots are not owned and may be reused for the next match
+	void Start(const ArenaGrid& arenaRef, Bot* firstBotPtr, Bot* secondBotPtr, CELL firstStart, CELL secondStart, uint32_t matchId, uint64_t seed);
+
+	bool Tick();					// one move of every player, false once the match is over
+	int Play(int maxTicks);			// plays until someone loses or maxTicks is reached (a draw), returns the winner or NO_WINNER
+
+	// areaInterval: every how many ticks the reachable area is measured, 0 for never
+	void SetStatistics(StatisticsBuffer* bufferPtr, int areaInterval = 16);
+
+	// 0 nanoseconds for no budget; holds for the following matches too
+	void SetBudget(LONGLONG nanoseconds, BUDGET_POLICY policy);
+
+	// the histogram the decision times of a player are recorded in, NULL for none; it may be shared with other matches and threads
+	void SetLatencyHistogram(int player, LatencyHistogram* histogramPtr) { m_histogramPtrs[player] = histogramPtr; }
+
+	// NULL for none; holds for the following matches too
+	void SetListener(MatchListener* listenerPtr) { m_listenerPtr = listenerPtr; }
+
+	// true for the rules of GameCycle, false (the default) for the players moving one after the other; holds for the following matches too
+	void SetSimultaneous(bool isSimultaneous) { m_isSimultaneous = isSimultaneous; }
+
+	bool IsOver() const { return m_isOver; }
+	int GetWinner() const { return m_winner; }
+	int GetTickCount() const { return m_tick; }
+	LOSS_CAUSE GetLossCause(int player) const { return m_lossCauses[player]; }
+	int GetCellsFilled(int player) const { return m_cellsFilled[player]; }
+	int GetOverrunCount(int player) const { return m_overruns[player]; }		// decisions over budget this match
+	CELL GetPosition(int player) const { return m_positions[player]; }
+	const CELL* GetPositions() const { return m_positions; }		// the head of every player, as the bots get them
+	const ArenaGrid& GetArena() const { return m_arena; }
+
+private:
+	// -------------------------
+	// Member functions
+	// -------------------------
+	void Lose(int player, LOSS_CAUSE cause);
+	bool LoseSimultaneously();
+	bool TickSimultaneously();
+	int ChooseTimedDirection(int player, LONGLONG& nanosecondsRef);
+	void RecordTickSample(int player, LONGLONG nanoseconds);
+	void Finish();
+	int ChooseDefaultDirection(int player) const;
+
+	// -------------------------
+	// Datamembers
+	// -------------------------
+	ArenaGrid m_arena;
+	Bot* m_botPtrs[PLAYER_COUNT];
+	CELL m_positions[PLAYER_COUNT];
+	LOSS_CAUSE m_lossCauses[PLAYER_COUNT];
+	int m_cellsFilled[PLAYER_COUNT], m_survivalTicks[PLAYER_COUNT];
+	int m_tick, m_winner;
+	bool m_isOver;
+	uint32_t m_matchId;
+
+	StatisticsBuffer* m_statisticsPtr;
+	int m_areaInterval;
+	double m_nanosecondsPerCount;		// performance counter to nanoseconds
+
+	LONGLONG m_budget;
+	BUDGET_POLICY m_budgetPolicy;
+	LatencyHistogram* m_histogramPtrs[PLAYER_COUNT];
+	int m_overruns[PLAYER_COUNT];
+	MatchListener* m_listenerPtr;
+	PathFinder<ArenaGrid> m_pathFinder;
+	bool m_isSimultaneous;
+	TickResolver m_resolver;
+
+	// -------------------------
+	// Disabling default copy constructor and default assignment operator.
+	// If you get a linker error from one of these functions, your class is internally trying to use them. This is
+	// an error in your class, these declarations are deliberately made without implementation because they should never be used.
+	// -------------------------
+	Match(const Match& mRef);
+	Match& operator=(const Match& mRef);
+};
@@ -0,0 +1,22 @@
+//-----------------------------------------------------------------
+// MatchListener Interface
+// C++ Header - MatchListener.h - version 2010 v2_07
+//
+// Interface for classes that follow a headless Match move by move, e.g.
+// to turn the positions and moves into training samples (see SelfPlay).
+//-----------------------------------------------------------------
+
+#pragma once
+
+class Match;
+
+//-----------------------------------------------------------------
+// MatchListener Class
+//-----------------------------------------------------------------
+class MatchListener
+{
+public:
+	virtual ~MatchListener() {}														// virtual destructor for polymorphism
+	virtual void MoveChosen(const Match& matchRef, int player, int direction) = 0;	// called before the move is made, the cell it leaves is rigid already
+	virtual void MatchFinished(const Match& matchRef) = 0;							// called once the winner is known, also for a draw
+};
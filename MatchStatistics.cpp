@@ -0,0 +1,329 @@
+//-----------------------------------------------------------------
+// MatchStatistics Object
+// C++ Source - MatchStatistics.cpp - version 2010 v2_07
+//-----------------------------------------------------------------
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#include "MatchStatistics.h"
+#include <string.h>
+
+//-----------------------------------------------------------------
+// Output helpers
+//-----------------------------------------------------------------
+static const uint32_t FILE_VERSION = 1;
+static const uint32_t BLOCK_TICKS = 1;
+static const uint32_t BLOCK_MATCHES = 2;
+
+template<class Value>
+static void AppendValue(std::vector<char>& outputRef, Value value)
+{
+	size_t start = outputRef.size();
+	outputRef.resize(start + sizeof(Value));
+	memcpy(&outputRef[start], &value, sizeof(Value));
+}
+
+// the columns are written into a buffer sized beforehand
+template<class Value>
+static char* PutValue(char* outputPtr, Value value)
+{
+	memcpy(outputPtr, &value, sizeof(Value));
+	return outputPtr + sizeof(Value);
+}
+
+static void AppendText(std::vector<char>& outputRef, const char* textPtr)
+{
+	outputRef.insert(outputRef.end(), textPtr, textPtr + strlen(textPtr));
+}
+
+static void AppendNumber(std::vector<char>& outputRef, LONGLONG number, char separator)
+{
+	char digits[24];
+	int count = 0;
+	bool isNegative = number < 0;
+	ULONGLONG rest = isNegative ? (ULONGLONG) -number : (ULONGLONG) number;
+	do
+	{
+		digits[count++] = (char) ('0' + rest % 10);
+		rest /= 10;
+	}
+	while (rest != 0);
+	if (isNegative) outputRef.push_back('-');
+	while (count > 0) outputRef.push_back(digits[--count]);
+	outputRef.push_back(separator);
+}
+
+//-----------------------------------------------------------------
+// StatisticsBuffer methods
+//-----------------------------------------------------------------
+void StatisticsBuffer::Flush()
+{
+	if (!m_blockPtr->ticks.empty() || !m_blockPtr->matches.empty()) Submit();
+}
+
+void StatisticsBuffer::Submit()
+{
+	m_blockPtr = m_ownerPtr->Exchange(m_blockPtr);
+}
+
+//-----------------------------------------------------------------
+// MatchStatistics methods
+//-----------------------------------------------------------------
+MatchStatistics::MatchStatistics() : m_blockCount(0), m_isClosing(false), m_file(INVALID_HANDLE_VALUE), m_thread(NULL), m_isCSV(false), m_writtenTicks(0), m_writtenMatches(0)
+{
+	m_tlsIndex = TlsAlloc();
+	InitializeCriticalSection(&m_lock);
+	InitializeConditionVariable(&m_blockQueued);
+	InitializeConditionVariable(&m_blockFreed);
+}
+
+MatchStatistics::~MatchStatistics()
+{
+	Close();
+	for (size_t i = 0; i < m_buffers.size(); ++i)
+	{
+		delete m_buffers[i]->m_blockPtr;
+		delete m_buffers[i];
+	}
+	for (size_t i = 0; i < m_freeBlocks.size(); ++i)
+	{
+		delete m_freeBlocks[i];
+	}
+	TlsFree(m_tlsIndex);
+	DeleteCriticalSection(&m_lock);
+}
+
+bool MatchStatistics::Open(TCHAR* filenamePtr, bool isCSV)
+{
+	Close();
+	HANDLE file = CreateFile(filenamePtr, GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE) return false;
+
+	m_isCSV = isCSV;
+	m_writtenTicks = m_writtenMatches = 0;
+	m_output.clear();
+	if (isCSV)
+	{
+		AppendText(m_output, "# t,match,tick,player,cells filled,reachable area,decision ns\n");
+		AppendText(m_output, "# m,match,ticks,winner,cause 0,cause 1,cells filled 0,cells filled 1,survival ticks 0,survival ticks 1\n");
+	}
+	else
+	{
+		AppendText(m_output, "AIMS");
+		AppendValue(m_output, FILE_VERSION);
+	}
+
+	// samples recorded while no file was open are dropped; the writer thread only starts once the header is written
+	EnterCriticalSection(&m_lock);
+	for (size_t i = 0; i < m_buffers.size(); ++i)
+	{
+		m_buffers[i]->m_blockPtr->ticks.clear();
+		m_buffers[i]->m_blockPtr->matches.clear();
+	}
+	m_file = file;
+	LeaveCriticalSection(&m_lock);
+	WriteOutput();
+	m_thread = CreateThread(NULL, 0, ThreadProc, this, 0, NULL);
+	return true;
+}
+
+void MatchStatistics::Close()
+{
+	if (!IsOpen()) return;
+
+	EnterCriticalSection(&m_lock);
+	std::vector<StatisticsBuffer*> buffers(m_buffers);
+	LeaveCriticalSection(&m_lock);
+	for (size_t i = 0; i < buffers.size(); ++i)
+	{
+		buffers[i]->Flush();
+	}
+
+	EnterCriticalSection(&m_lock);
+	m_isClosing = true;
+	WakeAllConditionVariable(&m_blockQueued);
+	LeaveCriticalSection(&m_lock);
+	WaitForSingleObject(m_thread, INFINITE);
+	CloseHandle(m_thread);
+	m_thread = NULL;
+
+	EnterCriticalSection(&m_lock);
+	CloseHandle(m_file);
+	m_file = INVALID_HANDLE_VALUE;
+	m_isClosing = false;
+	LeaveCriticalSection(&m_lock);
+}
+
+StatisticsBuffer* MatchStatistics::GetThreadBuffer()
+{
+	StatisticsBuffer* bufferPtr = (StatisticsBuffer*) TlsGetValue(m_tlsIndex);
+	if (bufferPtr != NULL) return bufferPtr;
+
+	STATISTICS_BLOCK* blockPtr = new STATISTICS_BLOCK;
+	blockPtr->ticks.reserve(StatisticsBuffer::BLOCK_SAMPLES);
+	bufferPtr = new StatisticsBuffer(this, blockPtr);
+	EnterCriticalSection(&m_lock);
+	m_buffers.push_back(bufferPtr);
+	++m_blockCount;
+	LeaveCriticalSection(&m_lock);
+	TlsSetValue(m_tlsIndex, bufferPtr);
+	return bufferPtr;
+}
+
+STATISTICS_BLOCK* MatchStatistics::Exchange(STATISTICS_BLOCK* fullBlockPtr)
+{
+	EnterCriticalSection(&m_lock);
+	if (m_file == INVALID_HANDLE_VALUE)
+	{
+		// nobody is listening: the block is emptied and used again
+		LeaveCriticalSection(&m_lock);
+		fullBlockPtr->ticks.clear();
+		fullBlockPtr->matches.clear();
+		return fullBlockPtr;
+	}
+
+	m_queue.push_back(fullBlockPtr);
+	WakeConditionVariable(&m_blockQueued);
+	while (m_freeBlocks.empty() && m_blockCount >= MAX_BLOCKS)
+	{
+		SleepConditionVariableCS(&m_blockFreed, &m_lock, INFINITE);
+	}
+
+	STATISTICS_BLOCK* blockPtr;
+	if (!m_freeBlocks.empty())
+	{
+		blockPtr = m_freeBlocks.back();
+		m_freeBlocks.pop_back();
+	}
+	else
+	{
+		blockPtr = new STATISTICS_BLOCK;
+		blockPtr->ticks.reserve(StatisticsBuffer::BLOCK_SAMPLES);
+		++m_blockCount;
+	}
+	LeaveCriticalSection(&m_lock);
+	return blockPtr;
+}
+
+DWORD WINAPI MatchStatistics::ThreadProc(LPVOID parameter)
+{
+	((MatchStatistics*) parameter)->WriterLoop();
+	return 0;
+}
+
+void MatchStatistics::WriterLoop()
+{
+	std::vector<STATISTICS_BLOCK*> blocks;
+	for (;;)
+	{
+		EnterCriticalSection(&m_lock);
+		while (m_queue.empty() && !m_isClosing)
+		{
+			SleepConditionVariableCS(&m_blockQueued, &m_lock, INFINITE);
+		}
+		if (m_queue.empty())
+		{
+			// closing, and everything is written
+			LeaveCriticalSection(&m_lock);
+			return;
+		}
+		blocks.swap(m_queue);
+		LeaveCriticalSection(&m_lock);
+
+		// the disk is only touched outside the lock
+		for (size_t i = 0; i < blocks.size(); ++i)
+		{
+			WriteBlock(*blocks[i]);
+			blocks[i]->ticks.clear();
+			blocks[i]->matches.clear();
+		}
+
+		EnterCriticalSection(&m_lock);
+		m_freeBlocks.insert(m_freeBlocks.end(), blocks.begin(), blocks.end());
+		WakeAllConditionVariable(&m_blockFreed);
+		LeaveCriticalSection(&m_lock);
+		blocks.clear();
+	}
+}
+
+void MatchStatistics::WriteBlock(const STATISTICS_BLOCK& blockRef)
+{
+	const std::vector<TICK_SAMPLE>& ticksRef = blockRef.ticks;
+	const std::vector<MATCH_SAMPLE>& matchesRef = blockRef.matches;
+	m_output.clear();
+
+	if (m_isCSV)
+	{
+		for (size_t i = 0; i < ticksRef.size(); ++i)
+		{
+			const TICK_SAMPLE& sampleRef = ticksRef[i];
+			AppendText(m_output, "t,");
+			AppendNumber(m_output, sampleRef.matchId, ',');
+			AppendNumber(m_output, sampleRef.tick, ',');
+			AppendNumber(m_output, sampleRef.player, ',');
+			AppendNumber(m_output, sampleRef.cellsFilled, ',');
+			AppendNumber(m_output, sampleRef.reachableArea, ',');
+			AppendNumber(m_output, sampleRef.decisionNanoseconds, '\n');
+		}
+		for (size_t i = 0; i < matchesRef.size(); ++i)
+		{
+			const MATCH_SAMPLE& sampleRef = matchesRef[i];
+			AppendText(m_output, "m,");
+			AppendNumber(m_output, sampleRef.matchId, ',');
+			AppendNumber(m_output, sampleRef.tickCount, ',');
+			AppendNumber(m_output, sampleRef.winner, ',');
+			AppendNumber(m_output, sampleRef.lossCauses[0], ',');
+			AppendNumber(m_output, sampleRef.lossCauses[1], ',');
+			AppendNumber(m_output, sampleRef.cellsFilled[0], ',');
+			AppendNumber(m_output, sampleRef.cellsFilled[1], ',');
+			AppendNumber(m_output, sampleRef.survivalTicks[0], ',');
+			AppendNumber(m_output, sampleRef.survivalTicks[1], '\n');
+		}
+	}
+	else
+	{
+		// one column after the other, so every column compresses and loads on its own
+		size_t tickCount = ticksRef.size(), matchCount = matchesRef.size();
+		size_t tickBytes = tickCount == 0 ? 0 : 8 + tickCount * 21;
+		size_t matchBytes = matchCount == 0 ? 0 : 8 + matchCount * 27;
+		m_output.resize(tickBytes + matchBytes);
+		char* outputPtr = m_output.empty() ? NULL : &m_output[0];
+		if (tickCount > 0)
+		{
+			outputPtr = PutValue(outputPtr, BLOCK_TICKS);
+			outputPtr = PutValue(outputPtr, (uint32_t) tickCount);
+			for (size_t i = 0; i < tickCount; ++i) outputPtr = PutValue(outputPtr, ticksRef[i].matchId);
+			for (size_t i = 0; i < tickCount; ++i) outputPtr = PutValue(outputPtr, ticksRef[i].tick);
+			for (size_t i = 0; i < tickCount; ++i) outputPtr = PutValue(outputPtr, (uint8_t) ticksRef[i].player);
+			for (size_t i = 0; i < tickCount; ++i) outputPtr = PutValue(outputPtr, (uint32_t) ticksRef[i].cellsFilled);
+			for (size_t i = 0; i < tickCount; ++i) outputPtr = PutValue(outputPtr, (int32_t) ticksRef[i].reachableArea);
+			for (size_t i = 0; i < tickCount; ++i) outputPtr = PutValue(outputPtr, ticksRef[i].decisionNanoseconds);
+		}
+		if (matchCount > 0)
+		{
+			outputPtr = PutValue(outputPtr, BLOCK_MATCHES);
+			outputPtr = PutValue(outputPtr, (uint32_t) matchCount);
+			for (size_t i = 0; i < matchCount; ++i) outputPtr = PutValue(outputPtr, matchesRef[i].matchId);
+			for (size_t i = 0; i < matchCount; ++i) outputPtr = PutValue(outputPtr, (uint32_t) matchesRef[i].tickCount);
+			for (size_t i = 0; i < matchCount; ++i) outputPtr = PutValue(outputPtr, (int8_t) matchesRef[i].winner);
+			for (int player = 0; player < 2; ++player)
+			{
+				for (size_t i = 0; i < matchCount; ++i) outputPtr = PutValue(outputPtr, (uint8_t) matchesRef[i].lossCauses[player]);
+				for (size_t i = 0; i < matchCount; ++i) outputPtr = PutValue(outputPtr, (uint32_t) matchesRef[i].cellsFilled[player]);
+				for (size_t i = 0; i < matchCount; ++i) outputPtr = PutValue(outputPtr, (uint32_t) matchesRef[i].survivalTicks[player]);
+			}
+		}
+	}
+
+	WriteOutput();
+	m_writtenTicks += ticksRef.size();
+	m_writtenMatches += matchesRef.size();
+}
+
+void MatchStatistics::WriteOutput()
+{
+	if (m_output.empty()) return;
+	DWORD bytesWritten = 0;
+	WriteFile(m_file, &m_output[0], (DWORD) m_output.size(), &bytesWritten, NULL);
+}
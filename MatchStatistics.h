@@ -0,0 +1,199 @@
+//-----------------------------------------------------------------
+// MatchStatistics Object
+// C++ Header - MatchStatistics.h - version 2010 v2_07
+//
+// MatchStatistics collects a sample for every player and tick and a
+// summary for every match, and writes them to a file on a background
+// thread. Every recording thread gets its own StatisticsBuffer, so
+// recording a sample is a single append without locks; only a full
+// block of samples is handed to the writer. The file is columnar binary
+// (every column of a block stored together) or CSV.
+//
+// Binary layout: "AIMS", version 1, then blocks of
+//	uint32 kind (1 = ticks, 2 = matches), uint32 count, the columns:
+//	ticks	match u32, tick u32, player u8, cells filled u32, reachable area i32, decision ns u32
+//	matches	match u32, ticks u32, winner i8, then per player: cause u8, cells filled u32, survival ticks u32
+//-----------------------------------------------------------------
+
+#pragma once
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <tchar.h>
+#include <vector>
+#include <stdint.h>
+
+//-----------------------------------------------------------------
+// Enums
+//-----------------------------------------------------------------
+enum LOSS_CAUSE
+{
+	LOSS_NONE,
+	LOSS_IMMOBILISED,		// no free cell left next to the player
+	LOSS_FORFEIT,			// took longer than its move budget under BUDGET_FORFEIT
+	LOSS_COLLISION			// moved into the cell another player moved into in the same tick
+};
+
+//-----------------------------------------------------------------
+// Structs
+//-----------------------------------------------------------------
+struct TICK_SAMPLE
+{
+	uint32_t matchId, tick;
+	int player;
+	int cellsFilled;
+	int reachableArea;				// -1 on the ticks it isn't measured
+	uint32_t decisionNanoseconds;
+};
+
+struct MATCH_SAMPLE
+{
+	uint32_t matchId;
+	int tickCount;
+	int winner;						// -1 for a draw
+	int lossCauses[2];
+	int cellsFilled[2];
+	int survivalTicks[2];
+};
+
+struct STATISTICS_BLOCK
+{
+	std::vector<TICK_SAMPLE> ticks;
+	std::vector<MATCH_SAMPLE> matches;
+};
+
+class MatchStatistics;
+
+//-----------------------------------------------------------------
+// StatisticsBuffer Class
+//-----------------------------------------------------------------
+class StatisticsBuffer
+{
+public:
+	static const int BLOCK_SAMPLES = 4096;
+
+	//---------------------------
+	// General Methods
+	//---------------------------
+	void RecordTick(const TICK_SAMPLE& sampleRef)
+	{
+		if ((int) m_blockPtr->ticks.size() == BLOCK_SAMPLES) Submit();
+		m_blockPtr->ticks.push_back(sampleRef);
+	}
+
+	void RecordMatch(const MATCH_SAMPLE& sampleRef)
+	{
+		if ((int) m_blockPtr->matches.size() == BLOCK_SAMPLES) Submit();
+		m_blockPtr->matches.push_back(sampleRef);
+	}
+
+	// hands the samples recorded so far to the writer, e.g. at the end of a batch of matches
+	void Flush();
+
+private:
+	friend class MatchStatistics;
+
+	//---------------------------
+	// Constructor(s)
+	//---------------------------
+	StatisticsBuffer(MatchStatistics* ownerPtr, STATISTICS_BLOCK* blockPtr) : m_ownerPtr(ownerPtr), m_blockPtr(blockPtr)
+	{
+	}
+
+	// -------------------------
+	// Member functions
+	// -------------------------
+	void Submit();
+
+	// -------------------------
+	// Datamembers
+	// -------------------------
+	MatchStatistics* m_ownerPtr;
+	STATISTICS_BLOCK* m_blockPtr;
+
+	// -------------------------
+	// Disabling default copy constructor and default assignment operator.
+	// If you get a linker error from one of these functions, your class is internally trying to use them. This is
+	// an error in your class, these declarations are deliberately made without implementation because they should never be used.
+	// -------------------------
+	StatisticsBuffer(const StatisticsBuffer& sbRef);
+	StatisticsBuffer& operator=(const StatisticsBuffer& sbRef);
+};
+
+//-----------------------------------------------------------------
+// MatchStatistics Class
+//-----------------------------------------------------------------
+class MatchStatistics
+{
+public:
+	static const int MAX_BLOCKS = 64;		// when the disk can't keep up, recording threads wait for a free block
+
+	//---------------------------
+	// Constructor(s)
+	//---------------------------
+	MatchStatistics();
+
+	//---------------------------
+	// Destructor
+	//---------------------------
+	virtual ~MatchStatistics();
+
+	//---------------------------
+	// General Methods
+	//---------------------------
+	// like Close, only while no thread is recording
+	bool Open(TCHAR* filenamePtr, bool isCSV = false);
+
+	// writes what every buffer still holds and stops the writer; no thread may be recording
+	void Close();
+
+	bool IsOpen() const { return m_file != INVALID_HANDLE_VALUE; }
+
+	// the buffer of the calling thread, created on its first call; it stays valid until the MatchStatistics is destroyed.
+	// While no file is open the samples are thrown away.
+	StatisticsBuffer* GetThreadBuffer();
+
+	// what the writer has written since Open
+	LONGLONG GetWrittenTickCount() const { return m_writtenTicks; }
+	LONGLONG GetWrittenMatchCount() const { return m_writtenMatches; }
+
+private:
+	friend class StatisticsBuffer;
+
+	// -------------------------
+	// Member functions
+	// -------------------------
+	STATISTICS_BLOCK* Exchange(STATISTICS_BLOCK* fullBlockPtr);		// queues a full block and returns an empty one
+	static DWORD WINAPI ThreadProc(LPVOID parameter);
+	void WriterLoop();
+	void WriteBlock(const STATISTICS_BLOCK& blockRef);
+	void WriteOutput();
+
+	// -------------------------
+	// Datamembers
+	// -------------------------
+	DWORD m_tlsIndex;
+	CRITICAL_SECTION m_lock;
+	CONDITION_VARIABLE m_blockQueued, m_blockFreed;
+	std::vector<StatisticsBuffer*> m_buffers;
+	std::vector<STATISTICS_BLOCK*> m_queue, m_freeBlocks;
+	int m_blockCount;
+	bool m_isClosing;
+
+	// owned by the writer thread while the file is open
+	HANDLE m_file, m_thread;
+	bool m_isCSV;
+	std::vector<char> m_output;
+	LONGLONG m_writtenTicks, m_writtenMatches;
+
+	// -------------------------
+	// Disabling default copy constructor and default assignment operator.
+	// If you get a linker error from one of these functions, your class is internally trying to use them. This is
+	// an error in your class, these declarations are deliberately made without implementation because they should never be used.
+	// -------------------------
+	MatchStatistics(const MatchStatistics& msRef);
+	MatchStatistics& operator=(const MatchStatistics& msRef);
+};
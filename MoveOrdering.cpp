@@ -0,0 +1,95 @@
+//-----------------------------------------------------------------
+// MoveOrdering Object
+// C++ Source - MoveOrdering.cpp - version 2010 v2_07
+//-----------------------------------------------------------------
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#include "MoveOrdering.h"
+
+//-----------------------------------------------------------------
+// MoveOrdering methods
+//-----------------------------------------------------------------
+MoveOrdering::MoveOrdering() : m_heuristics(ALL_HEURISTICS), m_cellCount(0)
+{
+	NewSearch(0);
+}
+
+MoveOrdering::~MoveOrdering()
+{
+	// nothing to destroy
+}
+
+void MoveOrdering::NewSearch(int cellCount)
+{
+	if (cellCount != m_cellCount)
+	{
+		m_cellCount = cellCount;
+		m_history.assign(2 * cellCount * 4, 0);
+	}
+	else
+	{
+		for (int i = 0; i < (int) m_history.size(); ++i) m_history[i] /= 2;
+	}
+	for (int ply = 0; ply < MAX_PLY; ++ply) m_killers[ply][0] = m_killers[ply][1] = -1;
+}
+
+void MoveOrdering::Order(int player, int cell, int ply, int tableMove, const int* hintsPtr, int* directionsPtr, int count) const
+{
+	// the table move above the killers above everything else, which history and hints rank
+	static const int TABLE_KEY = 0x7fffffff, KILLER_KEY = 0x7ffffff0;
+	int keys[4];
+	for (int i = 0; i < count; ++i)
+	{
+		int direction = directionsPtr[i];
+		int key = 0;
+		if (IsEnabled(HISTORY)) key += GetHistory(player, cell, direction);
+		if (IsEnabled(TERRITORY) && hintsPtr != NULL) key += hintsPtr[direction] * HINT_WEIGHT;
+		if (IsEnabled(KILLERS) && ply < MAX_PLY)
+		{
+			if (direction == m_killers[ply][0]) key = KILLER_KEY;
+			else if (direction == m_killers[ply][1]) key = KILLER_KEY - 1;
+		}
+		if (IsEnabled(TABLE_MOVE) && direction == tableMove) key = TABLE_KEY;
+		keys[i] = key;
+	}
+
+	// insertion sort, a tie keeps the order it came in
+	for (int i = 1; i < count; ++i)
+	{
+		int key = keys[i], direction = directionsPtr[i];
+		int j = i;
+		for (; j > 0 && keys[j - 1] < key; --j)
+		{
+			keys[j] = keys[j - 1];
+			directionsPtr[j] = directionsPtr[j - 1];
+		}
+		keys[j] = key;
+		directionsPtr[j] = direction;
+	}
+}
+
+void MoveOrdering::RecordCutoff(int player, int cell, int ply, int depth, const int* directionsPtr, int cutoffIndex)
+{
+	int direction = directionsPtr[cutoffIndex];
+	if (ply < MAX_PLY && m_killers[ply][0] != direction)
+	{
+		m_killers[ply][1] = m_killers[ply][0];
+		m_killers[ply][0] = direction;
+	}
+
+	int bonus = depth * depth;
+	int* historyPtr = &m_history[(player * m_cellCount + cell) * 4];
+	UpdateHistory(historyPtr[direction], bonus);
+	for (int i = 0; i < cutoffIndex; ++i) UpdateHistory(historyPtr[directionsPtr[i]], -bonus);
+}
+
+// moves the score towards the limit by the bonus, the less the closer it already is, so it never leaves the limits
+void MoveOrdering::UpdateHistory(int& historyRef, int bonus)
+{
+	if (bonus > HISTORY_LIMIT) bonus = HISTORY_LIMIT;
+	else if (bonus < -HISTORY_LIMIT) bonus = -HISTORY_LIMIT;
+	int size = bonus < 0 ? -bonus : bonus;
+	historyRef += bonus - historyRef * size / HISTORY_LIMIT;
+}
@@ -0,0 +1,92 @@
+//-----------------------------------------------------------------
+// MoveOrdering Object
+// C++ Header - MoveOrdering.h - version 2010 v2_07
+//
+// MoveOrdering sorts the four directions of a node so that alpha-beta
+// tries the best move first; with four moves, that decides how much of
+// the tree it cuts off. Any search can use it, one per thread:
+//	TABLE_MOVE	the best move the transposition table remembers, first of all
+//	KILLERS		the last two moves that cut off at the same ply, in any position
+//	HISTORY		how often a move of the player from that cell cut off, deeper cutoffs
+//				counting more; the moves tried before the cutoff count against
+//	TERRITORY	hints from the search, e.g. the territory after the move, higher first
+//-----------------------------------------------------------------
+
+#pragma once
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#include <vector>
+#include <stddef.h>
+
+//-----------------------------------------------------------------
+// MoveOrdering Class
+//-----------------------------------------------------------------
+class MoveOrdering
+{
+public:
+	enum Heuristic
+	{
+		TABLE_MOVE = 1,
+		KILLERS = 2,
+		HISTORY = 4,
+		TERRITORY = 8,
+		ALL_HEURISTICS = 15
+	};
+	static const int MAX_PLY = 128;
+	static const int HISTORY_LIMIT = 16384;		// history scores stay within plus and minus this
+	static const int HINT_WEIGHT = 256;			// one unit of hint against history
+
+	//---------------------------
+	// Constructor(s)
+	//---------------------------
+	MoveOrdering();
+
+	//---------------------------
+	// Destructor
+	//---------------------------
+	virtual ~MoveOrdering();
+
+	//---------------------------
+	// General Methods
+	//---------------------------
+	void SetHeuristics(int heuristics) { m_heuristics = heuristics; }		// Heuristic flags
+	int GetHeuristics() const { return m_heuristics; }
+	bool IsEnabled(Heuristic heuristic) const { return (m_heuristics & heuristic) != 0; }
+
+	// before every search: halves the history, so it follows the match, and forgets the killers.
+	// cellCount is that of the arena indices; a different one starts the history over
+	void NewSearch(int cellCount);
+
+	// sorts the directions best first; cell is the arena index of the head of the player,
+	// tableMove -1 for none, hintsPtr holds a hint per direction (not per move) or is NULL
+	void Order(int player, int cell, int ply, int tableMove, const int* hintsPtr, int* directionsPtr, int count) const;
+
+	// the directions as they were searched, up to and including the one at cutoffIndex that failed high
+	void RecordCutoff(int player, int cell, int ply, int depth, const int* directionsPtr, int cutoffIndex);
+
+	int GetHistory(int player, int cell, int direction) const { return m_history[(player * m_cellCount + cell) * 4 + direction]; }
+
+private:
+	// -------------------------
+	// Member functions
+	// -------------------------
+	static void UpdateHistory(int& historyRef, int bonus);
+
+	// -------------------------
+	// Datamembers
+	// -------------------------
+	std::vector<int> m_history;		// by player, cell, direction
+	int m_killers[MAX_PLY][2];		// -1 for none
+	int m_heuristics;
+	int m_cellCount;
+
+	// -------------------------
+	// Disabling default copy constructor and default assignment operator.
+	// If you get a linker error from one of these functions, your class is internally trying to use them. This is
+	// an error in your class, these declarations are deliberately made without implementation because they should never be used.
+	// -------------------------
+	MoveOrdering(const MoveOrdering& moRef);
+	MoveOrdering& operator=(const MoveOrdering& moRef);
+};
@@ -0,0 +1,88 @@
+//-----------------------------------------------------------------
+// NetworkBot Object
+// C++ Header - NetworkBot.h - version 2010 v2_07
+//
+// NetworkBot looks one move ahead with a ValueNetwork: the positions
+// after every move to a free neighbour are evaluated as one batch, and
+// the best one for the bot is played. It shows how a search hands its
+// leaves to the network; the network is shared and not owned.
+//-----------------------------------------------------------------
+
+#pragma once
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#include "Bot.h"
+#include "ValueNetwork.h"
+
+//-----------------------------------------------------------------
+// NetworkBot Class
+//-----------------------------------------------------------------
+class NetworkBot : public Bot
+{
+public:
+	//---------------------------
+	// Constructor(s)
+	//---------------------------
+	NetworkBot(const ValueNetwork* networkPtr) : m_networkPtr(networkPtr)
+	{
+	}
+
+	//---------------------------
+	// Destructor
+	//---------------------------
+	virtual ~NetworkBot()
+	{
+	}
+
+	//---------------------------
+	// General Methods
+	//---------------------------
+	const char* GetName() const { return "network (value network AI)"; }
+
+	int ChooseDirection(const ArenaGrid& arenaRef, const CELL* positionsPtr, int player)
+	{
+		unsigned char inputs[4 * ValueNetwork::INPUTS];
+		int directions[4], count = 0;
+		for (int direction = 0; direction < 4; ++direction)
+		{
+			CELL positions[2] = { positionsPtr[0], positionsPtr[1] };
+			positions[player].x += DIRECTION_DX[direction];
+			positions[player].y += DIRECTION_DY[direction];
+			if (arenaRef.IsRigid(positions[player].x, positions[player].y)) continue;
+
+			// the position as the bot will see it on its next move: the cell it moved to is rigid by then
+			PLAY_SAMPLE sample;
+			SelfPlayRecorder::EncodeState(arenaRef, positions, player, sample);
+			int centre = SelfPlayWriter::WINDOW_RADIUS * SelfPlayWriter::WINDOW_SIDE + SelfPlayWriter::WINDOW_RADIUS;
+			sample.window[centre >> 6] |= 1ULL << (centre & 63);
+			ValueNetwork::EncodeInputs(sample, inputs + count * ValueNetwork::INPUTS);
+			directions[count++] = direction;
+		}
+		if (count == 0) return 0;
+
+		float values[4];
+		m_networkPtr->Evaluate(inputs, count, values);
+		int best = 0;
+		for (int i = 1; i < count; ++i)
+		{
+			if (values[i] > values[best]) best = i;
+		}
+		return directions[best];
+	}
+
+private:
+	// -------------------------
+	// Datamembers
+	// -------------------------
+	const ValueNetwork* m_networkPtr;
+
+	// -------------------------
+	// Disabling default copy constructor and default assignment operator.
+	// If you get a linker error from one of these functions, your class is internally trying to use them. This is
+	// an error in your class, these declarations are deliberately made without implementation because they should never be used.
+	// -------------------------
+	NetworkBot(const NetworkBot& nbRef);
+	NetworkBot& operator=(const NetworkBot& nbRef);
+};
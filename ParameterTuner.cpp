@@ -0,0 +1,237 @@
+//-----------------------------------------------------------------
+// ParameterTuner Object
+// C++ Source - ParameterTuner.cpp - version 2010 v2_07
+//-----------------------------------------------------------------
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#include "ParameterTuner.h"
+#include "Match.h"
+#include "RandomBot.h"
+#include "FillBot.h"
+#include <math.h>
+#include <algorithm>
+
+//-----------------------------------------------------------------
+// TuningTask Class
+//-----------------------------------------------------------------
+// item i is match i % matchCount of candidate i / matchCount
+class TuningTask : public WorkerTask
+{
+public:
+	TuningTask(const std::vector<ArenaGrid>& arenasRef, const std::vector<CELL>& startsRef, const std::vector<const double*>& weightPtrs) :
+		m_arenasRef(arenasRef), m_startsRef(startsRef), m_weightPtrs(weightPtrs), m_scores(weightPtrs.size() * arenasRef.size(), 0.0)
+	{
+	}
+
+	void Execute(int thread, int first, int last)
+	{
+		HeuristicBot heuristicBot;
+		RandomBot randomBot;
+		FillBot fillBot;
+		Match match;
+		int matchCount = (int) m_arenasRef.size();
+		for (int i = first; i < last; ++i)
+		{
+			int candidate = i / matchCount, matchIndex = i % matchCount;
+			heuristicBot.SetWeights(m_weightPtrs[candidate]);
+
+			// odd matches against the filler, and every other pair with the sides swapped
+			Bot* opponentPtr = (matchIndex & 1) ? (Bot*) &fillBot : (Bot*) &randomBot;
+			int side = (matchIndex >> 1) & 1;
+			Bot* firstPtr = side == 0 ? (Bot*) &heuristicBot : opponentPtr;
+			Bot* secondPtr = side == 0 ? opponentPtr : (Bot*) &heuristicBot;
+			match.Start(m_arenasRef[matchIndex], firstPtr, secondPtr, m_startsRef[matchIndex * 2], m_startsRef[matchIndex * 2 + 1], matchIndex, matchIndex);
+			int winner = match.Play(ParameterTuner::MAX_TICKS);
+			m_scores[i] = winner == Match::NO_WINNER ? 0.5 : winner == side ? 1.0 : 0.0;
+		}
+	}
+
+	double GetScore(int candidate) const
+	{
+		int matchCount = (int) m_arenasRef.size();
+		double sum = 0.0;
+		for (int i = 0; i < matchCount; ++i) sum += m_scores[candidate * matchCount + i];
+		return sum / matchCount;
+	}
+
+private:
+	const std::vector<ArenaGrid>& m_arenasRef;
+	const std::vector<CELL>& m_startsRef;
+	const std::vector<const double*>& m_weightPtrs;
+	std::vector<double> m_scores;
+
+	TuningTask(const TuningTask& ttRef);
+	TuningTask& operator=(const TuningTask& ttRef);
+};
+
+//-----------------------------------------------------------------
+// ParameterTuner methods
+//-----------------------------------------------------------------
+ParameterTuner::ParameterTuner(int populationSize, double mutationRate, double mutationSpread, uint64_t seed) :
+	m_random(seed), m_populationSize(populationSize), m_mutationRate(mutationRate), m_mutationSpread(mutationSpread),
+	m_generation(0), m_playedCount(0), m_cacheHitCount(0)
+{
+	for (int i = 0; i < WEIGHT_COUNT; ++i) m_best.weights[i] = 0.0;
+	m_best.score = -1.0;
+}
+
+ParameterTuner::~ParameterTuner()
+{
+	// nothing to destroy
+}
+
+void ParameterTuner::CreateMatches(int matchCount, ArenaGenerator::Kind kind, int size, double density, uint64_t seed)
+{
+	ArenaGenerator generator;
+	m_arenas.resize(matchCount);
+	m_starts.resize(matchCount * 2);
+	for (int i = 0; i < matchCount; ++i)
+	{
+		generator.Generate(m_arenas[i], kind, size, size, density, seed + i);
+		m_starts[i * 2] = generator.FindFreeCell();
+		do
+		{
+			m_starts[i * 2 + 1] = generator.FindFreeCell();
+		}
+		while (m_starts[i * 2 + 1].x == m_starts[i * 2].x && m_starts[i * 2 + 1].y == m_starts[i * 2].y && generator.CountFreeCells() > 1);
+	}
+	m_scores.clear();
+	m_best.score = -1.0;
+}
+
+void ParameterTuner::Start(const double* weightsPtr, double spread)
+{
+	m_population.resize(m_populationSize);
+	for (int i = 0; i < m_populationSize; ++i)
+	{
+		Candidate& candidateRef = m_population[i];
+		for (int weight = 0; weight < WEIGHT_COUNT; ++weight)
+		{
+			candidateRef.weights[weight] = weightsPtr[weight] + (i == 0 ? 0.0 : m_random.NextGaussian() * spread);
+		}
+		Round(candidateRef.weights);
+		candidateRef.score = -1.0;
+	}
+	m_generation = 0;
+}
+
+double ParameterTuner::RunGeneration(WorkerPool& poolRef)
+{
+	ScorePopulation(poolRef);
+	std::stable_sort(m_population.begin(), m_population.end(), IsBetter);
+	if (m_population[0].score > m_best.score) m_best = m_population[0];
+
+	std::vector<Candidate> children(m_population.begin(), m_population.begin() + std::min(ELITE_COUNT, m_populationSize));
+	while ((int) children.size() < m_populationSize)
+	{
+		const Candidate& firstRef = SelectParent();
+		const Candidate& secondRef = SelectParent();
+		Candidate child;
+		for (int weight = 0; weight < WEIGHT_COUNT; ++weight)
+		{
+			// blend crossover: anywhere between the parents and a quarter of the gap beyond them
+			double blend = m_random.NextDouble() * 1.5 - 0.25;
+			child.weights[weight] = firstRef.weights[weight] + blend * (secondRef.weights[weight] - firstRef.weights[weight]);
+			if (m_random.NextChance(m_mutationRate)) child.weights[weight] += m_random.NextGaussian() * m_mutationSpread;
+		}
+		Round(child.weights);
+		child.score = -1.0;
+		children.push_back(child);
+	}
+	m_population.swap(children);
+	++m_generation;
+	return m_best.score;
+}
+
+double ParameterTuner::Evaluate(WorkerPool& poolRef, const double* weightsPtr)
+{
+	Candidate candidate;
+	std::copy(weightsPtr, weightsPtr + WEIGHT_COUNT, candidate.weights);
+	Round(candidate.weights);
+	std::unordered_map<uint64_t, double>::iterator it = m_scores.find(GetKey(candidate.weights));
+	if (it != m_scores.end())
+	{
+		++m_cacheHitCount;
+		return it->second;
+	}
+
+	std::vector<const double*> weightPtrs(1, candidate.weights);
+	TuningTask task(m_arenas, m_starts, weightPtrs);
+	poolRef.Run(task, (int) m_arenas.size(), 8);
+	++m_playedCount;
+	double score = task.GetScore(0);
+	m_scores[GetKey(candidate.weights)] = score;
+	return score;
+}
+
+void ParameterTuner::ScorePopulation(WorkerPool& poolRef)
+{
+	// only candidates that were never played go to the pool, each of them once
+	std::vector<const double*> weightPtrs;
+	std::vector<uint64_t> keys;
+	std::unordered_map<uint64_t, int> playing;
+	for (size_t i = 0; i < m_population.size(); ++i)
+	{
+		uint64_t key = GetKey(m_population[i].weights);
+		if (m_scores.find(key) != m_scores.end() || playing.find(key) != playing.end())
+		{
+			++m_cacheHitCount;
+			continue;
+		}
+		playing[key] = (int) weightPtrs.size();
+		weightPtrs.push_back(m_population[i].weights);
+		keys.push_back(key);
+	}
+
+	if (!weightPtrs.empty())
+	{
+		TuningTask task(m_arenas, m_starts, weightPtrs);
+		poolRef.Run(task, (int) (weightPtrs.size() * m_arenas.size()), 8);
+		for (size_t i = 0; i < keys.size(); ++i) m_scores[keys[i]] = task.GetScore((int) i);
+		m_playedCount += (int) keys.size();
+	}
+
+	for (size_t i = 0; i < m_population.size(); ++i)
+	{
+		m_population[i].score = m_scores[GetKey(m_population[i].weights)];
+	}
+}
+
+const ParameterTuner::Candidate& ParameterTuner::SelectParent()
+{
+	// the population is sorted best first, so the lowest index drawn wins the tournament
+	int best = m_populationSize;
+	for (int i = 0; i < TOURNAMENT_SIZE; ++i) best = std::min(best, m_random.NextInt(m_populationSize));
+	return m_population[best];
+}
+
+bool ParameterTuner::IsBetter(const Candidate& firstRef, const Candidate& secondRef)
+{
+	return firstRef.score > secondRef.score;
+}
+
+void ParameterTuner::Round(double* weightsPtr)
+{
+	for (int weight = 0; weight < WEIGHT_COUNT; ++weight)
+	{
+		weightsPtr[weight] = floor(weightsPtr[weight] * WEIGHT_STEPS + 0.5) / WEIGHT_STEPS;
+	}
+}
+
+uint64_t ParameterTuner::GetKey(const double* weightsPtr)
+{
+	// FNV-1a over the rounded weights in steps
+	uint64_t key = 14695981039346656037ULL;
+	for (int weight = 0; weight < WEIGHT_COUNT; ++weight)
+	{
+		int64_t steps = (int64_t) floor(weightsPtr[weight] * WEIGHT_STEPS + 0.5);
+		for (int byte = 0; byte < 8; ++byte)
+		{
+			key ^= (uint64_t) ((steps >> (byte * 8)) & 0xff);
+			key *= 1099511628211ULL;
+		}
+	}
+	return key;
+}
@@ -0,0 +1,116 @@
+//-----------------------------------------------------------------
+// ParameterTuner Object
+// C++ Header - ParameterTuner.h - version 2010 v2_07
+//
+// ParameterTuner tunes the weights of HeuristicBot with a genetic
+// algorithm. Every candidate plays the same set of headless matches
+// against the berserker and the filler: the same arenas, start cells,
+// sides and random seeds, so the scores of two candidates differ only
+// by their weights (common random numbers). The matches of a whole
+// generation run as one WorkerPool task over every core.
+//
+// Every generation keeps the best candidates, and fills the rest with
+// children of tournament selected parents: a blend crossover and a
+// gaussian mutation, rounded to WEIGHT_STEPS. Scores are cached by the
+// rounded weights, so a candidate that survives or comes back is never
+// played again.
+//-----------------------------------------------------------------
+
+#pragma once
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#include "ArenaGrid.h"
+#include "ArenaGenerator.h"
+#include "HeuristicBot.h"
+#include "Random.h"
+#include "WorkerPool.h"
+#include <vector>
+#include <unordered_map>
+#include <stdint.h>
+
+//-----------------------------------------------------------------
+// ParameterTuner Class
+//-----------------------------------------------------------------
+class ParameterTuner
+{
+public:
+	static const int WEIGHT_COUNT = HeuristicBot::WEIGHT_COUNT;
+	static const int ELITE_COUNT = 2;
+	static const int TOURNAMENT_SIZE = 3;
+	static const int WEIGHT_STEPS = 100;		// weights are rounded to 1/100
+	static const int MAX_TICKS = 100000;
+
+	//---------------------------
+	// Constructor(s)
+	//---------------------------
+	ParameterTuner(int populationSize = 32, double mutationRate = 0.3, double mutationSpread = 0.3, uint64_t seed = 45);
+
+	//---------------------------
+	// Destructor
+	//---------------------------
+	virtual ~ParameterTuner();
+
+	//---------------------------
+	// General Methods
+	//---------------------------
+	// the matches every candidate plays, half of them against each opponent; clears the cache
+	void CreateMatches(int matchCount, ArenaGenerator::Kind kind, int size, double density, uint64_t seed);
+
+	// a first population spread around the given weights, which are part of it
+	void Start(const double* weightsPtr, double spread);
+
+	// scores the population and breeds the next one; returns the best score so far
+	double RunGeneration(WorkerPool& poolRef);
+
+	// the mean score of a candidate, 1 for a win and 0.5 for a draw, from the cache when it was played before
+	double Evaluate(WorkerPool& poolRef, const double* weightsPtr);
+
+	const double* GetBestWeights() const { return m_best.weights; }
+	double GetBestScore() const { return m_best.score; }
+	int GetGeneration() const { return m_generation; }
+	int GetPlayedCount() const { return m_playedCount; }		// candidates that played their matches
+	int GetCacheHitCount() const { return m_cacheHitCount; }
+
+private:
+	// -------------------------
+	// Internal structs
+	// -------------------------
+	struct Candidate
+	{
+		double weights[WEIGHT_COUNT];
+		double score;
+	};
+
+	// -------------------------
+	// Member functions
+	// -------------------------
+	void ScorePopulation(WorkerPool& poolRef);
+	const Candidate& SelectParent();
+	static bool IsBetter(const Candidate& firstRef, const Candidate& secondRef);
+	static void Round(double* weightsPtr);
+	static uint64_t GetKey(const double* weightsPtr);
+
+	// -------------------------
+	// Datamembers
+	// -------------------------
+	Random m_random;
+	int m_populationSize;
+	double m_mutationRate, m_mutationSpread;
+	std::vector<ArenaGrid> m_arenas;			// one per match
+	std::vector<CELL> m_starts;					// two per match
+	std::vector<Candidate> m_population;
+	Candidate m_best;
+	int m_generation;
+	std::unordered_map<uint64_t, double> m_scores;		// rounded weights -> score
+	int m_playedCount, m_cacheHitCount;
+
+	// -------------------------
+	// Disabling default copy constructor and default assignment operator.
+	// If you get a linker error from one of these functions, your class is internally trying to use them. This is
+	// an error in your class, these declarations are deliberately made without implementation because they should never be used.
+	// -------------------------
+	ParameterTuner(const ParameterTuner& ptRef);
+	ParameterTuner& operator=(const ParameterTuner& ptRef);
+};
@@ -0,0 +1,273 @@
+//-----------------------------------------------------------------
+// PathCache Object
+// C++ Header - PathCache.h - version 2010 v2_07
+//
+// PathCache remembers the answers of recent A* queries, so bots asking
+// for the same start and goal tick after tick don't search again. The
+// cache is a least recently used list of a fixed size, keyed by start,
+// goal and grid epoch. It also remembers which cells every path runs
+// through: a new rigid cell only throws away the paths that cross it.
+// Register it with AIchallenge::AddRigidCellListener; when cells are
+// freed or the arena is rebuilt, call NextEpoch so every older answer
+// counts as a miss.
+//-----------------------------------------------------------------
+
+#pragma once
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#include "ArenaGrid.h"
+#include "PathFinder.h"
+#include "RigidCellListener.h"
+#include <vector>
+#include <unordered_map>
+#include <stdint.h>
+
+//-----------------------------------------------------------------
+// PathCache Class
+//-----------------------------------------------------------------
+template<class Grid>
+class PathCache : public RigidCellListener
+{
+public:
+	//---------------------------
+	// Constructor(s)
+	//---------------------------
+	PathCache() : m_gridPtr(NULL), m_epoch(0), m_mostRecent(-1), m_leastRecent(-1), m_staleCellLinks(0), m_liveCellLinks(0)
+	{
+		ResetCounters();
+	}
+
+	//---------------------------
+	// Destructor
+	//---------------------------
+	virtual ~PathCache()
+	{
+	}
+
+	//---------------------------
+	// General Methods
+	//---------------------------
+
+	// the grid has to outlive the cache; capacity is the number of paths kept
+	void Initialize(const Grid& gridRef, int capacity = 1024)
+	{
+		m_gridPtr = &gridRef;
+		m_entries.assign(capacity, Entry());
+		m_freeEntries.clear();
+		for (int entry = capacity - 1; entry >= 0; --entry)
+		{
+			m_freeEntries.push_back(entry);
+		}
+		m_entryIndex.clear();
+		m_cellLinks.clear();
+		m_mostRecent = m_leastRecent = -1;
+		m_staleCellLinks = m_liveCellLinks = 0;
+		ResetCounters();
+	}
+
+	// every answer from before this call is outdated
+	void NextEpoch()
+	{
+		++m_epoch;
+	}
+
+	// path length from the start to the goal or -1, like PathFinder::AStar
+	int FindPath(int startX, int startY, int goalX, int goalY, std::vector<CELL>* pathPtr = NULL)
+	{
+		uint64_t key = MakeKey(startX, startY, goalX, goalY);
+		std::unordered_map<uint64_t, int>::iterator it = m_entryIndex.find(key);
+		if (it != m_entryIndex.end())
+		{
+			Entry& entryRef = m_entries[it->second];
+			if (entryRef.epoch == m_epoch)
+			{
+				++m_hits;
+				MoveToFront(it->second);
+				if (pathPtr != NULL) *pathPtr = entryRef.path;
+				return entryRef.length;
+			}
+			Release(it->second);
+		}
+		++m_misses;
+
+		int entry = AcquireEntry();
+		Entry& entryRef = m_entries[entry];
+		entryRef.key = key;
+		entryRef.epoch = m_epoch;
+		entryRef.length = m_pathFinder.AStar(*m_gridPtr, startX, startY, goalX, goalY, &entryRef.path);
+		++entryRef.generation;
+		entryRef.isUsed = true;
+		m_entryIndex[key] = entry;
+		PushFront(entry);
+
+		// an unreachable goal stays unreachable while cells only become rigid, so it has no cells to watch
+		for (size_t i = 0; i < entryRef.path.size(); ++i)
+		{
+			CellLink link = { entry, entryRef.generation };
+			m_cellLinks[m_gridPtr->Index(entryRef.path[i].x, entryRef.path[i].y)].push_back(link);
+		}
+		m_liveCellLinks += (int) entryRef.path.size();
+		if (m_staleCellLinks > m_liveCellLinks + (int) m_entries.size() * 16) DropStaleCellLinks();
+
+		if (pathPtr != NULL) *pathPtr = entryRef.path;
+		return entryRef.length;
+	}
+
+	void CellBecameRigid(int x, int y)
+	{
+		typename CellLinkMap::iterator it = m_cellLinks.find(m_gridPtr->Index(x, y));
+		if (it == m_cellLinks.end()) return;
+
+		// copied, because releasing the entries changes the links
+		std::vector<CellLink> links;
+		links.swap(it->second);
+		m_cellLinks.erase(it);
+		for (size_t i = 0; i < links.size(); ++i)
+		{
+			const Entry& entryRef = m_entries[links[i].entry];
+			if (!entryRef.isUsed || entryRef.generation != links[i].generation) continue;
+			m_entryIndex.erase(entryRef.key);
+			Release(links[i].entry);
+			++m_invalidations;
+		}
+		m_staleCellLinks -= (int) links.size();
+	}
+
+	void ResetCounters()
+	{
+		m_hits = m_misses = m_invalidations = m_evictions = 0;
+	}
+
+	int GetHits() const { return m_hits; }
+	int GetMisses() const { return m_misses; }
+	int GetInvalidations() const { return m_invalidations; }
+	int GetEvictions() const { return m_evictions; }
+	double GetHitRate() const { return m_hits + m_misses > 0 ? (double) m_hits / (m_hits + m_misses) : 0.0; }
+	int GetPathCount() const { return (int) m_entries.size() - (int) m_freeEntries.size(); }
+
+private:
+	// -------------------------
+	// Internal structs
+	// -------------------------
+	struct Entry
+	{
+		Entry() : key(0), epoch(0), length(-1), generation(0), isUsed(false), previous(-1), next(-1) {}
+		uint64_t key;
+		int epoch;
+		int length;
+		std::vector<CELL> path;
+		int generation;			// counts the reuses of the entry, so old cell links can be recognised
+		bool isUsed;
+		int previous, next;		// least recently used list, previous is more recent
+	};
+
+	struct CellLink
+	{
+		int entry;
+		int generation;
+	};
+	typedef std::unordered_map<int, std::vector<CellLink> > CellLinkMap;
+
+	// -------------------------
+	// Member functions
+	// -------------------------
+	static uint64_t MakeKey(int startX, int startY, int goalX, int goalY)
+	{
+		return ((uint64_t) (uint16_t) startX << 48) | ((uint64_t) (uint16_t) startY << 32) | ((uint64_t) (uint16_t) goalX << 16) | (uint64_t) (uint16_t) goalY;
+	}
+
+	int AcquireEntry()
+	{
+		if (m_freeEntries.empty())
+		{
+			int oldest = m_leastRecent;
+			m_entryIndex.erase(m_entries[oldest].key);
+			Release(oldest);
+			++m_evictions;
+		}
+		int entry = m_freeEntries.back();
+		m_freeEntries.pop_back();
+		return entry;
+	}
+
+	// unlinks an entry and gives it back; its cell links become stale and are dropped once there are many of them
+	void Release(int entry)
+	{
+		Entry& entryRef = m_entries[entry];
+		Unlink(entry);
+		entryRef.isUsed = false;
+		m_liveCellLinks -= (int) entryRef.path.size();
+		m_staleCellLinks += (int) entryRef.path.size();
+		m_freeEntries.push_back(entry);
+	}
+
+	void DropStaleCellLinks()
+	{
+		typename CellLinkMap::iterator it = m_cellLinks.begin();
+		while (it != m_cellLinks.end())
+		{
+			std::vector<CellLink>& linksRef = it->second;
+			size_t kept = 0;
+			for (size_t i = 0; i < linksRef.size(); ++i)
+			{
+				const Entry& entryRef = m_entries[linksRef[i].entry];
+				if (entryRef.isUsed && entryRef.generation == linksRef[i].generation) linksRef[kept++] = linksRef[i];
+			}
+			linksRef.resize(kept);
+			if (kept == 0) it = m_cellLinks.erase(it);
+			else ++it;
+		}
+		m_staleCellLinks = 0;
+	}
+
+	void PushFront(int entry)
+	{
+		Entry& entryRef = m_entries[entry];
+		entryRef.previous = -1;
+		entryRef.next = m_mostRecent;
+		if (m_mostRecent >= 0) m_entries[m_mostRecent].previous = entry;
+		m_mostRecent = entry;
+		if (m_leastRecent < 0) m_leastRecent = entry;
+	}
+
+	void Unlink(int entry)
+	{
+		Entry& entryRef = m_entries[entry];
+		if (entryRef.previous >= 0) m_entries[entryRef.previous].next = entryRef.next;
+		else m_mostRecent = entryRef.next;
+		if (entryRef.next >= 0) m_entries[entryRef.next].previous = entryRef.previous;
+		else m_leastRecent = entryRef.previous;
+		entryRef.previous = entryRef.next = -1;
+	}
+
+	void MoveToFront(int entry)
+	{
+		if (entry == m_mostRecent) return;
+		Unlink(entry);
+		PushFront(entry);
+	}
+
+	// -------------------------
+	// Datamembers
+	// -------------------------
+	const Grid* m_gridPtr;
+	PathFinder<Grid> m_pathFinder;
+	int m_epoch;
+	std::vector<Entry> m_entries;
+	std::vector<int> m_freeEntries;
+	std::unordered_map<uint64_t, int> m_entryIndex;					// key -> entry
+	CellLinkMap m_cellLinks;										// cell index -> entries whose path runs through it
+	int m_mostRecent, m_leastRecent;
+	int m_staleCellLinks, m_liveCellLinks;
+	int m_hits, m_misses, m_invalidations, m_evictions;
+
+	// -------------------------
+	// Disabling default copy constructor and default assignment operator.
+	// If you get a linker error from one of these functions, your class is internally trying to use them. This is
+	// an error in your class, these declarations are deliberately made without implementation because they should never be used.
+	// -------------------------
+	PathCache(const PathCache& pcRef);
+	PathCache& operator=(const PathCache& pcRef);
+};
@@ -0,0 +1,235 @@
+//-----------------------------------------------------------------
+// PathFinder Object
+// C++ Header - PathFinder.h - version 2010 v2_07
+//
+// PathFinder runs breadth first search, A* and flood fill on any
+// arena grid (ArenaGrid, TiledArenaGrid, ...). Its scratch buffers use
+// the same layout as the grid and are kept between searches; a search
+// stamp marks which entries belong to the current search, so nothing
+// has to be cleared.
+//-----------------------------------------------------------------
+
+#pragma once
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#include "ArenaGrid.h"
+#include <vector>
+#include <algorithm>
+#include <stdlib.h>
+
+//-----------------------------------------------------------------
+// PathFinder Class
+//-----------------------------------------------------------------
+template<class Grid>
+class PathFinder
+{
+public:
+	//---------------------------
+	// Constructor(s)
+	//---------------------------
+	PathFinder() : m_gridPtr(NULL), m_stamp(0)
+	{
+	}
+
+	//---------------------------
+	// General Methods
+	//---------------------------
+
+	// distance from the start to every reachable cell, returns the number of reached cells
+	int BreadthFirst(const Grid& gridRef, int startX, int startY)
+	{
+		Prepare(gridRef);
+		m_queue.clear();
+		Visit(startX, startY, 0, 0);
+		m_queue.push_back(MakeCell(startX, startY));
+
+		for (size_t head = 0; head < m_queue.size(); ++head)
+		{
+			CELL cell = m_queue[head];
+			int distance = m_distance[gridRef.Index(cell.x, cell.y)] + 1;
+			for (int direction = 0; direction < 4; ++direction)
+			{
+				int x = cell.x + DIRECTION_DX[direction], y = cell.y + DIRECTION_DY[direction];
+				if (gridRef.IsRigid(x, y) || IsVisited(x, y)) continue;
+				Visit(x, y, distance, direction);
+				m_queue.push_back(MakeCell(x, y));
+			}
+		}
+		return (int) m_queue.size();
+	}
+
+	// shortest path length from start to goal, -1 when the goal can't be reached
+	// the path (start and goal included) is written to pathPtr when it isn't NULL
+	int AStar(const Grid& gridRef, int startX, int startY, int goalX, int goalY, std::vector<CELL>* pathPtr = NULL)
+	{
+		Prepare(gridRef);
+		m_open.clear();
+		Visit(startX, startY, 0, 0);
+		PushOpen(startX, startY, 0, goalX, goalY);
+
+		int length = -1;
+		while (!m_open.empty())
+		{
+			OpenNode node = m_open.front();
+			std::pop_heap(m_open.begin(), m_open.end());
+			m_open.pop_back();
+			int distance = m_distance[gridRef.Index(node.x, node.y)];
+			if (distance != node.g) continue;	// outdated heap entry
+			if (node.x == goalX && node.y == goalY)
+			{
+				length = distance;
+				break;
+			}
+			for (int direction = 0; direction < 4; ++direction)
+			{
+				int x = node.x + DIRECTION_DX[direction], y = node.y + DIRECTION_DY[direction];
+				if (gridRef.IsRigid(x, y)) continue;
+				if (IsVisited(x, y) && m_distance[gridRef.Index(x, y)] <= distance + 1) continue;
+				Visit(x, y, distance + 1, direction);
+				PushOpen(x, y, distance + 1, goalX, goalY);
+			}
+		}
+
+		if (pathPtr != NULL)
+		{
+			pathPtr->clear();
+			if (length >= 0) TracePath(goalX, goalY, length, pathPtr);
+		}
+		return length;
+	}
+
+	// scanline flood fill, returns the number of cells reachable from the start (the start included)
+	int FloodFill(const Grid& gridRef, int startX, int startY)
+	{
+		Prepare(gridRef);
+		m_queue.clear();
+		if (gridRef.IsRigid(startX, startY)) return 0;
+		m_queue.push_back(MakeCell(startX, startY));
+
+		int area = 0;
+		while (!m_queue.empty())
+		{
+			CELL seed = m_queue.back();
+			m_queue.pop_back();
+			if (IsVisited(seed.x, seed.y)) continue;
+
+			int left = seed.x, right = seed.x;
+			while (!gridRef.IsRigid(left - 1, seed.y) && !IsVisited(left - 1, seed.y)) --left;
+			while (!gridRef.IsRigid(right + 1, seed.y) && !IsVisited(right + 1, seed.y)) ++right;
+
+			for (int x = left; x <= right; ++x)
+			{
+				Visit(x, seed.y, 0, 0);
+			}
+			area += right - left + 1;
+
+			// one seed per free span in the rows above and below
+			for (int dy = -1; dy <= 1; dy += 2)
+			{
+				int y = seed.y + dy;
+				bool inSpan = false;
+				for (int x = left; x <= right; ++x)
+				{
+					bool open = !gridRef.IsRigid(x, y) && !IsVisited(x, y);
+					if (open && !inSpan) m_queue.push_back(MakeCell(x, y));
+					inSpan = open;
+				}
+			}
+		}
+		return area;
+	}
+
+	// results of the last search
+	bool IsReached(int x, int y) const { return IsVisited(x, y); }
+	int GetDistance(int x, int y) const { return IsVisited(x, y) ? m_distance[m_gridPtr->Index(x, y)] : -1; }
+
+private:
+	// -------------------------
+	// Internal structs
+	// -------------------------
+	struct OpenNode
+	{
+		int f, g;
+		int x, y;
+		// the open list is a max heap: lowest f first, deepest g first on ties
+		bool operator<(const OpenNode& otherRef) const
+		{
+			if (f != otherRef.f) return f > otherRef.f;
+			return g < otherRef.g;
+		}
+	};
+
+	// -------------------------
+	// Member functions
+	// -------------------------
+	static CELL MakeCell(int x, int y)
+	{
+		CELL cell = { x, y };
+		return cell;
+	}
+
+	void Prepare(const Grid& gridRef)
+	{
+		m_gridPtr = &gridRef;
+		if ((int) m_stamps.size() != gridRef.GetCellCount())
+		{
+			m_stamps.assign(gridRef.GetCellCount(), 0);
+			m_distance.resize(gridRef.GetCellCount());
+			m_parent.resize(gridRef.GetCellCount());
+			m_stamp = 0;
+		}
+		if (++m_stamp == 0)
+		{
+			std::fill(m_stamps.begin(), m_stamps.end(), 0);
+			m_stamp = 1;
+		}
+	}
+
+	bool IsVisited(int x, int y) const { return m_stamps[m_gridPtr->Index(x, y)] == m_stamp; }
+
+	void Visit(int x, int y, int distance, int direction)
+	{
+		int index = m_gridPtr->Index(x, y);
+		m_stamps[index] = m_stamp;
+		m_distance[index] = distance;
+		m_parent[index] = (unsigned char) direction;
+	}
+
+	void PushOpen(int x, int y, int g, int goalX, int goalY)
+	{
+		OpenNode node;
+		node.g = g;
+		node.f = g + abs(goalX - x) + abs(goalY - y);
+		node.x = x;
+		node.y = y;
+		m_open.push_back(node);
+		std::push_heap(m_open.begin(), m_open.end());
+	}
+
+	void TracePath(int goalX, int goalY, int length, std::vector<CELL>* pathPtr) const
+	{
+		pathPtr->resize(length + 1);
+		int x = goalX, y = goalY;
+		for (int i = length; i > 0; --i)
+		{
+			(*pathPtr)[i] = MakeCell(x, y);
+			int direction = m_parent[m_gridPtr->Index(x, y)];
+			x -= DIRECTION_DX[direction];
+			y -= DIRECTION_DY[direction];
+		}
+		(*pathPtr)[0] = MakeCell(x, y);
+	}
+
+	// -------------------------
+	// Datamembers
+	// -------------------------
+	const Grid* m_gridPtr;
+	unsigned int m_stamp;
+	std::vector<unsigned int> m_stamps;
+	std::vector<int> m_distance;
+	std::vector<unsigned char> m_parent;		// direction taken to reach the cell
+	std::vector<CELL> m_queue;
+	std::vector<OpenNode> m_open;
+};
@@ -0,0 +1,175 @@
+//-----------------------------------------------------------------
+// PathQueryBatch Object
+// C++ Header - PathQueryBatch.h - version 2010 v2_07
+//
+// PathQueryBatch collects many (start, goal) queries and answers them
+// all at once on a WorkerPool. Every thread owns its own PathFinder, so
+// the scratch buffers stay with the thread and are reused from batch to
+// batch. The paths end up one after the other in a single contiguous
+// buffer, in the order the queries were added.
+// The grid is only read, it must not change while Run is busy.
+//-----------------------------------------------------------------
+
+#pragma once
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#include "ArenaGrid.h"
+#include "PathFinder.h"
+#include "WorkerPool.h"
+#include <vector>
+
+//-----------------------------------------------------------------
+// PathQueryBatch Class
+//-----------------------------------------------------------------
+template<class Grid>
+class PathQueryBatch : public WorkerTask
+{
+public:
+	static const int QUERIES_PER_CHUNK = 16;
+
+	//---------------------------
+	// Constructor(s)
+	//---------------------------
+	PathQueryBatch(WorkerPool& poolRef) : m_poolRef(poolRef), m_gridPtr(NULL), m_storePaths(true)
+	{
+		m_threadScratch.resize(poolRef.GetThreadCount());
+		for (size_t thread = 0; thread < m_threadScratch.size(); ++thread)
+		{
+			m_threadScratch[thread].pathFinderPtr = new PathFinder<Grid>();
+		}
+	}
+
+	//---------------------------
+	// Destructor
+	//---------------------------
+	virtual ~PathQueryBatch()
+	{
+		for (size_t thread = 0; thread < m_threadScratch.size(); ++thread)
+		{
+			delete m_threadScratch[thread].pathFinderPtr;
+		}
+	}
+
+	//---------------------------
+	// General Methods
+	//---------------------------
+	void Clear()
+	{
+		m_queries.clear();
+		m_results.clear();
+		m_cells.clear();
+	}
+
+	// returns the number of the query, to look up its result after Run
+	int Add(int startX, int startY, int goalX, int goalY)
+	{
+		QUERY query = { startX, startY, goalX, goalY };
+		m_queries.push_back(query);
+		return (int) m_queries.size() - 1;
+	}
+
+	// answers every query added since the last Clear; without storePaths only the lengths are kept
+	void Run(const Grid& gridRef, bool storePaths = true)
+	{
+		m_gridPtr = &gridRef;
+		m_storePaths = storePaths;
+		m_results.resize(m_queries.size());
+		for (size_t thread = 0; thread < m_threadScratch.size(); ++thread)
+		{
+			m_threadScratch[thread].cells.clear();
+		}
+
+		m_poolRef.Run(*this, (int) m_queries.size(), QUERIES_PER_CHUNK);
+
+		// move the paths from the thread buffers into one buffer, in query order
+		int cellCount = 0;
+		for (size_t query = 0; query < m_results.size(); ++query)
+		{
+			cellCount += m_results[query].cellCount;
+		}
+		m_cells.resize(cellCount);
+		int offset = 0;
+		for (size_t query = 0; query < m_results.size(); ++query)
+		{
+			RESULT& resultRef = m_results[query];
+			const std::vector<CELL>& threadCellsRef = m_threadScratch[resultRef.thread].cells;
+			if (resultRef.cellCount > 0) std::copy(threadCellsRef.begin() + resultRef.firstCell, threadCellsRef.begin() + resultRef.firstCell + resultRef.cellCount, m_cells.begin() + offset);
+			resultRef.firstCell = offset;
+			offset += resultRef.cellCount;
+		}
+		m_gridPtr = NULL;
+	}
+
+	int GetQueryCount() const { return (int) m_queries.size(); }
+
+	// path length of a query, -1 when the goal can't be reached
+	int GetLength(int query) const { return m_results[query].length; }
+
+	// the cells of a query's path, start and goal included, stored one after the other with the other paths
+	const CELL* GetPath(int query) const { return m_results[query].cellCount > 0 ? &m_cells[m_results[query].firstCell] : NULL; }
+	int GetPathCellCount(int query) const { return m_results[query].cellCount; }
+
+	void Execute(int thread, int first, int last)
+	{
+		ThreadScratch& scratchRef = m_threadScratch[thread];
+		for (int query = first; query < last; ++query)
+		{
+			const QUERY& queryRef = m_queries[query];
+			RESULT& resultRef = m_results[query];
+			resultRef.length = scratchRef.pathFinderPtr->AStar(*m_gridPtr, queryRef.startX, queryRef.startY, queryRef.goalX, queryRef.goalY, m_storePaths ? &scratchRef.path : NULL);
+			resultRef.thread = thread;
+			resultRef.firstCell = (int) scratchRef.cells.size();
+			resultRef.cellCount = 0;
+			if (m_storePaths && resultRef.length >= 0)
+			{
+				scratchRef.cells.insert(scratchRef.cells.end(), scratchRef.path.begin(), scratchRef.path.end());
+				resultRef.cellCount = (int) scratchRef.path.size();
+			}
+		}
+	}
+
+private:
+	// -------------------------
+	// Internal structs
+	// -------------------------
+	struct QUERY
+	{
+		int startX, startY, goalX, goalY;
+	};
+
+	struct RESULT
+	{
+		int length;
+		int thread;
+		int firstCell, cellCount;
+	};
+
+	struct ThreadScratch
+	{
+		PathFinder<Grid>* pathFinderPtr;
+		std::vector<CELL> path;
+		std::vector<CELL> cells;		// the paths this thread found during the current Run
+		char padding[64];				// keeps the threads' scratch on different cache lines
+	};
+
+	// -------------------------
+	// Datamembers
+	// -------------------------
+	WorkerPool& m_poolRef;
+	const Grid* m_gridPtr;
+	bool m_storePaths;
+	std::vector<QUERY> m_queries;
+	std::vector<RESULT> m_results;
+	std::vector<CELL> m_cells;
+	std::vector<ThreadScratch> m_threadScratch;
+
+	// -------------------------
+	// Disabling default copy constructor and default assignment operator.
+	// If you get a linker error from one of these functions, your class is internally trying to use them. This is
+	// an error in your class, these declarations are deliberately made without implementation because they should never be used.
+	// -------------------------
+	PathQueryBatch(const PathQueryBatch& pqbRef);
+	PathQueryBatch& operator=(const PathQueryBatch& pqbRef);
+};
@@ -0,0 +1,87 @@
+//-----------------------------------------------------------------
+// PlayoutBot Object
+// C++ Header - PlayoutBot.h - version 2010 v2_07
+//
+// PlayoutBot plays flat Monte Carlo: after every move to a free
+// neighbour it plays 256 random games with a BitslicedPlayout and makes
+// the move that won the most, a draw counting half. It shows how a
+// search hands its leaves to the batched simulator. The games are one
+// Playout256, which costs four Playout64 and no more, with or without
+// AVX2.
+//-----------------------------------------------------------------
+
+#pragma once
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#include "Bot.h"
+#include "BitslicedPlayout.h"
+
+//-----------------------------------------------------------------
+// PlayoutBot Class
+//-----------------------------------------------------------------
+class PlayoutBot : public Bot
+{
+public:
+	static const int MAX_MOVES = 400;		// per random game, both players together
+	static const int GAMES = 256;			// per move
+
+	//---------------------------
+	// Constructor(s)
+	//---------------------------
+	PlayoutBot() : m_seed(0)
+	{
+	}
+
+	//---------------------------
+	// Destructor
+	//---------------------------
+	virtual ~PlayoutBot()
+	{
+	}
+
+	//---------------------------
+	// General Methods
+	//---------------------------
+	const char* GetName() const { return "playout (Monte Carlo AI)"; }
+	void StartMatch(int player, uint64_t seed) { m_seed = seed; }
+
+	int ChooseDirection(const ArenaGrid& arenaRef, const CELL* positionsPtr, int player)
+	{
+		int bestDirection = 0, bestScore = -1;
+		for (int direction = 0; direction < 4; ++direction)
+		{
+			CELL positions[2] = { positionsPtr[0], positionsPtr[1] };
+			positions[player].x += DIRECTION_DX[direction];
+			positions[player].y += DIRECTION_DY[direction];
+			if (arenaRef.IsRigid(positions[player].x, positions[player].y)) continue;
+
+			// the opponent moves next; the score is in half wins, so a draw needs no fractions
+			m_playout.Start(arenaRef, positions, 1 - player, m_seed++);
+			m_playout.Play(MAX_MOVES);
+			int score = 2 * m_playout.GetWinCount(player) + m_playout.GetDrawCount();
+			if (score > bestScore)
+			{
+				bestScore = score;
+				bestDirection = direction;
+			}
+		}
+		return bestDirection;
+	}
+
+private:
+	// -------------------------
+	// Datamembers
+	// -------------------------
+	Playout256 m_playout;
+	uint64_t m_seed;
+
+	// -------------------------
+	// Disabling default copy constructor and default assignment operator.
+	// If you get a linker error from one of these functions, your class is internally trying to use them. This is
+	// an error in your class, these declarations are deliberately made without implementation because they should never be used.
+	// -------------------------
+	PlayoutBot(const PlayoutBot& pbRef);
+	PlayoutBot& operator=(const PlayoutBot& pbRef);
+};
@@ -0,0 +1,143 @@
+//-----------------------------------------------------------------
+// RadixHeap Object
+// C++ Header - RadixHeap.h - version 2010 v2_07
+//
+// RadixHeap is a monotone priority queue for unsigned integer keys
+// (Ahuja, Mehlhorn, Orlin & Tarjan). Every key pushed must be at least
+// the last key popped, as in Dijkstra's algorithm. An entry sits in the
+// bucket of the highest bit in which its key differs from the last
+// popped key, and only moves to lower buckets, so a push is O(1) and an
+// entry is moved at most 32 times.
+//-----------------------------------------------------------------
+
+#pragma once
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#include <vector>
+#include <stdint.h>
+#include <stddef.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+//-----------------------------------------------------------------
+// RadixHeap Class
+//-----------------------------------------------------------------
+template<class Value>
+class RadixHeap
+{
+public:
+	static const int BUCKET_COUNT = 33;
+
+	//---------------------------
+	// Constructor(s)
+	//---------------------------
+	RadixHeap() : m_last(0), m_size(0)
+	{
+	}
+
+	//---------------------------
+	// Destructor
+	//---------------------------
+	virtual ~RadixHeap()
+	{
+	}
+
+	//---------------------------
+	// General Methods
+	//---------------------------
+	void Clear()
+	{
+		for (int bucket = 0; bucket < BUCKET_COUNT; ++bucket)
+		{
+			m_buckets[bucket].clear();
+		}
+		m_last = 0;
+		m_size = 0;
+	}
+
+	bool IsEmpty() const { return m_size == 0; }
+	int GetSize() const { return m_size; }
+
+	// key must not be lower than the key popped last
+	void Push(uint32_t key, const Value& valueRef)
+	{
+		Entry entry = { key, valueRef };
+		m_buckets[GetBucket(key)].push_back(entry);
+		++m_size;
+	}
+
+	// takes out an entry with the lowest key, the heap must not be empty
+	void Pop(uint32_t* keyPtr, Value* valuePtr)
+	{
+		if (m_buckets[0].empty())
+		{
+			// the lowest key of the first bucket in use becomes the new reference, which spreads that bucket over lower ones
+			int bucket = 1;
+			while (m_buckets[bucket].empty()) ++bucket;
+			std::vector<Entry>& bucketRef = m_buckets[bucket];
+			uint32_t lowestKey = bucketRef[0].key;
+			for (size_t i = 1; i < bucketRef.size(); ++i)
+			{
+				if (bucketRef[i].key < lowestKey) lowestKey = bucketRef[i].key;
+			}
+			m_last = lowestKey;
+			for (size_t i = 0; i < bucketRef.size(); ++i)
+			{
+				m_buckets[GetBucket(bucketRef[i].key)].push_back(bucketRef[i]);
+			}
+			bucketRef.clear();
+		}
+
+		const Entry& entryRef = m_buckets[0].back();
+		*keyPtr = entryRef.key;
+		*valuePtr = entryRef.value;
+		m_buckets[0].pop_back();
+		--m_size;
+	}
+
+private:
+	// -------------------------
+	// Internal structs
+	// -------------------------
+	struct Entry
+	{
+		uint32_t key;
+		Value value;
+	};
+
+	// -------------------------
+	// Member functions
+	// -------------------------
+
+	// 0 for the last popped key, otherwise 1 + the highest bit that differs from it
+	int GetBucket(uint32_t key) const
+	{
+		uint32_t difference = key ^ m_last;
+		if (difference == 0) return 0;
+#ifdef _MSC_VER
+		unsigned long highestBit;
+		_BitScanReverse(&highestBit, difference);
+		return (int) highestBit + 1;
+#else
+		return 32 - __builtin_clz(difference);
+#endif
+	}
+
+	// -------------------------
+	// Datamembers
+	// -------------------------
+	std::vector<Entry> m_buckets[BUCKET_COUNT];
+	uint32_t m_last;
+	int m_size;
+
+	// -------------------------
+	// Disabling default copy constructor and default assignment operator.
+	// If you get a linker error from one of these functions, your class is internally trying to use them. This is
+	// an error in your class, these declarations are deliberately made without implementation because they should never be used.
+	// -------------------------
+	RadixHeap(const RadixHeap& rhRef);
+	RadixHeap& operator=(const RadixHeap& rhRef);
+};
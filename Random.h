@@ -0,0 +1,98 @@
+//-----------------------------------------------------------------
+// Random Object
+// C++ Header - Random.h - version 2010 v2_07
+//
+// Random is a small seeded random number generator (xorshift64*). Unlike
+// rand() it has no global state and gives the same sequence for the same
+// seed on every compiler, so generated arenas and tournaments can be
+// reproduced from their seed alone.
+//-----------------------------------------------------------------
+
+#pragma once
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#include <stdint.h>
+#include <math.h>
+
+//-----------------------------------------------------------------
+// Random Class
+//-----------------------------------------------------------------
+class Random
+{
+public:
+	//---------------------------
+	// Constructor(s)
+	//---------------------------
+	Random(uint64_t seed = 0)
+	{
+		Seed(seed);
+	}
+
+	//---------------------------
+	// Destructor
+	//---------------------------
+	virtual ~Random()
+	{
+	}
+
+	//---------------------------
+	// General Methods
+	//---------------------------
+	void Seed(uint64_t seed)
+	{
+		// splitmix64 spreads similar seeds (0, 1, 2...) over the whole state, which must never be 0
+		uint64_t state = seed + 0x9e3779b97f4a7c15ULL;
+		state = (state ^ (state >> 30)) * 0xbf58476d1ce4e5b9ULL;
+		state = (state ^ (state >> 27)) * 0x94d049bb133111ebULL;
+		m_state = state ^ (state >> 31);
+		if (m_state == 0) m_state = 1;
+	}
+
+	uint64_t Next()
+	{
+		m_state ^= m_state >> 12;
+		m_state ^= m_state << 25;
+		m_state ^= m_state >> 27;
+		return m_state * 0x2545f4914f6cdd1dULL;
+	}
+
+	// 0 up to but not including bound, bound > 0
+	int NextInt(int bound)
+	{
+		return (int) (((Next() >> 32) * (uint64_t) bound) >> 32);
+	}
+
+	// min up to and including max
+	int NextInt(int min, int max)
+	{
+		return min + NextInt(max - min + 1);
+	}
+
+	// 0 up to but not including 1
+	double NextDouble()
+	{
+		return (double) (Next() >> 11) * (1.0 / 9007199254740992.0);
+	}
+
+	bool NextChance(double probability)
+	{
+		return NextDouble() < probability;
+	}
+
+	// normally distributed around 0 with a standard deviation of 1 (Box-Muller)
+	double NextGaussian()
+	{
+		double radius = sqrt(-2.0 * log(1.0 - NextDouble()));
+		return radius * cos(6.283185307179586 * NextDouble());
+	}
+
+	// Random is a value type on purpose: a copy continues the same sequence independently
+
+private:
+	// -------------------------
+	// Datamembers
+	// -------------------------
+	uint64_t m_state;
+};
@@ -0,0 +1,57 @@
+//-----------------------------------------------------------------
+// RandomBot Object
+// C++ Header - RandomBot.h - version 2010 v2_07
+//
+// RandomBot is the berserker of AIchallenge: every move goes in a random
+// direction, walls included.
+//-----------------------------------------------------------------
+
+#pragma once
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#include "Bot.h"
+#include "Random.h"
+
+//-----------------------------------------------------------------
+// RandomBot Class
+//-----------------------------------------------------------------
+class RandomBot : public Bot
+{
+public:
+	//---------------------------
+	// Constructor(s)
+	//---------------------------
+	RandomBot()
+	{
+	}
+
+	//---------------------------
+	// Destructor
+	//---------------------------
+	virtual ~RandomBot()
+	{
+	}
+
+	//---------------------------
+	// General Methods
+	//---------------------------
+	const char* GetName() const { return "berserker (random AI)"; }
+	void StartMatch(int player, uint64_t seed) { m_random.Seed(seed); }
+	int ChooseDirection(const ArenaGrid& arenaRef, const CELL* positionsPtr, int player) { return m_random.NextInt(4); }
+
+private:
+	// -------------------------
+	// Datamembers
+	// -------------------------
+	Random m_random;
+
+	// -------------------------
+	// Disabling default copy constructor and default assignment operator.
+	// If you get a linker error from one of these functions, your class is internally trying to use them. This is
+	// an error in your class, these declarations are deliberately made without implementation because they should never be used.
+	// -------------------------
+	RandomBot(const RandomBot& rbRef);
+	RandomBot& operator=(const RandomBot& rbRef);
+};
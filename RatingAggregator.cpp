@@ -0,0 +1,316 @@
+//-----------------------------------------------------------------
+// RatingAggregator Object
+// C++ Source - RatingAggregator.cpp - version 2010 v2_07
+//-----------------------------------------------------------------
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#include "RatingAggregator.h"
+#include <malloc.h>
+#include <math.h>
+#include <algorithm>
+
+//-----------------------------------------------------------------
+// Glicko-2 constants
+//-----------------------------------------------------------------
+static const double GLICKO_SCALE = 173.7178;			// Glicko to Glicko-2
+static const double INITIAL_RATING = 1500.0;
+static const double INITIAL_DEVIATION = 350.0;
+static const double INITIAL_VOLATILITY = 0.06;
+static const double VOLATILITY_EPSILON = 0.000001;
+static const double PI = 3.14159265358979323846;
+
+// how much a game against an opponent this uncertain counts
+static double GetWeight(double phi)
+{
+	return 1.0 / sqrt(1.0 + 3.0 * phi * phi / (PI * PI));
+}
+
+static bool IsBetter(const RATING& firstRef, const RATING& secondRef)
+{
+	return firstRef.rating > secondRef.rating;
+}
+
+//-----------------------------------------------------------------
+// RatingAggregator methods
+//-----------------------------------------------------------------
+RatingAggregator::RatingAggregator(int periodResults, double eloK, double tau) :
+	m_periodResults(periodResults), m_resultsInPeriod(0), m_eloK(eloK), m_tau(tau), m_processedCount(0),
+	m_thread(NULL), m_snapshotMilliseconds(1000), m_isStopping(false), m_listenerPtr(NULL)
+{
+	m_resultsPtr = (PSLIST_HEADER) _aligned_malloc(sizeof(SLIST_HEADER), MEMORY_ALLOCATION_ALIGNMENT);
+	m_freeNodesPtr = (PSLIST_HEADER) _aligned_malloc(sizeof(SLIST_HEADER), MEMORY_ALLOCATION_ALIGNMENT);
+	InitializeSListHead(m_resultsPtr);
+	InitializeSListHead(m_freeNodesPtr);
+	InitializeCriticalSection(&m_lock);
+	InitializeConditionVariable(&m_stopRequested);
+}
+
+RatingAggregator::~RatingAggregator()
+{
+	Stop();
+	PSLIST_ENTRY entryPtr = InterlockedFlushSList(m_freeNodesPtr);
+	while (entryPtr != NULL)
+	{
+		PSLIST_ENTRY nextPtr = entryPtr->Next;
+		_aligned_free(entryPtr);
+		entryPtr = nextPtr;
+	}
+	_aligned_free(m_resultsPtr);
+	_aligned_free(m_freeNodesPtr);
+	DeleteCriticalSection(&m_lock);
+}
+
+int RatingAggregator::AddPlayer(const char* namePtr)
+{
+	Player player;
+	player.namePtr = namePtr;
+	player.elo = INITIAL_RATING;
+	player.mu = 0.0;
+	player.phi = INITIAL_DEVIATION / GLICKO_SCALE;
+	player.sigma = INITIAL_VOLATILITY;
+	player.periodVariance = player.periodImprovement = 0.0;
+	player.games = player.wins = player.draws = player.losses = 0;
+	m_players.push_back(player);
+	return (int) m_players.size() - 1;
+}
+
+void RatingAggregator::Start(DWORD snapshotMilliseconds)
+{
+	if (m_thread != NULL) return;
+	m_snapshotMilliseconds = snapshotMilliseconds;
+	m_isStopping = false;
+	TakeSnapshot();
+	m_thread = CreateThread(NULL, 0, ThreadProc, this, 0, NULL);
+}
+
+void RatingAggregator::Stop()
+{
+	if (m_thread == NULL) return;
+
+	EnterCriticalSection(&m_lock);
+	m_isStopping = true;
+	WakeConditionVariable(&m_stopRequested);
+	LeaveCriticalSection(&m_lock);
+	WaitForSingleObject(m_thread, INFINITE);
+	CloseHandle(m_thread);
+	m_thread = NULL;
+
+	// the thread is gone, so this thread owns the players now
+	ProcessResults();
+	if (m_resultsInPeriod > 0) CloseRatingPeriod();
+	TakeSnapshot();
+}
+
+void RatingAggregator::Submit(int first, int second, double firstScore)
+{
+	// nodes are recycled by the aggregator; the interlocked list is safe against a node being popped and pushed back in between
+	ResultNode* nodePtr = (ResultNode*) InterlockedPopEntrySList(m_freeNodesPtr);
+	if (nodePtr == NULL) nodePtr = (ResultNode*) _aligned_malloc(sizeof(ResultNode), MEMORY_ALLOCATION_ALIGNMENT);
+	nodePtr->first = first;
+	nodePtr->second = second;
+	nodePtr->firstScore = firstScore;
+	InterlockedPushEntrySList(m_resultsPtr, &nodePtr->entry);
+}
+
+void RatingAggregator::GetLeaderboard(std::vector<RATING>& leaderboardRef)
+{
+	EnterCriticalSection(&m_lock);
+	leaderboardRef = m_leaderboard;
+	LeaveCriticalSection(&m_lock);
+}
+
+double RatingAggregator::GetExpectedScore(double elo, double opponentElo)
+{
+	return 1.0 / (1.0 + pow(10.0, (opponentElo - elo) / 400.0));
+}
+
+DWORD WINAPI RatingAggregator::ThreadProc(LPVOID parameter)
+{
+	((RatingAggregator*) parameter)->AggregatorLoop();
+	return 0;
+}
+
+void RatingAggregator::AggregatorLoop()
+{
+	DWORD lastSnapshot = GetTickCount();
+	for (;;)
+	{
+		EnterCriticalSection(&m_lock);
+		if (!m_isStopping) SleepConditionVariableCS(&m_stopRequested, &m_lock, POLL_MILLISECONDS);
+		bool isStopping = m_isStopping;
+		LeaveCriticalSection(&m_lock);
+		if (isStopping) return;		// Stop takes in the rest
+
+		ProcessResults();
+		if (GetTickCount() - lastSnapshot >= m_snapshotMilliseconds)
+		{
+			TakeSnapshot();
+			lastSnapshot = GetTickCount();
+		}
+	}
+}
+
+void RatingAggregator::ProcessResults()
+{
+	// the list comes out newest first; reversed, Elo sees the results in the order they were submitted
+	PSLIST_ENTRY entryPtr = InterlockedFlushSList(m_resultsPtr);
+	PSLIST_ENTRY oldestPtr = NULL;
+	while (entryPtr != NULL)
+	{
+		PSLIST_ENTRY nextPtr = entryPtr->Next;
+		entryPtr->Next = oldestPtr;
+		oldestPtr = entryPtr;
+		entryPtr = nextPtr;
+	}
+
+	while (oldestPtr != NULL)
+	{
+		PSLIST_ENTRY nextPtr = oldestPtr->Next;
+		Apply(*(ResultNode*) oldestPtr);
+		InterlockedPushEntrySList(m_freeNodesPtr, oldestPtr);
+		oldestPtr = nextPtr;
+	}
+}
+
+void RatingAggregator::Apply(const ResultNode& resultRef)
+{
+	Player& firstRef = m_players[resultRef.first];
+	Player& secondRef = m_players[resultRef.second];
+	double score = resultRef.firstScore;
+
+	// Elo moves after every game
+	double expected = GetExpectedScore(firstRef.elo, secondRef.elo);
+	firstRef.elo += m_eloK * (score - expected);
+	secondRef.elo -= m_eloK * (score - expected);
+
+	// Glicko-2 rates a whole period against the ratings the period started with, so every game only adds to the sums
+	double firstWeight = GetWeight(secondRef.phi), secondWeight = GetWeight(firstRef.phi);
+	double firstExpected = 1.0 / (1.0 + exp(-firstWeight * (firstRef.mu - secondRef.mu)));
+	double secondExpected = 1.0 / (1.0 + exp(-secondWeight * (secondRef.mu - firstRef.mu)));
+	firstRef.periodVariance += firstWeight * firstWeight * firstExpected * (1.0 - firstExpected);
+	firstRef.periodImprovement += firstWeight * (score - firstExpected);
+	secondRef.periodVariance += secondWeight * secondWeight * secondExpected * (1.0 - secondExpected);
+	secondRef.periodImprovement += secondWeight * ((1.0 - score) - secondExpected);
+
+	++firstRef.games;
+	++secondRef.games;
+	if (score > 0.5)
+	{
+		++firstRef.wins;
+		++secondRef.losses;
+	}
+	else if (score < 0.5)
+	{
+		++firstRef.losses;
+		++secondRef.wins;
+	}
+	else
+	{
+		++firstRef.draws;
+		++secondRef.draws;
+	}
+
+	++m_processedCount;
+	if (++m_resultsInPeriod == m_periodResults) CloseRatingPeriod();
+}
+
+void RatingAggregator::CloseRatingPeriod()
+{
+	double maxPhi = INITIAL_DEVIATION / GLICKO_SCALE;
+	for (size_t i = 0; i < m_players.size(); ++i)
+	{
+		Player& playerRef = m_players[i];
+		if (playerRef.periodVariance == 0.0)
+		{
+			// no games: only the uncertainty grows
+			playerRef.phi = std::min(sqrt(playerRef.phi * playerRef.phi + playerRef.sigma * playerRef.sigma), maxPhi);
+			continue;
+		}
+
+		double variance = 1.0 / playerRef.periodVariance;
+		double improvement = variance * playerRef.periodImprovement;
+		playerRef.sigma = GetNewVolatility(playerRef, variance, improvement);
+		double phiStar = sqrt(playerRef.phi * playerRef.phi + playerRef.sigma * playerRef.sigma);
+		playerRef.phi = 1.0 / sqrt(1.0 / (phiStar * phiStar) + 1.0 / variance);
+		playerRef.mu += playerRef.phi * playerRef.phi * playerRef.periodImprovement;
+		playerRef.periodVariance = playerRef.periodImprovement = 0.0;
+	}
+	m_resultsInPeriod = 0;
+}
+
+// step 5 of Glickman's Glicko-2 description: the root of f by the Illinois variant of regula falsi
+double RatingAggregator::GetNewVolatility(const Player& playerRef, double variance, double improvement) const
+{
+	double phiSquared = playerRef.phi * playerRef.phi;
+	double a = log(playerRef.sigma * playerRef.sigma);
+	double tauSquared = m_tau * m_tau;
+	struct Function
+	{
+		double improvementSquared, phiSquared, variance, a, tauSquared;
+		double operator()(double x) const
+		{
+			double ex = exp(x);
+			double denominator = phiSquared + variance + ex;
+			return ex * (improvementSquared - phiSquared - variance - ex) / (2.0 * denominator * denominator) - (x - a) / tauSquared;
+		}
+	};
+	Function f = { improvement * improvement, phiSquared, variance, a, tauSquared };
+
+	double lower = a, upper;
+	if (improvement * improvement > phiSquared + variance)
+	{
+		upper = log(improvement * improvement - phiSquared - variance);
+	}
+	else
+	{
+		int k = 1;
+		while (f(a - k * m_tau) < 0.0) ++k;
+		upper = a - k * m_tau;
+	}
+
+	double fLower = f(lower), fUpper = f(upper);
+	while (fabs(upper - lower) > VOLATILITY_EPSILON)
+	{
+		double middle = lower + (lower - upper) * fLower / (fUpper - fLower);
+		double fMiddle = f(middle);
+		if (fMiddle * fUpper <= 0.0)
+		{
+			lower = upper;
+			fLower = fUpper;
+		}
+		else
+		{
+			fLower /= 2.0;
+		}
+		upper = middle;
+		fUpper = fMiddle;
+	}
+	return exp(lower / 2.0);
+}
+
+void RatingAggregator::TakeSnapshot()
+{
+	std::vector<RATING> leaderboard(m_players.size());
+	for (size_t i = 0; i < m_players.size(); ++i)
+	{
+		const Player& playerRef = m_players[i];
+		RATING& ratingRef = leaderboard[i];
+		ratingRef.namePtr = playerRef.namePtr;
+		ratingRef.elo = playerRef.elo;
+		ratingRef.rating = INITIAL_RATING + GLICKO_SCALE * playerRef.mu;
+		ratingRef.deviation = GLICKO_SCALE * playerRef.phi;
+		ratingRef.volatility = playerRef.sigma;
+		ratingRef.games = playerRef.games;
+		ratingRef.wins = playerRef.wins;
+		ratingRef.draws = playerRef.draws;
+		ratingRef.losses = playerRef.losses;
+	}
+	std::stable_sort(leaderboard.begin(), leaderboard.end(), IsBetter);
+
+	EnterCriticalSection(&m_lock);
+	m_leaderboard = leaderboard;
+	LeaveCriticalSection(&m_lock);
+	if (m_listenerPtr != NULL) m_listenerPtr->LeaderboardUpdated(leaderboard);
+}
@@ -0,0 +1,147 @@
+//-----------------------------------------------------------------
+// RatingAggregator Object
+// C++ Header - RatingAggregator.h - version 2010 v2_07
+//
+// RatingAggregator rates the players of a tournament while it runs.
+// Worker threads submit match results through a lock free list (an
+// interlocked SLIST), and one aggregator thread picks them up every few
+// milliseconds and updates an Elo rating after every result and a
+// Glicko-2 rating, deviation and volatility after every rating period
+// of a fixed number of results. Every snapshot interval the leaderboard
+// is copied, sorted by Glicko-2 rating, and handed to the listener, so
+// a long tournament can be watched without storing its results.
+//
+// Results from several threads arrive in no fixed order, so the Elo
+// ratings of two runs of the same tournament can differ slightly.
+//-----------------------------------------------------------------
+
+#pragma once
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <vector>
+
+//-----------------------------------------------------------------
+// Structs
+//-----------------------------------------------------------------
+struct RATING
+{
+	const char* namePtr;
+	double elo;
+	double rating, deviation, volatility;		// Glicko-2, on the Glicko scale of 1500 +- 350
+	int games, wins, draws, losses;
+};
+
+//-----------------------------------------------------------------
+// LeaderboardListener Class
+//-----------------------------------------------------------------
+class LeaderboardListener
+{
+public:
+	virtual ~LeaderboardListener() {}											// virtual destructor for polymorphism
+	virtual void LeaderboardUpdated(const std::vector<RATING>& leaderboardRef) = 0;	// called on the aggregator thread, best player first
+};
+
+//-----------------------------------------------------------------
+// RatingAggregator Class
+//-----------------------------------------------------------------
+class RatingAggregator
+{
+public:
+	static const int POLL_MILLISECONDS = 10;		// how often the aggregator picks up the submitted results
+
+	//---------------------------
+	// Constructor(s)
+	//---------------------------
+	// periodResults: results per Glicko-2 rating period; eloK: the Elo K factor; tau: how fast the Glicko-2 volatility may change
+	RatingAggregator(int periodResults = 1000, double eloK = 16.0, double tau = 0.5);
+
+	//---------------------------
+	// Destructor
+	//---------------------------
+	virtual ~RatingAggregator();
+
+	//---------------------------
+	// General Methods
+	//---------------------------
+	// only while stopped; the name is not copied. Returns the id results are submitted with
+	int AddPlayer(const char* namePtr);
+
+	// only while stopped; NULL for none
+	void SetListener(LeaderboardListener* listenerPtr) { m_listenerPtr = listenerPtr; }
+
+	void Start(DWORD snapshotMilliseconds = 1000);
+
+	// takes in every result submitted so far, closes the rating period and takes a last snapshot
+	void Stop();
+
+	// from any thread while started; firstScore is 1 when first won, 0.5 for a draw and 0 when second won
+	void Submit(int first, int second, double firstScore);
+
+	// a copy of the last snapshot, best player first
+	void GetLeaderboard(std::vector<RATING>& leaderboardRef);
+
+	LONGLONG GetProcessedCount() const { return m_processedCount; }
+
+	static double GetExpectedScore(double elo, double opponentElo);
+
+private:
+	// -------------------------
+	// Internal structs
+	// -------------------------
+	struct ResultNode
+	{
+		SLIST_ENTRY entry;				// first, so a node and its entry share the address
+		int first, second;
+		double firstScore;
+	};
+
+	struct Player
+	{
+		const char* namePtr;
+		double elo;
+		double mu, phi, sigma;			// Glicko-2 on its own scale
+		double periodVariance;			// sum of g^2 E (1 - E) over the games of the current period
+		double periodImprovement;		// sum of g (s - E)
+		int games, wins, draws, losses;
+	};
+
+	// -------------------------
+	// Member functions
+	// -------------------------
+	static DWORD WINAPI ThreadProc(LPVOID parameter);
+	void AggregatorLoop();
+	void ProcessResults();
+	void Apply(const ResultNode& resultRef);
+	void CloseRatingPeriod();
+	double GetNewVolatility(const Player& playerRef, double variance, double improvement) const;
+	void TakeSnapshot();
+
+	// -------------------------
+	// Datamembers
+	// -------------------------
+	PSLIST_HEADER m_resultsPtr, m_freeNodesPtr;		// aligned as the interlocked lists require
+	int m_periodResults, m_resultsInPeriod;
+	double m_eloK, m_tau;
+	std::vector<Player> m_players;					// owned by the aggregator thread while started
+	volatile LONGLONG m_processedCount;
+
+	HANDLE m_thread;
+	DWORD m_snapshotMilliseconds;
+	CRITICAL_SECTION m_lock;
+	CONDITION_VARIABLE m_stopRequested;
+	bool m_isStopping;
+	std::vector<RATING> m_leaderboard;
+	LeaderboardListener* m_listenerPtr;
+
+	// -------------------------
+	// Disabling default copy constructor and default assignment operator.
+	// If you get a linker error from one of these functions, your class is internally trying to use them. This is
+	// an error in your class, these declarations are deliberately made without implementation because they should never be used.
+	// -------------------------
+	RatingAggregator(const RatingAggregator& raRef);
+	RatingAggregator& operator=(const RatingAggregator& raRef);
+};
@@ -0,0 +1,19 @@
+//-----------------------------------------------------------------
+// RigidCellListener Interface
+// C++ Header - RigidCellListener.h - version 2010 v2_07
+//
+// Interface for classes that keep data derived from the arena and want to
+// hear about every cell that becomes rigid (see AIchallenge::MakeRigid).
+//-----------------------------------------------------------------
+
+#pragma once
+
+//-----------------------------------------------------------------
+// RigidCellListener Class
+//-----------------------------------------------------------------
+class RigidCellListener
+{
+public:
+	virtual ~RigidCellListener() {}					// virtual destructor for polymorphism
+	virtual void CellBecameRigid(int x, int y) = 0;	// called after the grid cell has been made rigid
+};
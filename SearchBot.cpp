@@ -0,0 +1,343 @@
+//-----------------------------------------------------------------
+// SearchBot Object
+// C++ Source - SearchBot.cpp - version 2010 v2_07
+//-----------------------------------------------------------------
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#include "SearchBot.h"
+
+//-----------------------------------------------------------------
+// SearchTask Class
+//-----------------------------------------------------------------
+// one item per search thread; which pool thread runs it doesn't matter
+class SearchTask : public WorkerTask
+{
+public:
+	SearchTask(SearchBot* botPtr) : m_botPtr(botPtr)
+	{
+	}
+
+	void Execute(int thread, int first, int last)
+	{
+		for (int item = first; item < last; ++item) m_botPtr->SearchRoot(item);
+	}
+
+private:
+	SearchBot* m_botPtr;
+
+	// -------------------------
+	// Disabling default copy constructor and default assignment operator.
+	// If you get a linker error from one of these functions, your class is internally trying to use them. This is
+	// an error in your class, these declarations are deliberately made without implementation because they should never be used.
+	// -------------------------
+	SearchTask(const SearchTask& stRef);
+	SearchTask& operator=(const SearchTask& stRef);
+};
+
+//-----------------------------------------------------------------
+// SearchBot methods
+//-----------------------------------------------------------------
+SearchBot::SearchBot(int threadCount, int tableSizeLog2) : m_pool(threadCount), m_table(tableSizeLog2), m_maxDepth(MAX_DEPTH), m_budget(0), m_deadline(0), m_searchCount(0),
+	m_isStopping(0), m_bestDepth(0), m_bestScore(0), m_bestDirection(0)
+{
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+	m_countsPerNanosecond = frequency.QuadPart / 1000000000.0;
+	InitializeCriticalSection(&m_lock);
+	for (int i = 0; i < m_pool.GetThreadCount(); ++i)
+	{
+		SearchThread* threadPtr = new SearchThread();
+		threadPtr->stamp = 0;
+		m_threadPtrs.push_back(threadPtr);
+	}
+}
+
+SearchBot::~SearchBot()
+{
+	for (size_t i = 0; i < m_threadPtrs.size(); ++i) delete m_threadPtrs[i];
+	DeleteCriticalSection(&m_lock);
+}
+
+void SearchBot::StartMatch(int player, uint64_t seed)
+{
+	// the keys change every search, so old entries can't be mistaken for new ones; clearing only gives the memory back to the cache
+	m_table.Clear();
+}
+
+void SearchBot::SetOrdering(int heuristics)
+{
+	for (size_t i = 0; i < m_threadPtrs.size(); ++i) m_threadPtrs[i]->ordering.SetHeuristics(heuristics);
+}
+
+void SearchBot::SetLimits(int maxDepth, LONGLONG nanoseconds)
+{
+	m_maxDepth = maxDepth < 1 ? 1 : maxDepth > MAX_DEPTH ? MAX_DEPTH : maxDepth;
+	m_budget = nanoseconds;
+}
+
+int SearchBot::ChooseDirection(const ArenaGrid& arenaRef, const CELL* positionsPtr, int player)
+{
+	LARGE_INTEGER now;
+	QueryPerformanceCounter(&now);
+	// a quarter of the budget is left for the threads to notice and for the pool to return
+	m_deadline = now.QuadPart + (LONGLONG) (m_budget * 3 / 4 * m_countsPerNanosecond);
+
+	const CELL& headRef = positionsPtr[player];
+	m_bestDirection = -1;
+	for (int direction = 0; direction < 4 && m_bestDirection < 0; ++direction)
+	{
+		if (!arenaRef.IsRigid(headRef.x + DIRECTION_DX[direction], headRef.y + DIRECTION_DY[direction])) m_bestDirection = direction;
+	}
+	for (size_t i = 0; i < m_threadPtrs.size(); ++i) m_threadPtrs[i]->nodes = 0;
+	m_bestDepth = 0;
+	m_bestScore = 0;
+	if (m_bestDirection < 0) return 0;
+
+	++m_searchCount;
+	uint64_t rootHash = Mix(m_searchCount * 0x9e3779b97f4a7c15ULL) ^ (player == 1 ? Mix(1) : 0);
+	for (int i = 0; i < 2; ++i) rootHash ^= HeadKey(i, arenaRef.Index(positionsPtr[i].x, positionsPtr[i].y));
+	for (size_t i = 0; i < m_threadPtrs.size(); ++i)
+	{
+		SearchThread& threadRef = *m_threadPtrs[i];
+		threadRef.arena = arenaRef;
+		threadRef.heads[0] = positionsPtr[0];
+		threadRef.heads[1] = positionsPtr[1];
+		threadRef.arena.SetRigid(positionsPtr[0].x, positionsPtr[0].y);
+		threadRef.arena.SetRigid(positionsPtr[1].x, positionsPtr[1].y);
+		threadRef.side = player;
+		threadRef.hash = rootHash;
+		threadRef.ordering.NewSearch(arenaRef.GetCellCount());
+		if ((int) threadRef.stamps.size() != arenaRef.GetCellCount())
+		{
+			threadRef.stamps.assign(arenaRef.GetCellCount(), 0);
+			threadRef.distances.assign(arenaRef.GetCellCount(), 0);
+			threadRef.owners.assign(arenaRef.GetCellCount(), 0);
+			threadRef.queue.resize(arenaRef.GetCellCount());
+			threadRef.stamp = 0;
+		}
+	}
+
+	m_table.NewSearch();
+	m_isStopping = 0;
+	SearchTask task(this);
+	m_pool.Run(task, (int) m_threadPtrs.size());
+	return m_bestDirection;
+}
+
+LONGLONG SearchBot::GetNodeCount() const
+{
+	LONGLONG nodes = 0;
+	for (size_t i = 0; i < m_threadPtrs.size(); ++i) nodes += m_threadPtrs[i]->nodes;
+	return nodes;
+}
+
+void SearchBot::SearchRoot(int item)
+{
+	SearchThread& threadRef = *m_threadPtrs[item];
+	for (int depth = 1 + (item & 1); depth <= m_maxDepth && !m_isStopping; ++depth)
+	{
+		int score = Search(threadRef, depth, -WIN_SCORE - 1, WIN_SCORE + 1, 0, item);
+		if (m_isStopping) break;		// an unfinished iteration says nothing
+
+		EnterCriticalSection(&m_lock);
+		if (depth > m_bestDepth)
+		{
+			m_bestDepth = depth;
+			m_bestScore = score;
+			m_bestDirection = threadRef.rootMove;
+		}
+		LeaveCriticalSection(&m_lock);
+
+		// a proven result doesn't get better with depth
+		if (score > WIN_SCORE - MAX_DEPTH || score < -WIN_SCORE + MAX_DEPTH) break;
+	}
+
+	// the first thread done stops the others: what they still search is either shallower or unfinished
+	InterlockedExchange(&m_isStopping, 1);
+}
+
+int SearchBot::Search(SearchThread& threadRef, int depth, int alpha, int beta, int ply, int item)
+{
+	if ((++threadRef.nodes & (CHECK_INTERVAL - 1)) == 0 && IsTimeUp()) InterlockedExchange(&m_isStopping, 1);
+	if (m_isStopping) return 0;
+
+	int side = threadRef.side;
+	const CELL& headRef = threadRef.heads[side];
+	int cell = threadRef.arena.Index(headRef.x, headRef.y);
+	int moves[4], count = 0;
+	for (int direction = 0; direction < 4; ++direction)
+	{
+		if (!threadRef.arena.IsRigid(headRef.x + DIRECTION_DX[direction], headRef.y + DIRECTION_DY[direction])) moves[count++] = direction;
+	}
+	if (count == 0) return -WIN_SCORE + ply;
+	if (depth == 0) return Evaluate(threadRef);
+
+	// the table keeps win and loss scores relative to the position, the search relative to the root
+	TABLE_ENTRY entry;
+	int tableMove = -1;
+	if (m_table.Probe(threadRef.hash, entry))
+	{
+		tableMove = entry.move;
+		int score = entry.score;
+		if (score > WIN_SCORE - MAX_DEPTH) score -= ply;
+		else if (score < -WIN_SCORE + MAX_DEPTH) score += ply;
+		if (ply > 0 && entry.depth >= depth)
+		{
+			if (entry.bound == TranspositionTable::EXACT) return score;
+			if (entry.bound == TranspositionTable::LOWER && score >= beta) return score;
+			if (entry.bound == TranspositionTable::UPPER && score <= alpha) return score;
+		}
+	}
+
+	MoveOrdering& orderingRef = threadRef.ordering;
+	int hints[4];
+	if (orderingRef.IsEnabled(MoveOrdering::TERRITORY))
+	{
+		for (int i = 0; i < count; ++i)
+		{
+			CELL next = { headRef.x + DIRECTION_DX[moves[i]], headRef.y + DIRECTION_DY[moves[i]] };
+			if (ply < TERRITORY_PLIES && depth > 2)
+			{
+				Make(threadRef, moves[i]);
+				hints[moves[i]] = -Evaluate(threadRef);
+				Unmake(threadRef, moves[i]);
+			}
+			else hints[moves[i]] = 4 - threadRef.arena.CountRigidNeighbours(next.x, next.y);
+		}
+	}
+	int ordered[4];
+	for (int i = 0; i < count; ++i) ordered[i] = moves[i];
+	orderingRef.Order(side, cell, ply, tableMove, hints, ordered, count);
+
+	// at the root every helper starts elsewhere, so they don't all search the same moves in the same order
+	if (ply == 0 && item > 0)
+	{
+		for (int i = 0; i < count; ++i) moves[i] = ordered[(item + i) % count];
+		for (int i = 0; i < count; ++i) ordered[i] = moves[i];
+	}
+
+	int alphaStart = alpha;
+	int bestScore = -WIN_SCORE - 1, bestMove = ordered[0];
+	for (int i = 0; i < count; ++i)
+	{
+		Make(threadRef, ordered[i]);
+		int score = -Search(threadRef, depth - 1, -beta, -alpha, ply + 1, item);
+		Unmake(threadRef, ordered[i]);
+		if (m_isStopping) return 0;
+		if (score > bestScore)
+		{
+			bestScore = score;
+			bestMove = ordered[i];
+			if (score > alpha) alpha = score;
+			if (alpha >= beta)
+			{
+				orderingRef.RecordCutoff(side, cell, ply, depth, ordered, i);
+				break;
+			}
+		}
+	}
+
+	TranspositionTable::Bound bound = bestScore <= alphaStart ? TranspositionTable::UPPER : bestScore >= beta ? TranspositionTable::LOWER : TranspositionTable::EXACT;
+	int tableScore = bestScore;
+	if (tableScore > WIN_SCORE - MAX_DEPTH) tableScore += ply;
+	else if (tableScore < -WIN_SCORE + MAX_DEPTH) tableScore -= ply;
+	m_table.Store(threadRef.hash, tableScore, depth, bound, bestMove);
+	if (ply == 0) threadRef.rootMove = bestMove;
+	return bestScore;
+}
+
+// a breadth first search from both heads at once: a cell belongs to the player that reaches it first, a tie to nobody
+int SearchBot::Evaluate(SearchThread& threadRef)
+{
+	const ArenaGrid& arenaRef = threadRef.arena;
+	if (++threadRef.stamp == 0x7fffffff)
+	{
+		threadRef.stamps.assign(threadRef.stamps.size(), 0);
+		threadRef.stamp = 1;
+	}
+	int stamp = threadRef.stamp;
+	int counts[3] = { 0, 0, 0 };
+	int tail = 0;
+	for (int player = 0; player < 2; ++player)
+	{
+		int index = arenaRef.Index(threadRef.heads[player].x, threadRef.heads[player].y);
+		threadRef.stamps[index] = stamp;
+		threadRef.distances[index] = 0;
+		threadRef.owners[index] = player;
+		threadRef.queue[tail++] = threadRef.heads[player];
+	}
+	for (int head = 0; head < tail; ++head)
+	{
+		CELL cell = threadRef.queue[head];
+		int index = arenaRef.Index(cell.x, cell.y);
+		int owner = threadRef.owners[index], distance = threadRef.distances[index] + 1;
+		for (int direction = 0; direction < 4; ++direction)
+		{
+			CELL next = { cell.x + DIRECTION_DX[direction], cell.y + DIRECTION_DY[direction] };
+			if (arenaRef.IsRigid(next.x, next.y)) continue;
+			int nextIndex = arenaRef.Index(next.x, next.y);
+			if (threadRef.stamps[nextIndex] != stamp)
+			{
+				threadRef.stamps[nextIndex] = stamp;
+				threadRef.distances[nextIndex] = distance;
+				threadRef.owners[nextIndex] = owner;
+				threadRef.queue[tail++] = next;
+				++counts[owner];
+			}
+			else if (threadRef.distances[nextIndex] == distance && threadRef.owners[nextIndex] != owner && threadRef.owners[nextIndex] != 2)
+			{
+				// reached by both at once; the whole layer is done before the next, so it is neutral before it spreads
+				--counts[threadRef.owners[nextIndex]];
+				threadRef.owners[nextIndex] = 2;
+				++counts[2];
+			}
+		}
+	}
+	int score = counts[threadRef.side] - counts[1 - threadRef.side];
+	return score > WIN_SCORE / 2 ? WIN_SCORE / 2 : score < -WIN_SCORE / 2 ? -WIN_SCORE / 2 : score;
+}
+
+void SearchBot::Make(SearchThread& threadRef, int direction)
+{
+	int side = threadRef.side;
+	CELL& headRef = threadRef.heads[side];
+	int from = threadRef.arena.Index(headRef.x, headRef.y);
+	headRef.x += DIRECTION_DX[direction];
+	headRef.y += DIRECTION_DY[direction];
+	int to = threadRef.arena.Index(headRef.x, headRef.y);
+	threadRef.arena.SetRigid(headRef.x, headRef.y);
+	threadRef.hash ^= HeadKey(side, from) ^ HeadKey(side, to) ^ CellKey(to) ^ Mix(1);
+	threadRef.side = 1 - side;
+}
+
+void SearchBot::Unmake(SearchThread& threadRef, int direction)
+{
+	int side = 1 - threadRef.side;
+	CELL& headRef = threadRef.heads[side];
+	int to = threadRef.arena.Index(headRef.x, headRef.y);
+	threadRef.arena.SetFree(headRef.x, headRef.y);
+	headRef.x -= DIRECTION_DX[direction];
+	headRef.y -= DIRECTION_DY[direction];
+	int from = threadRef.arena.Index(headRef.x, headRef.y);
+	threadRef.hash ^= HeadKey(side, from) ^ HeadKey(side, to) ^ CellKey(to) ^ Mix(1);
+	threadRef.side = side;
+}
+
+bool SearchBot::IsTimeUp() const
+{
+	if (m_budget <= 0) return false;
+	LARGE_INTEGER now;
+	QueryPerformanceCounter(&now);
+	return now.QuadPart >= m_deadline;
+}
+
+// splitmix64: the keys are computed when needed instead of kept in a table as big as the arena
+uint64_t SearchBot::Mix(uint64_t value)
+{
+	value += 0x9e3779b97f4a7c15ULL;
+	value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+	return value ^ (value >> 31);
+}
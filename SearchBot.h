@@ -0,0 +1,134 @@
+//-----------------------------------------------------------------
+// SearchBot Object
+// C++ Header - SearchBot.h - version 2010 v2_07
+//
+// SearchBot plays with an alpha-beta search, on every thread of its
+// WorkerPool at once in the Lazy SMP way: every thread searches the same
+// root with iterative deepening, the odd threads one move deeper, and
+// they only share a TranspositionTable. What one thread has found cuts
+// off the search of the others, so together they get deeper without any
+// work being handed out. The deepest finished iteration decides.
+//
+// The positions follow the rules of Match, with both heads taken as
+// rigid; a player without a free neighbour loses. The leaves are scored
+// by territory: the free cells a player reaches before the opponent.
+// Every thread orders its moves with its own MoveOrdering; near the root
+// the territory after every move is its hint, deeper down the free
+// neighbours of the cell moved to.
+//
+// The move budget works as for any bot: Match times ChooseDirection and
+// applies its BUDGET_POLICY afterwards. Given the same budget with
+// SetLimits, the threads stop themselves in time to stay within it.
+//-----------------------------------------------------------------
+
+#pragma once
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#include "Bot.h"
+#include "TranspositionTable.h"
+#include "MoveOrdering.h"
+#include "WorkerPool.h"
+#include <vector>
+
+//-----------------------------------------------------------------
+// SearchBot Class
+//-----------------------------------------------------------------
+class SearchBot : public Bot
+{
+public:
+	static const int WIN_SCORE = 30000;		// minus the plies to the win, so a faster win scores higher
+	static const int MAX_DEPTH = 64;
+	static const int CHECK_INTERVAL = 64;		// nodes between two looks at the clock
+	static const int TERRITORY_PLIES = 2;		// how near the root the territory after a move is measured for the ordering
+
+	//---------------------------
+	// Constructor(s)
+	//---------------------------
+	SearchBot(int threadCount = 0, int tableSizeLog2 = 20);		// 0 threads for one per processor
+
+	//---------------------------
+	// Destructor
+	//---------------------------
+	virtual ~SearchBot();
+
+	//---------------------------
+	// General Methods
+	//---------------------------
+	const char* GetName() const { return "search (parallel alpha-beta AI)"; }
+	void StartMatch(int player, uint64_t seed);
+	int ChooseDirection(const ArenaGrid& arenaRef, const CELL* positionsPtr, int player);
+
+	// maxDepth in moves of either player; nanoseconds is the move budget, 0 for none
+	void SetLimits(int maxDepth, LONGLONG nanoseconds);
+
+	// MoveOrdering::Heuristic flags, ALL_HEURISTICS by default
+	void SetOrdering(int heuristics);
+
+	int GetThreadCount() const { return (int) m_threadPtrs.size(); }
+
+	// about the last decision
+	LONGLONG GetNodeCount() const;
+	int GetDepth() const { return m_bestDepth; }
+	int GetScore() const { return m_bestScore; }
+
+private:
+	friend class SearchTask;
+
+	// -------------------------
+	// Internal structs
+	// -------------------------
+	struct SearchThread
+	{
+		ArenaGrid arena;
+		CELL heads[2];
+		int side;							// the player to move
+		uint64_t hash;
+		LONGLONG nodes;
+		int rootMove;
+		MoveOrdering ordering;
+		std::vector<int> stamps, distances, owners;		// territory scratch, per arena index
+		std::vector<CELL> queue;
+		int stamp;
+	};
+
+	// -------------------------
+	// Member functions
+	// -------------------------
+	void SearchRoot(int item);		// the iterative deepening of one thread
+	int Search(SearchThread& threadRef, int depth, int alpha, int beta, int ply, int item);
+	int Evaluate(SearchThread& threadRef);
+	void Make(SearchThread& threadRef, int direction);
+	void Unmake(SearchThread& threadRef, int direction);
+	bool IsTimeUp() const;
+
+	static uint64_t Mix(uint64_t value);
+	static uint64_t CellKey(int index) { return Mix((uint64_t) index * 4); }
+	static uint64_t HeadKey(int player, int index) { return Mix((uint64_t) index * 4 + 1 + player); }
+
+	// -------------------------
+	// Datamembers
+	// -------------------------
+	WorkerPool m_pool;
+	TranspositionTable m_table;
+	std::vector<SearchThread*> m_threadPtrs;
+	int m_maxDepth;
+	LONGLONG m_budget;
+	double m_countsPerNanosecond;
+	LONGLONG m_deadline;		// performance counter
+	uint64_t m_searchCount;
+
+	// shared by the threads during a search
+	volatile LONG m_isStopping;
+	CRITICAL_SECTION m_lock;
+	int m_bestDepth, m_bestScore, m_bestDirection;
+
+	// -------------------------
+	// Disabling default copy constructor and default assignment operator.
+	// If you get a linker error from one of these functions, your class is internally trying to use them. This is
+	// an error in your class, these declarations are deliberately made without implementation because they should never be used.
+	// -------------------------
+	SearchBot(const SearchBot& sbRef);
+	SearchBot& operator=(const SearchBot& sbRef);
+};
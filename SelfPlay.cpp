@@ -0,0 +1,355 @@
+//-----------------------------------------------------------------
+// SelfPlay Objects
+// C++ Source - SelfPlay.cpp - version 2010 v2_07
+//-----------------------------------------------------------------
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#include "SelfPlay.h"
+#include "Match.h"
+#include <string.h>
+
+//-----------------------------------------------------------------
+// Shard format
+//-----------------------------------------------------------------
+static const uint32_t SHARD_VERSION = 1;
+static const uint32_t SAMPLE_BYTES = sizeof(PLAY_SAMPLE);
+static const int SHARD_HEADER_BYTES = 12;
+static const int BLOCK_HEADER_BYTES = 8;
+
+static void PutUint32(unsigned char* outputPtr, uint32_t value)
+{
+	memcpy(outputPtr, &value, sizeof(value));
+}
+
+static uint32_t GetUint32(const unsigned char* inputPtr)
+{
+	uint32_t value;
+	memcpy(&value, inputPtr, sizeof(value));
+	return value;
+}
+
+static bool ReadBytes(HANDLE file, void* bufferPtr, DWORD size)
+{
+	DWORD bytesRead = 0;
+	return ReadFile(file, bufferPtr, size, &bytesRead, NULL) && bytesRead == size;
+}
+
+//-----------------------------------------------------------------
+// SelfPlayWriter methods
+//-----------------------------------------------------------------
+SelfPlayWriter::SelfPlayWriter() : m_blockCount(0), m_isClosing(false), m_file(INVALID_HANDLE_VALUE), m_thread(NULL),
+	m_shardBytes(0), m_bytesInShard(0), m_shard(0), m_writtenSamples(0), m_writtenBytes(0)
+{
+	m_prefix[0] = 0;
+	InitializeCriticalSection(&m_lock);
+	InitializeConditionVariable(&m_blockQueued);
+	InitializeConditionVariable(&m_blockFreed);
+}
+
+SelfPlayWriter::~SelfPlayWriter()
+{
+	Close();
+	for (size_t i = 0; i < m_freeBlocks.size(); ++i)
+	{
+		delete m_freeBlocks[i];
+	}
+	DeleteCriticalSection(&m_lock);
+}
+
+bool SelfPlayWriter::Open(const TCHAR* prefixPtr, LONGLONG shardBytes)
+{
+	Close();
+	_tcscpy_s(m_prefix, MAX_PATH, prefixPtr);
+	m_shardBytes = shardBytes;
+	m_shard = 0;
+	m_writtenSamples = m_writtenBytes = 0;
+	if (!OpenShard()) return false;
+	m_thread = CreateThread(NULL, 0, ThreadProc, this, 0, NULL);
+	return true;
+}
+
+void SelfPlayWriter::Close()
+{
+	if (!IsOpen()) return;
+
+	EnterCriticalSection(&m_lock);
+	m_isClosing = true;
+	WakeAllConditionVariable(&m_blockQueued);
+	LeaveCriticalSection(&m_lock);
+	WaitForSingleObject(m_thread, INFINITE);
+	CloseHandle(m_thread);
+	m_thread = NULL;
+
+	EnterCriticalSection(&m_lock);
+	CloseHandle(m_file);
+	m_file = INVALID_HANDLE_VALUE;
+	m_isClosing = false;
+	LeaveCriticalSection(&m_lock);
+}
+
+void SelfPlayWriter::GetShardName(const TCHAR* prefixPtr, int shard, TCHAR* nameBufferPtr)
+{
+	_stprintf_s(nameBufferPtr, MAX_PATH, TEXT("%s%04d.bin"), prefixPtr, shard);
+}
+
+bool SelfPlayWriter::ReadShard(const TCHAR* filenamePtr, std::vector<PLAY_SAMPLE>& samplesRef)
+{
+	HANDLE file = CreateFile(filenamePtr, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE) return false;
+
+	unsigned char header[SHARD_HEADER_BYTES];
+	bool isValid = ReadBytes(file, header, SHARD_HEADER_BYTES) && memcmp(header, "AISP", 4) == 0
+		&& GetUint32(header + 4) == SHARD_VERSION && GetUint32(header + 8) == SAMPLE_BYTES;
+
+	std::vector<unsigned char> compressed, planes;
+	unsigned char blockHeader[BLOCK_HEADER_BYTES];
+	while (isValid && ReadBytes(file, blockHeader, BLOCK_HEADER_BYTES))
+	{
+		uint32_t sampleCount = GetUint32(blockHeader), compressedBytes = GetUint32(blockHeader + 4);
+		if (sampleCount == 0 || sampleCount > (uint32_t) SelfPlayRecorder::BLOCK_SAMPLES || compressedBytes == 0)
+		{
+			isValid = false;
+			break;
+		}
+		compressed.resize(compressedBytes);
+		planes.resize(sampleCount * SAMPLE_BYTES);
+		isValid = ReadBytes(file, &compressed[0], compressedBytes)
+			&& LzCompressor::Decompress(&compressed[0], compressedBytes, &planes[0], (int) planes.size()) == (int) planes.size();
+		if (!isValid) break;
+
+		// byte planes back into samples
+		size_t first = samplesRef.size();
+		samplesRef.resize(first + sampleCount);
+		unsigned char* samplesPtr = (unsigned char*) &samplesRef[first];
+		for (uint32_t byte = 0; byte < SAMPLE_BYTES; ++byte)
+		{
+			const unsigned char* planePtr = &planes[byte * sampleCount];
+			for (uint32_t i = 0; i < sampleCount; ++i) samplesPtr[i * SAMPLE_BYTES + byte] = planePtr[i];
+		}
+	}
+	CloseHandle(file);
+	return isValid;
+}
+
+SelfPlayWriter::Block* SelfPlayWriter::Exchange(Block* fullBlockPtr)
+{
+	EnterCriticalSection(&m_lock);
+	if (fullBlockPtr != NULL)
+	{
+		if (m_file == INVALID_HANDLE_VALUE)
+		{
+			// nobody is listening: the block is emptied and used again
+			LeaveCriticalSection(&m_lock);
+			fullBlockPtr->data.clear();
+			fullBlockPtr->sampleCount = 0;
+			return fullBlockPtr;
+		}
+		m_queue.push_back(fullBlockPtr);
+		WakeConditionVariable(&m_blockQueued);
+	}
+
+	// the queue is bounded by the number of blocks: when the disk falls behind, the recorders wait here
+	while (m_freeBlocks.empty() && m_blockCount >= MAX_BLOCKS)
+	{
+		SleepConditionVariableCS(&m_blockFreed, &m_lock, INFINITE);
+	}
+
+	Block* blockPtr;
+	if (!m_freeBlocks.empty())
+	{
+		blockPtr = m_freeBlocks.back();
+		m_freeBlocks.pop_back();
+	}
+	else
+	{
+		blockPtr = new Block;
+		blockPtr->sampleCount = 0;
+		++m_blockCount;
+	}
+	LeaveCriticalSection(&m_lock);
+	return blockPtr;
+}
+
+void SelfPlayWriter::Release(Block* blockPtr)
+{
+	EnterCriticalSection(&m_lock);
+	blockPtr->data.clear();
+	blockPtr->sampleCount = 0;
+	m_freeBlocks.push_back(blockPtr);
+	WakeAllConditionVariable(&m_blockFreed);
+	LeaveCriticalSection(&m_lock);
+}
+
+DWORD WINAPI SelfPlayWriter::ThreadProc(LPVOID parameter)
+{
+	((SelfPlayWriter*) parameter)->WriterLoop();
+	return 0;
+}
+
+void SelfPlayWriter::WriterLoop()
+{
+	std::vector<Block*> blocks;
+	for (;;)
+	{
+		EnterCriticalSection(&m_lock);
+		while (m_queue.empty() && !m_isClosing)
+		{
+			SleepConditionVariableCS(&m_blockQueued, &m_lock, INFINITE);
+		}
+		if (m_queue.empty())
+		{
+			// closing, and everything is written
+			LeaveCriticalSection(&m_lock);
+			return;
+		}
+		blocks.swap(m_queue);
+		LeaveCriticalSection(&m_lock);
+
+		// the blocks were compressed by the recorders, this thread only writes
+		for (size_t i = 0; i < blocks.size(); ++i)
+		{
+			WriteBlock(*blocks[i]);
+			blocks[i]->data.clear();
+			blocks[i]->sampleCount = 0;
+		}
+
+		EnterCriticalSection(&m_lock);
+		m_freeBlocks.insert(m_freeBlocks.end(), blocks.begin(), blocks.end());
+		WakeAllConditionVariable(&m_blockFreed);
+		LeaveCriticalSection(&m_lock);
+		blocks.clear();
+	}
+}
+
+void SelfPlayWriter::WriteBlock(const Block& blockRef)
+{
+	if (m_bytesInShard >= m_shardBytes)
+	{
+		CloseHandle(m_file);
+		++m_shard;
+		if (!OpenShard()) return;		// the samples are lost, but the recorders keep going
+	}
+	if (m_file == INVALID_HANDLE_VALUE) return;
+
+	DWORD bytesWritten = 0;
+	WriteFile(m_file, &blockRef.data[0], (DWORD) blockRef.data.size(), &bytesWritten, NULL);
+	m_bytesInShard += bytesWritten;
+	m_writtenBytes += bytesWritten;
+	m_writtenSamples += blockRef.sampleCount;
+}
+
+bool SelfPlayWriter::OpenShard()
+{
+	TCHAR name[MAX_PATH];
+	GetShardName(m_prefix, m_shard, name);
+	m_file = CreateFile(name, GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (m_file == INVALID_HANDLE_VALUE) return false;
+
+	unsigned char header[SHARD_HEADER_BYTES];
+	memcpy(header, "AISP", 4);
+	PutUint32(header + 4, SHARD_VERSION);
+	PutUint32(header + 8, SAMPLE_BYTES);
+	DWORD bytesWritten = 0;
+	WriteFile(m_file, header, SHARD_HEADER_BYTES, &bytesWritten, NULL);
+	m_bytesInShard = bytesWritten;
+	m_writtenBytes += bytesWritten;
+	return true;
+}
+
+//-----------------------------------------------------------------
+// SelfPlayRecorder methods
+//-----------------------------------------------------------------
+SelfPlayRecorder::SelfPlayRecorder(SelfPlayWriter* writerPtr) : m_writerPtr(writerPtr), m_blockPtr(NULL), m_recordedSamples(0)
+{
+	m_samples.reserve(BLOCK_SAMPLES);
+}
+
+SelfPlayRecorder::~SelfPlayRecorder()
+{
+	Flush();
+	if (m_blockPtr != NULL) m_writerPtr->Release(m_blockPtr);
+}
+
+void SelfPlayRecorder::MoveChosen(const Match& matchRef, int player, int direction)
+{
+	PLAY_SAMPLE sample;
+	EncodeState(matchRef.GetArena(), matchRef.GetPositions(), player, sample);
+	sample.move = (uint8_t) direction;
+	sample.player = (uint8_t) player;
+	sample.outcome = 0;
+	sample.reserved = 0;
+	int tick = matchRef.GetTickCount();
+	sample.tick = (uint16_t) (tick < 65535 ? tick : 65535);
+	m_matchSamples.push_back(sample);
+}
+
+void SelfPlayRecorder::MatchFinished(const Match& matchRef)
+{
+	int winner = matchRef.GetWinner();
+	for (size_t i = 0; i < m_matchSamples.size(); ++i)
+	{
+		PLAY_SAMPLE& sampleRef = m_matchSamples[i];
+		sampleRef.outcome = (int8_t) (winner == Match::NO_WINNER ? 0 : winner == sampleRef.player ? 1 : -1);
+		m_samples.push_back(sampleRef);
+		if ((int) m_samples.size() == BLOCK_SAMPLES) SubmitBlock();
+	}
+	m_recordedSamples += m_matchSamples.size();
+	m_matchSamples.clear();
+}
+
+void SelfPlayRecorder::Flush()
+{
+	if (!m_samples.empty()) SubmitBlock();
+}
+
+void SelfPlayRecorder::EncodeState(const ArenaGrid& arenaRef, const CELL* positionsPtr, int player, PLAY_SAMPLE& sampleRef)
+{
+	const int side = SelfPlayWriter::WINDOW_SIDE, radius = SelfPlayWriter::WINDOW_RADIUS;
+	const CELL& headRef = positionsPtr[player];
+	const CELL& opponentRef = positionsPtr[1 - player];
+	int width = arenaRef.GetWidth(), height = arenaRef.GetHeight();
+
+	sampleRef.window[0] = sampleRef.window[1] = sampleRef.window[2] = sampleRef.window[3] = 0;
+	for (int row = 0; row < side; ++row)
+	{
+		int y = headRef.y - radius + row;
+		for (int column = 0; column < side; ++column)
+		{
+			int x = headRef.x - radius + column;
+			bool isRigid = x < 0 || y < 0 || x >= width || y >= height || arenaRef.IsRigid(x, y);
+			int bit = row * side + column;
+			if (isRigid) sampleRef.window[bit >> 6] |= 1ULL << (bit & 63);
+		}
+	}
+
+	int dx = opponentRef.x - headRef.x, dy = opponentRef.y - headRef.y;
+	sampleRef.opponentDx = (int8_t) (dx < -127 ? -127 : dx > 127 ? 127 : dx);
+	sampleRef.opponentDy = (int8_t) (dy < -127 ? -127 : dy > 127 ? 127 : dy);
+}
+
+void SelfPlayRecorder::SubmitBlock()
+{
+	if (m_blockPtr == NULL) m_blockPtr = m_writerPtr->Exchange(NULL);
+
+	// byte planes: the same byte of neighbouring samples is often equal, which the compressor finds as long runs
+	int sampleCount = (int) m_samples.size();
+	m_planes.resize(sampleCount * SAMPLE_BYTES);
+	const unsigned char* samplesPtr = (const unsigned char*) &m_samples[0];
+	for (uint32_t byte = 0; byte < SAMPLE_BYTES; ++byte)
+	{
+		unsigned char* planePtr = &m_planes[byte * sampleCount];
+		for (int i = 0; i < sampleCount; ++i) planePtr[i] = samplesPtr[i * SAMPLE_BYTES + byte];
+	}
+
+	std::vector<unsigned char>& dataRef = m_blockPtr->data;
+	dataRef.resize(BLOCK_HEADER_BYTES);
+	m_compressor.Compress(&m_planes[0], (int) m_planes.size(), dataRef);
+	PutUint32(&dataRef[0], (uint32_t) sampleCount);
+	PutUint32(&dataRef[4], (uint32_t) (dataRef.size() - BLOCK_HEADER_BYTES));
+	m_blockPtr->sampleCount = sampleCount;
+
+	m_blockPtr = m_writerPtr->Exchange(m_blockPtr);
+	m_samples.clear();
+}
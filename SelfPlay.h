@@ -0,0 +1,192 @@
+//-----------------------------------------------------------------
+// SelfPlay Objects
+// C++ Header - SelfPlay.h - version 2010 v2_07
+//
+// The self-play pipeline turns headless matches into training samples:
+// for every move the arena around the player, where the opponent is, the
+// move, and how the match ended for that player. A SelfPlayRecorder
+// follows the matches of one thread as their MatchListener, and once it
+// has a block of samples it shuffles them into byte planes, compresses
+// them with LzCompressor and queues them. One SelfPlayWriter thread
+// writes the queued blocks into shard files of a fixed size; when the
+// queue is full the recorders wait, so memory stays bounded.
+//
+// Shard layout: "AISP", uint32 version 1, uint32 sample size 40, then blocks of
+//	uint32 sample count, uint32 compressed size, the LZ compressed samples,
+//	stored byte plane after byte plane (byte 0 of every sample, then byte 1...)
+//-----------------------------------------------------------------
+
+#pragma once
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <tchar.h>
+#include <vector>
+#include <stdint.h>
+#include "ArenaGrid.h"
+#include "MatchListener.h"
+#include "LzCompressor.h"
+
+//-----------------------------------------------------------------
+// Structs
+//-----------------------------------------------------------------
+struct PLAY_SAMPLE
+{
+	uint64_t window[4];				// the 15 x 15 cells around the player, bit y * 15 + x, 1 for rigid; outside the arena is rigid
+	int8_t opponentDx, opponentDy;	// clamped to -127 .. 127
+	uint8_t move;					// the DIRECTION chosen
+	uint8_t player;
+	int8_t outcome;					// for the player that moved: 1 won, 0 draw, -1 lost
+	uint8_t reserved;
+	uint16_t tick;					// clamped to 65535
+};
+
+class SelfPlayRecorder;
+
+//-----------------------------------------------------------------
+// SelfPlayWriter Class
+//-----------------------------------------------------------------
+class SelfPlayWriter
+{
+public:
+	static const int MAX_BLOCKS = 32;		// blocks in the queue and in the recorders together
+	static const int WINDOW_SIDE = 15;
+	static const int WINDOW_RADIUS = 7;
+
+	//---------------------------
+	// Constructor(s)
+	//---------------------------
+	SelfPlayWriter();
+
+	//---------------------------
+	// Destructor
+	//---------------------------
+	virtual ~SelfPlayWriter();				// every recorder must be gone by now
+
+	//---------------------------
+	// General Methods
+	//---------------------------
+	// the shards are named prefix0000.bin, prefix0001.bin...; a new one starts once a shard holds shardBytes
+	bool Open(const TCHAR* prefixPtr, LONGLONG shardBytes = 256 << 20);
+
+	// writes every queued block and stops the writer; the recorders must have been flushed
+	void Close();
+
+	bool IsOpen() const { return m_file != INVALID_HANDLE_VALUE; }
+
+	// what the writer has written since Open
+	LONGLONG GetWrittenSampleCount() const { return m_writtenSamples; }
+	LONGLONG GetWrittenBytes() const { return m_writtenBytes; }
+	int GetShardCount() const { return m_shard + 1; }
+
+	static void GetShardName(const TCHAR* prefixPtr, int shard, TCHAR* nameBufferPtr);		// nameBufferPtr holds MAX_PATH characters
+
+	// appends the samples of a shard, false when it can't be read or is damaged
+	static bool ReadShard(const TCHAR* filenamePtr, std::vector<PLAY_SAMPLE>& samplesRef);
+
+private:
+	friend class SelfPlayRecorder;
+
+	// -------------------------
+	// Internal structs
+	// -------------------------
+	struct Block
+	{
+		std::vector<unsigned char> data;		// block header and compressed samples, ready to write
+		int sampleCount;
+	};
+
+	// -------------------------
+	// Member functions
+	// -------------------------
+	Block* Exchange(Block* fullBlockPtr);		// queues a full block (NULL for none) and returns an empty one
+	void Release(Block* blockPtr);
+	static DWORD WINAPI ThreadProc(LPVOID parameter);
+	void WriterLoop();
+	void WriteBlock(const Block& blockRef);
+	bool OpenShard();
+
+	// -------------------------
+	// Datamembers
+	// -------------------------
+	CRITICAL_SECTION m_lock;
+	CONDITION_VARIABLE m_blockQueued, m_blockFreed;
+	std::vector<Block*> m_queue, m_freeBlocks;
+	int m_blockCount;
+	bool m_isClosing;
+
+	// owned by the writer thread while open
+	HANDLE m_file, m_thread;
+	TCHAR m_prefix[MAX_PATH];
+	LONGLONG m_shardBytes, m_bytesInShard;
+	int m_shard;
+	LONGLONG m_writtenSamples, m_writtenBytes;
+
+	// -------------------------
+	// Disabling default copy constructor and default assignment operator.
+	// If you get a linker error from one of these functions, your class is internally trying to use them. This is
+	// an error in your class, these declarations are deliberately made without implementation because they should never be used.
+	// -------------------------
+	SelfPlayWriter(const SelfPlayWriter& spwRef);
+	SelfPlayWriter& operator=(const SelfPlayWriter& spwRef);
+};
+
+//-----------------------------------------------------------------
+// SelfPlayRecorder Class
+//-----------------------------------------------------------------
+class SelfPlayRecorder : public MatchListener
+{
+public:
+	static const int BLOCK_SAMPLES = 8192;
+
+	//---------------------------
+	// Constructor(s)
+	//---------------------------
+	SelfPlayRecorder(SelfPlayWriter* writerPtr);	// one per thread, passed to Match::SetListener
+
+	//---------------------------
+	// Destructor
+	//---------------------------
+	virtual ~SelfPlayRecorder();
+
+	//---------------------------
+	// General Methods
+	//---------------------------
+	void MoveChosen(const Match& matchRef, int player, int direction);
+	void MatchFinished(const Match& matchRef);
+
+	// compresses and queues the samples of the finished matches, e.g. before SelfPlayWriter::Close
+	void Flush();
+
+	LONGLONG GetRecordedSampleCount() const { return m_recordedSamples; }
+
+	static void EncodeState(const ArenaGrid& arenaRef, const CELL* positionsPtr, int player, PLAY_SAMPLE& sampleRef);
+
+private:
+	// -------------------------
+	// Member functions
+	// -------------------------
+	void SubmitBlock();
+
+	// -------------------------
+	// Datamembers
+	// -------------------------
+	SelfPlayWriter* m_writerPtr;
+	SelfPlayWriter::Block* m_blockPtr;
+	std::vector<PLAY_SAMPLE> m_matchSamples;		// the match being played, the outcome isn't known yet
+	std::vector<PLAY_SAMPLE> m_samples;
+	std::vector<unsigned char> m_planes;
+	LzCompressor m_compressor;
+	LONGLONG m_recordedSamples;
+
+	// -------------------------
+	// Disabling default copy constructor and default assignment operator.
+	// If you get a linker error from one of these functions, your class is internally trying to use them. This is
+	// an error in your class, these declarations are deliberately made without implementation because they should never be used.
+	// -------------------------
+	SelfPlayRecorder(const SelfPlayRecorder& sprRef);
+	SelfPlayRecorder& operator=(const SelfPlayRecorder& sprRef);
+};
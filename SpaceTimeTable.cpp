@@ -0,0 +1,92 @@
+//-----------------------------------------------------------------
+// SpaceTimeTable Object
+// C++ Source - SpaceTimeTable.cpp - version 2010 v2_07
+//-----------------------------------------------------------------
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#include "SpaceTimeTable.h"
+
+//-----------------------------------------------------------------
+// Defines
+//-----------------------------------------------------------------
+#define EMPTY_KEY (~(uint64_t) 0)
+
+//-----------------------------------------------------------------
+// SpaceTimeTable methods
+//-----------------------------------------------------------------
+SpaceTimeTable::SpaceTimeTable() : m_mask(1023)
+{
+	m_keys.assign(m_mask + 1, EMPTY_KEY);
+	m_values.assign(m_mask + 1, (int) NOT_FOUND);
+}
+
+SpaceTimeTable::~SpaceTimeTable()
+{
+	// nothing to destroy
+}
+
+void SpaceTimeTable::Clear()
+{
+	for (size_t i = 0; i < m_usedSlots.size(); ++i)
+	{
+		m_keys[m_usedSlots[i]] = EMPTY_KEY;
+	}
+	m_usedSlots.clear();
+}
+
+void SpaceTimeTable::Set(int x, int y, int tick, int value)
+{
+	// keep the load factor under one half, so probe sequences stay short
+	if ((m_usedSlots.size() + 1) * 2 > m_keys.size()) Grow();
+
+	uint64_t key = MakeKey(x, y, tick);
+	size_t slot = FindSlot(key);
+	if (m_keys[slot] == EMPTY_KEY)
+	{
+		m_keys[slot] = key;
+		m_usedSlots.push_back(slot);
+	}
+	m_values[slot] = value;
+}
+
+int SpaceTimeTable::Get(int x, int y, int tick) const
+{
+	size_t slot = FindSlot(MakeKey(x, y, tick));
+	return m_keys[slot] == EMPTY_KEY ? NOT_FOUND : m_values[slot];
+}
+
+size_t SpaceTimeTable::FindSlot(uint64_t key) const
+{
+	// Fibonacci hashing spreads the packed coordinates, then linear probing
+	size_t slot = (size_t) ((key * 0x9E3779B97F4A7C15ULL) >> 32) & m_mask;
+	while (m_keys[slot] != EMPTY_KEY && m_keys[slot] != key)
+	{
+		slot = (slot + 1) & m_mask;
+	}
+	return slot;
+}
+
+void SpaceTimeTable::Grow()
+{
+	std::vector<uint64_t> oldKeys;
+	std::vector<int> oldValues;
+	std::vector<size_t> oldUsedSlots;
+	oldKeys.swap(m_keys);
+	oldValues.swap(m_values);
+	oldUsedSlots.swap(m_usedSlots);
+
+	m_mask = m_mask * 2 + 1;
+	m_keys.assign(m_mask + 1, EMPTY_KEY);
+	m_values.assign(m_mask + 1, (int) NOT_FOUND);
+	m_usedSlots.reserve(oldUsedSlots.size() * 2);
+	for (size_t i = 0; i < oldUsedSlots.size(); ++i)
+	{
+		size_t oldSlot = oldUsedSlots[i];
+		size_t slot = FindSlot(oldKeys[oldSlot]);
+		m_keys[slot] = oldKeys[oldSlot];
+		m_values[slot] = oldValues[oldSlot];
+		m_usedSlots.push_back(slot);
+	}
+}
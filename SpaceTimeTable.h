@@ -0,0 +1,76 @@
+//-----------------------------------------------------------------
+// SpaceTimeTable Object
+// C++ Header - SpaceTimeTable.h - version 2010 v2_07
+//
+// SpaceTimeTable maps (x, y, tick) to a value with an open addressing
+// hash table. Only the entries that are really used take memory, so it
+// can hold the reservations of hundreds of agents over a time window on
+// any arena size, and clearing it only touches the slots in use.
+//-----------------------------------------------------------------
+
+#pragma once
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+
+//-----------------------------------------------------------------
+// SpaceTimeTable Class
+//-----------------------------------------------------------------
+class SpaceTimeTable
+{
+public:
+	static const int NOT_FOUND = -1;
+
+	//---------------------------
+	// Constructor(s)
+	//---------------------------
+	SpaceTimeTable();
+
+	//---------------------------
+	// Destructor
+	//---------------------------
+	virtual ~SpaceTimeTable();
+
+	//---------------------------
+	// General Methods
+	//---------------------------
+	void Clear();
+
+	// x and y from -1 up to 2^21 - 2, tick from 0 up to 2^22 - 2
+	void Set(int x, int y, int tick, int value);
+	int Get(int x, int y, int tick) const;		// NOT_FOUND when the entry was never set
+	bool Contains(int x, int y, int tick) const { return Get(x, y, tick) != NOT_FOUND; }
+
+	int GetCount() const { return (int) m_usedSlots.size(); }
+
+private:
+	// -------------------------
+	// Member functions
+	// -------------------------
+	static uint64_t MakeKey(int x, int y, int tick)
+	{
+		return ((uint64_t) tick << 42) | ((uint64_t) (y + 1) << 21) | (uint64_t) (x + 1);
+	}
+	size_t FindSlot(uint64_t key) const;
+	void Grow();
+
+	// -------------------------
+	// Datamembers
+	// -------------------------
+	std::vector<uint64_t> m_keys;
+	std::vector<int> m_values;
+	std::vector<size_t> m_usedSlots;		// so Clear doesn't have to walk the whole table
+	size_t m_mask;
+
+	// -------------------------
+	// Disabling default copy constructor and default assignment operator.
+	// If you get a linker error from one of these functions, your class is internally trying to use them. This is
+	// an error in your class, these declarations are deliberately made without implementation because they should never be used.
+	// -------------------------
+	SpaceTimeTable(const SpaceTimeTable& sttRef);
+	SpaceTimeTable& operator=(const SpaceTimeTable& sttRef);
+};
@@ -0,0 +1,62 @@
+//-----------------------------------------------------------------
+// Stopwatch Object
+// C++ Header - Stopwatch.h - version 2010 v2_07
+//
+// Stopwatch measures elapsed time with the high resolution performance counter.
+//-----------------------------------------------------------------
+
+#pragma once
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+
+//-----------------------------------------------------------------
+// Stopwatch Class
+//-----------------------------------------------------------------
+class Stopwatch
+{
+public:
+	//---------------------------
+	// Constructor(s)
+	//---------------------------
+	Stopwatch()
+	{
+		Restart();
+	}
+
+	//---------------------------
+	// General Methods
+	//---------------------------
+	void Restart()
+	{
+		QueryPerformanceCounter(&m_start);
+	}
+
+	LONGLONG GetElapsedTicks() const
+	{
+		LARGE_INTEGER now;
+		QueryPerformanceCounter(&now);
+		return now.QuadPart - m_start.QuadPart;
+	}
+
+	double GetElapsedMilliseconds() const
+	{
+		return GetElapsedTicks() * 1000.0 / GetFrequency();
+	}
+
+	static LONGLONG GetFrequency()
+	{
+		LARGE_INTEGER frequency;
+		QueryPerformanceFrequency(&frequency);
+		return frequency.QuadPart;
+	}
+
+private:
+	// -------------------------
+	// Datamembers
+	// -------------------------
+	LARGE_INTEGER m_start;
+};
@@ -0,0 +1,178 @@
+//-----------------------------------------------------------------
+// SymmetryBoard Object
+// C++ Source - SymmetryBoard.cpp - version 2010 v2_07
+//-----------------------------------------------------------------
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#include "SymmetryBoard.h"
+
+//-----------------------------------------------------------------
+// SymmetryBoard methods
+//-----------------------------------------------------------------
+SymmetryBoard::SymmetryBoard() : m_width(0), m_height(0)
+{
+	for (int y = 0; y < MAX_SIZE; ++y) m_rows[y] = 0;
+	for (int player = 0; player < PLAYER_COUNT; ++player) m_players[player].x = m_players[player].y = 0;
+}
+
+SymmetryBoard::~SymmetryBoard()
+{
+	// nothing to destroy
+}
+
+void SymmetryBoard::Transform(int symmetry)
+{
+	for (int player = 0; player < PLAYER_COUNT; ++player) m_players[player] = TransformCell(m_players[player], m_width, m_height, symmetry);
+	if (symmetry & TRANSPOSE)
+	{
+		Transpose(m_rows);
+		int width = m_width;
+		m_width = m_height;
+		m_height = width;
+	}
+	if (symmetry & MIRROR) Mirror(m_rows, m_width, m_height);
+	if (symmetry & FLIP) Flip(m_rows, m_height);
+}
+
+int SymmetryBoard::Canonicalise()
+{
+	// the mirror and flip of the board, then the same of its transpose; every candidate is one kernel away from the one before
+	static const int steps[SYMMETRY_COUNT] = { 0, MIRROR, FLIP, MIRROR, TRANSPOSE, MIRROR, FLIP, MIRROR };
+	int count = m_width == m_height ? SYMMETRY_COUNT : SYMMETRY_COUNT / 2;
+	SymmetryBoard best(*this), candidate(*this);
+	int bestSymmetry = 0, symmetry = 0;
+	for (int i = 1; i < count; ++i)
+	{
+		if (steps[i] == TRANSPOSE)
+		{
+			// back to the board itself (undoing the mirror and flip) before the transpose
+			candidate = *this;
+			symmetry = 0;
+		}
+		candidate.Transform(steps[i]);
+		symmetry ^= steps[i];
+		if (candidate.Compare(best) < 0)
+		{
+			best = candidate;
+			bestSymmetry = symmetry;
+		}
+	}
+	*this = best;
+	return bestSymmetry;
+}
+
+uint64_t SymmetryBoard::GetHash() const
+{
+	uint64_t hash = (uint64_t) m_width << 32 | (uint64_t) m_height;
+	for (int y = 0; y < m_height; ++y)
+	{
+		hash = (hash ^ m_rows[y]) * 0x9e3779b97f4a7c15ULL;
+		hash ^= hash >> 29;
+	}
+	for (int player = 0; player < PLAYER_COUNT; ++player)
+	{
+		hash = (hash ^ ((uint64_t) m_players[player].x << 16 | (uint64_t) m_players[player].y)) * 0xbf58476d1ce4e5b9ULL;
+		hash ^= hash >> 31;
+	}
+	return hash;
+}
+
+CELL SymmetryBoard::TransformCell(CELL cell, int width, int height, int symmetry)
+{
+	if (symmetry & TRANSPOSE)
+	{
+		int x = cell.x;
+		cell.x = cell.y;
+		cell.y = x;
+		int oldWidth = width;
+		width = height;
+		height = oldWidth;
+	}
+	if (symmetry & MIRROR) cell.x = width - 1 - cell.x;
+	if (symmetry & FLIP) cell.y = height - 1 - cell.y;
+	return cell;
+}
+
+int SymmetryBoard::TransformDirection(int direction, int symmetry)
+{
+	int dx = DIRECTION_DX[direction], dy = DIRECTION_DY[direction];
+	if (symmetry & TRANSPOSE)
+	{
+		int oldDx = dx;
+		dx = dy;
+		dy = oldDx;
+	}
+	if (symmetry & MIRROR) dx = -dx;
+	if (symmetry & FLIP) dy = -dy;
+	for (int result = 0; result < 4; ++result)
+	{
+		if (DIRECTION_DX[result] == dx && DIRECTION_DY[result] == dy) return result;
+	}
+	return direction;
+}
+
+int SymmetryBoard::InvertSymmetry(int symmetry)
+{
+	// without a transpose every symmetry undoes itself; with one, mirroring before the transpose is flipping after it
+	if (!(symmetry & TRANSPOSE)) return symmetry;
+	return TRANSPOSE | ((symmetry & MIRROR) ? FLIP : 0) | ((symmetry & FLIP) ? MIRROR : 0);
+}
+
+// bit x of row y trades places with bit y of row x: the 32 x 32 blocks off the diagonal swap, then the 16 x 16 blocks within them...
+void SymmetryBoard::Transpose(uint64_t* rowsPtr)
+{
+	uint64_t mask = 0x00000000ffffffffULL;
+	for (int step = 32; step != 0; step >>= 1, mask ^= mask << step)
+	{
+		for (int row = 0; row < MAX_SIZE; row = ((row | step) + 1) & ~step)
+		{
+			uint64_t swap = ((rowsPtr[row] >> step) ^ rowsPtr[row | step]) & mask;
+			rowsPtr[row] ^= swap << step;
+			rowsPtr[row | step] ^= swap;
+		}
+	}
+}
+
+void SymmetryBoard::Mirror(uint64_t* rowsPtr, int width, int height)
+{
+	for (int y = 0; y < height; ++y) rowsPtr[y] = ReverseBits(rowsPtr[y]) >> (MAX_SIZE - width);
+}
+
+void SymmetryBoard::Flip(uint64_t* rowsPtr, int height)
+{
+	for (int top = 0, bottom = height - 1; top < bottom; ++top, --bottom)
+	{
+		uint64_t row = rowsPtr[top];
+		rowsPtr[top] = rowsPtr[bottom];
+		rowsPtr[bottom] = row;
+	}
+}
+
+uint64_t SymmetryBoard::ReverseBits(uint64_t bits)
+{
+	bits = ((bits >> 1) & 0x5555555555555555ULL) | ((bits & 0x5555555555555555ULL) << 1);
+	bits = ((bits >> 2) & 0x3333333333333333ULL) | ((bits & 0x3333333333333333ULL) << 2);
+	bits = ((bits >> 4) & 0x0f0f0f0f0f0f0f0fULL) | ((bits & 0x0f0f0f0f0f0f0f0fULL) << 4);
+	bits = ((bits >> 8) & 0x00ff00ff00ff00ffULL) | ((bits & 0x00ff00ff00ff00ffULL) << 8);
+	bits = ((bits >> 16) & 0x0000ffff0000ffffULL) | ((bits & 0x0000ffff0000ffffULL) << 16);
+	return (bits >> 32) | (bits << 32);
+}
+
+int SymmetryBoard::Compare(const SymmetryBoard& otherRef) const
+{
+	if (m_width != otherRef.m_width) return m_width < otherRef.m_width ? -1 : 1;
+	for (int y = 0; y < m_height; ++y)
+	{
+		if (m_rows[y] != otherRef.m_rows[y]) return m_rows[y] < otherRef.m_rows[y] ? -1 : 1;
+	}
+	for (int player = 0; player < PLAYER_COUNT; ++player)
+	{
+		const CELL& cellRef = m_players[player];
+		const CELL& otherCellRef = otherRef.m_players[player];
+		if (cellRef.y != otherCellRef.y) return cellRef.y < otherCellRef.y ? -1 : 1;
+		if (cellRef.x != otherCellRef.x) return cellRef.x < otherCellRef.x ? -1 : 1;
+	}
+	return 0;
+}
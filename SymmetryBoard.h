@@ -0,0 +1,114 @@
+//-----------------------------------------------------------------
+// SymmetryBoard Object
+// C++ Header - SymmetryBoard.h - version 2010 v2_07
+//
+// SymmetryBoard holds an arena of up to 64 x 64 cells as one 64 bit word
+// per row, plus the players, and can turn it into any of its 8
+// symmetries (rotations and reflections) with whole-word kernels: a
+// mirror reverses the bits of every row, a flip reverses the rows, and
+// a transpose swaps ever smaller blocks of the 64 x 64 bit matrix in 6
+// steps. Canonicalise picks the smallest of the 8, so states that are
+// rotations or reflections of each other get the same hash, and
+// transposition tables, caches and training data share their entries.
+// A non square arena only has the 4 symmetries without the transpose.
+//
+// A symmetry is 3 bits, applied in this order: 4 transposes (x and y
+// swap), 1 mirrors (x becomes width - 1 - x), 2 flips (y becomes
+// height - 1 - y). The players keep their order: whose turn it is matters.
+//-----------------------------------------------------------------
+
+#pragma once
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#include "ArenaGrid.h"
+#include <stdint.h>
+
+//-----------------------------------------------------------------
+// SymmetryBoard Class
+//-----------------------------------------------------------------
+class SymmetryBoard
+{
+public:
+	static const int MAX_SIZE = 64;
+	static const int PLAYER_COUNT = 2;
+	static const int SYMMETRY_COUNT = 8;
+	static const int TRANSPOSE = 4;
+	static const int MIRROR = 1;
+	static const int FLIP = 2;
+
+	//---------------------------
+	// Constructor(s)
+	//---------------------------
+	SymmetryBoard();
+
+	//---------------------------
+	// Destructor
+	//---------------------------
+	virtual ~SymmetryBoard();
+
+	//---------------------------
+	// General Methods
+	//---------------------------
+	// false when the arena is bigger than MAX_SIZE
+	template<class Grid>
+	bool Load(const Grid& gridRef, const CELL* positionsPtr)
+	{
+		if (gridRef.GetWidth() > MAX_SIZE || gridRef.GetHeight() > MAX_SIZE) return false;
+		m_width = gridRef.GetWidth();
+		m_height = gridRef.GetHeight();
+		for (int y = 0; y < MAX_SIZE; ++y) m_rows[y] = 0;
+		for (int y = 0; y < m_height; ++y)
+		{
+			for (int x = 0; x < m_width; ++x)
+			{
+				if (gridRef.IsRigid(x, y)) m_rows[y] |= (uint64_t) 1 << x;
+			}
+		}
+		for (int player = 0; player < PLAYER_COUNT; ++player) m_players[player] = positionsPtr[player];
+		return true;
+	}
+
+	void Transform(int symmetry);
+
+	// turns the board into its smallest symmetry and returns the symmetry applied;
+	// InvertSymmetry of it maps a cell or move of the canonical board back
+	int Canonicalise();
+
+	uint64_t GetHash() const;
+
+	bool IsRigid(int x, int y) const { return ((m_rows[y] >> x) & 1) != 0; }
+	const uint64_t* GetRows() const { return m_rows; }
+	CELL GetPlayer(int player) const { return m_players[player]; }
+	int GetWidth() const { return m_width; }
+	int GetHeight() const { return m_height; }
+
+	bool operator==(const SymmetryBoard& otherRef) const { return Compare(otherRef) == 0; }
+
+	// the same symmetry for a single cell of an arena of the given size (before the transform), or for a DIRECTION
+	static CELL TransformCell(CELL cell, int width, int height, int symmetry);
+	static int TransformDirection(int direction, int symmetry);
+	static int InvertSymmetry(int symmetry);
+
+	// the kernels, on 64 rows
+	static void Transpose(uint64_t* rowsPtr);
+	static void Mirror(uint64_t* rowsPtr, int width, int height);
+	static void Flip(uint64_t* rowsPtr, int height);
+	static uint64_t ReverseBits(uint64_t bits);
+
+private:
+	// -------------------------
+	// Member functions
+	// -------------------------
+	int Compare(const SymmetryBoard& otherRef) const;		// rows first, then the players
+
+	// -------------------------
+	// Datamembers
+	// -------------------------
+	uint64_t m_rows[MAX_SIZE];		// bit x of row y is 1 for rigid; rows and bits outside the arena are 0
+	CELL m_players[PLAYER_COUNT];
+	int m_width, m_height;
+
+	// SymmetryBoard is a value type on purpose: the canonical search compares copies
+};
@@ -0,0 +1,106 @@
+//-----------------------------------------------------------------
+// TickResolver Object
+// C++ Source - TickResolver.cpp - version 2010 v2_07
+//-----------------------------------------------------------------
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#include "TickResolver.h"
+
+// SSE2 is always there on x64, and on x86 with /arch:SSE2
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TICK_RESOLVER_SSE2
+#include <emmintrin.h>
+#endif
+
+//-----------------------------------------------------------------
+// TickResolver methods
+//-----------------------------------------------------------------
+TickResolver::TickResolver() : m_playerCount(0), m_collisionCount(0)
+{
+}
+
+TickResolver::~TickResolver()
+{
+	// nothing to destroy
+}
+
+void TickResolver::Gather(const ArenaGrid& arenaRef, const CELL* positionsPtr, const int* directionsPtr, int playerCount)
+{
+	m_playerCount = playerCount;
+	int paddedCount = (playerCount + LANES - 1) / LANES * LANES;
+	m_targets.resize(playerCount);
+	m_outcomes.assign(playerCount, MOVE_NONE);
+	m_keys.resize(paddedCount);
+	m_collisionCount = 0;
+
+	// a player that doesn't move gets -1 - player as its key, which nothing else matches
+	for (int player = 0; player < playerCount; ++player)
+	{
+		CELL& targetRef = m_targets[player];
+		targetRef = positionsPtr[player];
+		m_keys[player] = -1 - player;
+		int direction = directionsPtr[player];
+		if (direction < 0) continue;
+
+		targetRef.x += DIRECTION_DX[direction & 3];
+		targetRef.y += DIRECTION_DY[direction & 3];
+		// the sentinel ring keeps every neighbour readable
+		if (arenaRef.IsRigid(targetRef.x, targetRef.y))
+		{
+			m_outcomes[player] = MOVE_BLOCKED;
+			targetRef = positionsPtr[player];
+		}
+		else m_keys[player] = arenaRef.Index(targetRef.x, targetRef.y);
+	}
+	for (int i = playerCount; i < paddedCount; ++i) m_keys[i] = -1 - i;
+}
+
+void TickResolver::Resolve()
+{
+	for (int player = 0; player < m_playerCount; ++player)
+	{
+		int key = m_keys[player];
+		if (key < 0) continue;
+		if (CountClaims(key) > 1)
+		{
+			m_outcomes[player] = MOVE_COLLIDED;
+			++m_collisionCount;
+		}
+		else m_outcomes[player] = MOVE_DONE;
+	}
+}
+
+void TickResolver::Commit(ArenaGrid& arenaRef, CELL* positionsPtr) const
+{
+	for (int player = 0; player < m_playerCount; ++player)
+	{
+		if (m_outcomes[player] != MOVE_DONE) continue;
+		const CELL& targetRef = m_targets[player];
+		arenaRef.SetRigid(targetRef.x, targetRef.y);
+		positionsPtr[player] = targetRef;
+	}
+}
+
+int TickResolver::CountClaims(int key) const
+{
+	int count = 0;
+	int paddedCount = (int) m_keys.size();
+#if defined(TICK_RESOLVER_SSE2)
+	// an equal lane is -1, so subtracting the comparisons counts up
+	const __m128i keys = _mm_set1_epi32(key);
+	__m128i counts = _mm_setzero_si128();
+	for (int i = 0; i < paddedCount; i += LANES)
+	{
+		__m128i others = _mm_loadu_si128((const __m128i*) &m_keys[i]);
+		counts = _mm_sub_epi32(counts, _mm_cmpeq_epi32(others, keys));
+	}
+	counts = _mm_add_epi32(counts, _mm_shuffle_epi32(counts, _MM_SHUFFLE(1, 0, 3, 2)));
+	counts = _mm_add_epi32(counts, _mm_shuffle_epi32(counts, _MM_SHUFFLE(2, 3, 0, 1)));
+	count = _mm_cvtsi128_si32(counts);
+#else
+	for (int i = 0; i < paddedCount; ++i) count += m_keys[i] == key ? 1 : 0;
+#endif
+	return count;
+}
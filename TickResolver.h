@@ -0,0 +1,93 @@
+//-----------------------------------------------------------------
+// TickResolver Object
+// C++ Header - TickResolver.h - version 2010 v2_07
+//
+// TickResolver moves any number of players at once, so that no player
+// sees where another moved in the same tick. A tick has three phases:
+//	Gather		every player's intent, all read from the same arena
+//	Resolve		a move into a rigid cell is blocked and the player stays where
+//				it is. A free cell that more than one player moves into goes
+//				to none of them: every one of its claimants collides, two or
+//				ten alike, and the cell stays free. Each intent is compared
+//				with four others per SSE2 instruction.
+//	Commit		one pass over the players writes the cells moved into
+// The players are kept as arrays (targets, keys, outcomes), so every
+// phase is a tight loop over all of them instead of a round per player.
+//-----------------------------------------------------------------
+
+#pragma once
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#include "ArenaGrid.h"
+#include <vector>
+#include <stdint.h>
+
+//-----------------------------------------------------------------
+// Enums
+//-----------------------------------------------------------------
+enum MOVE_OUTCOME
+{
+	MOVE_NONE,			// the player is out of the match, or the tick isn't resolved yet
+	MOVE_DONE,
+	MOVE_BLOCKED,		// into a rigid cell, the player stays where it is
+	MOVE_COLLIDED		// into a cell that another player moved into as well; all of them collide and the cell stays free
+};
+
+//-----------------------------------------------------------------
+// TickResolver Class
+//-----------------------------------------------------------------
+class TickResolver
+{
+public:
+	static const int LANES = 4;		// intents per comparison
+
+	//---------------------------
+	// Constructor(s)
+	//---------------------------
+	TickResolver();
+
+	//---------------------------
+	// Destructor
+	//---------------------------
+	virtual ~TickResolver();
+
+	//---------------------------
+	// General Methods
+	//---------------------------
+	// directionsPtr holds a DIRECTION per player, -1 for a player that is out of the match
+	void Gather(const ArenaGrid& arenaRef, const CELL* positionsPtr, const int* directionsPtr, int playerCount);
+	void Resolve();
+
+	// makes every cell moved into rigid and moves the players there; blocked and collided players stay
+	void Commit(ArenaGrid& arenaRef, CELL* positionsPtr) const;
+
+	int GetPlayerCount() const { return m_playerCount; }
+	MOVE_OUTCOME GetOutcome(int player) const { return (MOVE_OUTCOME) m_outcomes[player]; }
+	CELL GetTarget(int player) const { return m_targets[player]; }
+	int GetCollisionCount() const { return m_collisionCount; }		// players that collided in the last tick
+
+private:
+	// -------------------------
+	// Member functions
+	// -------------------------
+	int CountClaims(int key) const;		// the intents with this key, the player itself included
+
+	// -------------------------
+	// Datamembers
+	// -------------------------
+	int m_playerCount;
+	std::vector<CELL> m_targets;
+	std::vector<int32_t> m_keys;		// the arena index moved into, or a negative key no other intent has; padded to whole LANES
+	std::vector<int> m_outcomes;
+	int m_collisionCount;
+
+	// -------------------------
+	// Disabling default copy constructor and default assignment operator.
+	// If you get a linker error from one of these functions, your class is internally trying to use them. This is
+	// an error in your class, these declarations are deliberately made without implementation because they should never be used.
+	// -------------------------
+	TickResolver(const TickResolver& trRef);
+	TickResolver& operator=(const TickResolver& trRef);
+};
@@ -0,0 +1,60 @@
+//-----------------------------------------------------------------
+// TranspositionTable Object
+// C++ Source - TranspositionTable.cpp - version 2010 v2_07
+//-----------------------------------------------------------------
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#include "TranspositionTable.h"
+
+//-----------------------------------------------------------------
+// TranspositionTable methods
+//-----------------------------------------------------------------
+// data layout: score bits 0-15 (signed), depth 16-23, bound 24-25, move 26-27, generation 32-39
+TranspositionTable::TranspositionTable(int sizeLog2) : m_slots((size_t) 1 << sizeLog2), m_mask(((uint64_t) 1 << sizeLog2) - 1), m_generation(0)
+{
+	Clear();
+}
+
+TranspositionTable::~TranspositionTable()
+{
+	// nothing to destroy
+}
+
+void TranspositionTable::Clear()
+{
+	for (size_t i = 0; i < m_slots.size(); ++i)
+	{
+		// data 0 has bound 0, which no stored entry has
+		m_slots[i].check = 0;
+		m_slots[i].data = 0;
+	}
+}
+
+bool TranspositionTable::Probe(uint64_t key, TABLE_ENTRY& entryRef) const
+{
+	const Slot& slotRef = m_slots[(size_t) (key & m_mask)];
+	uint64_t data = slotRef.data;
+	uint64_t check = slotRef.check;
+	if ((check ^ data) != key || ((data >> 24) & 3) == 0) return false;
+	entryRef.score = (int16_t) (data & 0xffff);
+	entryRef.depth = (int) ((data >> 16) & 0xff);
+	entryRef.bound = (int) ((data >> 24) & 3);
+	entryRef.move = (int) ((data >> 26) & 3);
+	return true;
+}
+
+void TranspositionTable::Store(uint64_t key, int score, int depth, Bound bound, int move)
+{
+	Slot& slotRef = m_slots[(size_t) (key & m_mask)];
+
+	// keep a deeper entry of this search, unless it is the same position; a torn read here only costs a replacement
+	uint64_t oldData = slotRef.data;
+	bool isSamePosition = (slotRef.check ^ oldData) == key;
+	if (!isSamePosition && (int) ((oldData >> 32) & 0xff) == m_generation && (int) ((oldData >> 16) & 0xff) > depth) return;
+
+	uint64_t data = (uint64_t) (uint16_t) score | (uint64_t) (depth & 0xff) << 16 | (uint64_t) bound << 24 | (uint64_t) (move & 3) << 26 | (uint64_t) m_generation << 32;
+	slotRef.data = data;
+	slotRef.check = key ^ data;
+}
@@ -0,0 +1,92 @@
+//-----------------------------------------------------------------
+// TranspositionTable Object
+// C++ Header - TranspositionTable.h - version 2010 v2_07
+//
+// TranspositionTable remembers searched positions for every thread of a
+// search at once, without locks. An entry is two 64 bit words: the data
+// (score, depth, bound, best move, search generation) and the key XORed
+// with the data. A probe only trusts an entry when XORing the two words
+// gives its key back, so an entry two threads write at the same time
+// (or half written, a 64 bit store is two stores on a 32 bit build) is
+// simply a miss instead of a wrong answer.
+//-----------------------------------------------------------------
+
+#pragma once
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+
+//-----------------------------------------------------------------
+// Structs
+//-----------------------------------------------------------------
+struct TABLE_ENTRY
+{
+	int score;
+	int depth;
+	int bound;		// TranspositionTable::Bound
+	int move;
+};
+
+//-----------------------------------------------------------------
+// TranspositionTable Class
+//-----------------------------------------------------------------
+class TranspositionTable
+{
+public:
+	enum Bound
+	{
+		UPPER = 1,		// the score is at most this, every move failed low
+		LOWER = 2,		// the score is at least this, a move failed high
+		EXACT = 3
+	};
+
+	//---------------------------
+	// Constructor(s)
+	//---------------------------
+	TranspositionTable(int sizeLog2 = 20);		// 2^sizeLog2 entries of 16 bytes
+
+	//---------------------------
+	// Destructor
+	//---------------------------
+	virtual ~TranspositionTable();
+
+	//---------------------------
+	// General Methods
+	//---------------------------
+	// entries of older searches are replaced first; only while no thread is searching
+	void NewSearch() { m_generation = (m_generation + 1) & 0xff; }
+	void Clear();
+
+	// any thread, any time
+	bool Probe(uint64_t key, TABLE_ENTRY& entryRef) const;
+	void Store(uint64_t key, int score, int depth, Bound bound, int move);
+
+private:
+	// -------------------------
+	// Internal structs
+	// -------------------------
+	struct Slot
+	{
+		volatile uint64_t check;		// key ^ data
+		volatile uint64_t data;
+	};
+
+	// -------------------------
+	// Datamembers
+	// -------------------------
+	std::vector<Slot> m_slots;
+	uint64_t m_mask;
+	int m_generation;
+
+	// -------------------------
+	// Disabling default copy constructor and default assignment operator.
+	// If you get a linker error from one of these functions, your class is internally trying to use them. This is
+	// an error in your class, these declarations are deliberately made without implementation because they should never be used.
+	// -------------------------
+	TranspositionTable(const TranspositionTable& ttRef);
+	TranspositionTable& operator=(const TranspositionTable& ttRef);
+};
@@ -0,0 +1,214 @@
+//-----------------------------------------------------------------
+// ValueNetwork Object
+// C++ Source - ValueNetwork.cpp - version 2010 v2_07
+//-----------------------------------------------------------------
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#include "ValueNetwork.h"
+#include "Random.h"
+#include <string.h>
+
+// AVX2 needs /arch:AVX2 (or -mavx2); SSSE3 is assumed where the compiler says so, or when VALUE_NETWORK_SSSE3 is defined
+#if defined(__AVX2__)
+#define VALUE_NETWORK_AVX2
+#include <immintrin.h>
+#elif defined(__SSSE3__) || defined(VALUE_NETWORK_SSSE3)
+#define VALUE_NETWORK_SSSE3
+#include <tmmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM)
+#define VALUE_NETWORK_NEON
+#include <arm_neon.h>
+#endif
+
+//-----------------------------------------------------------------
+// Dot product kernels
+//-----------------------------------------------------------------
+// activations are at most 127 and weights at least -127, so a pair of products always fits 16 bits
+static inline int32_t Dot(const unsigned char* activationsPtr, const int8_t* weightsPtr, int count)
+{
+#if defined(VALUE_NETWORK_AVX2)
+	const __m256i ones = _mm256_set1_epi16(1);
+	__m256i sum = _mm256_setzero_si256();
+	for (int i = 0; i < count; i += 32)
+	{
+		__m256i activations = _mm256_loadu_si256((const __m256i*) (activationsPtr + i));
+		__m256i weights = _mm256_loadu_si256((const __m256i*) (weightsPtr + i));
+		sum = _mm256_add_epi32(sum, _mm256_madd_epi16(_mm256_maddubs_epi16(activations, weights), ones));
+	}
+	__m128i half = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+	half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+	half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+	return _mm_cvtsi128_si32(half);
+#elif defined(VALUE_NETWORK_SSSE3)
+	const __m128i ones = _mm_set1_epi16(1);
+	__m128i sum = _mm_setzero_si128();
+	for (int i = 0; i < count; i += 16)
+	{
+		__m128i activations = _mm_loadu_si128((const __m128i*) (activationsPtr + i));
+		__m128i weights = _mm_loadu_si128((const __m128i*) (weightsPtr + i));
+		sum = _mm_add_epi32(sum, _mm_madd_epi16(_mm_maddubs_epi16(activations, weights), ones));
+	}
+	sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+	sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+	return _mm_cvtsi128_si32(sum);
+#elif defined(VALUE_NETWORK_NEON)
+	int32x4_t sum = vdupq_n_s32(0);
+	for (int i = 0; i < count; i += 16)
+	{
+		// activations fit a signed byte, so both sides can be multiplied as signed
+		int8x16_t activations = vreinterpretq_s8_u8(vld1q_u8(activationsPtr + i));
+		int8x16_t weights = vld1q_s8(weightsPtr + i);
+		int16x8_t products = vmull_s8(vget_low_s8(activations), vget_low_s8(weights));
+		products = vmlal_s8(products, vget_high_s8(activations), vget_high_s8(weights));
+		sum = vpadalq_s16(sum, products);
+	}
+	int32x2_t pair = vadd_s32(vget_low_s32(sum), vget_high_s32(sum));
+	return vget_lane_s32(vpadd_s32(pair, pair), 0);
+#else
+	int32_t sum = 0;
+	for (int i = 0; i < count; ++i) sum += activationsPtr[i] * weightsPtr[i];
+	return sum;
+#endif
+}
+
+static inline unsigned char ClippedRelu(int32_t sum)
+{
+	sum >>= ValueNetwork::ACTIVATION_SHIFT;
+	return (unsigned char) (sum < 0 ? 0 : sum > 127 ? 127 : sum);
+}
+
+static bool ReadBytes(HANDLE file, void* bufferPtr, DWORD size)
+{
+	DWORD bytesRead = 0;
+	return ReadFile(file, bufferPtr, size, &bytesRead, NULL) && bytesRead == size;
+}
+
+//-----------------------------------------------------------------
+// ValueNetwork methods
+//-----------------------------------------------------------------
+ValueNetwork::ValueNetwork() : m_hiddenWeights1(HIDDEN * INPUTS, 0), m_hiddenWeights2(HIDDEN * HIDDEN, 0), m_outputWeights(HIDDEN, 0),
+	m_hiddenBiases1(HIDDEN, 0), m_hiddenBiases2(HIDDEN, 0), m_outputBias(0)
+{
+}
+
+ValueNetwork::~ValueNetwork()
+{
+	// nothing to destroy
+}
+
+bool ValueNetwork::Load(const TCHAR* filenamePtr)
+{
+	HANDLE file = CreateFile(filenamePtr, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE) return false;
+
+	char magic[4];
+	uint32_t version = 0;
+	bool isValid = ReadBytes(file, magic, 4) && memcmp(magic, "AIVN", 4) == 0 && ReadBytes(file, &version, 4) && version == 1;
+
+	// read into copies, a damaged file leaves the network as it was
+	std::vector<int8_t> hiddenWeights1(m_hiddenWeights1.size()), hiddenWeights2(m_hiddenWeights2.size()), outputWeights(m_outputWeights.size());
+	std::vector<int32_t> hiddenBiases1(HIDDEN), hiddenBiases2(HIDDEN);
+	int32_t outputBias = 0;
+	isValid = isValid
+		&& ReadBytes(file, &hiddenWeights1[0], (DWORD) hiddenWeights1.size()) && ReadBytes(file, &hiddenBiases1[0], HIDDEN * sizeof(int32_t))
+		&& ReadBytes(file, &hiddenWeights2[0], (DWORD) hiddenWeights2.size()) && ReadBytes(file, &hiddenBiases2[0], HIDDEN * sizeof(int32_t))
+		&& ReadBytes(file, &outputWeights[0], (DWORD) outputWeights.size()) && ReadBytes(file, &outputBias, sizeof(int32_t));
+	CloseHandle(file);
+	if (!isValid) return false;
+
+	// -128 would overflow the paired products of the kernels
+	for (size_t i = 0; i < hiddenWeights1.size(); ++i) if (hiddenWeights1[i] == -128) hiddenWeights1[i] = -127;
+	for (size_t i = 0; i < hiddenWeights2.size(); ++i) if (hiddenWeights2[i] == -128) hiddenWeights2[i] = -127;
+	for (size_t i = 0; i < outputWeights.size(); ++i) if (outputWeights[i] == -128) outputWeights[i] = -127;
+
+	m_hiddenWeights1.swap(hiddenWeights1);
+	m_hiddenWeights2.swap(hiddenWeights2);
+	m_outputWeights.swap(outputWeights);
+	m_hiddenBiases1.swap(hiddenBiases1);
+	m_hiddenBiases2.swap(hiddenBiases2);
+	m_outputBias = outputBias;
+	return true;
+}
+
+void ValueNetwork::Randomize(uint64_t seed)
+{
+	Random random(seed);
+	for (size_t i = 0; i < m_hiddenWeights1.size(); ++i) m_hiddenWeights1[i] = (int8_t) random.NextInt(-24, 24);
+	for (size_t i = 0; i < m_hiddenWeights2.size(); ++i) m_hiddenWeights2[i] = (int8_t) random.NextInt(-64, 64);
+	for (size_t i = 0; i < m_outputWeights.size(); ++i) m_outputWeights[i] = (int8_t) random.NextInt(-16, 16);
+	for (int i = 0; i < HIDDEN; ++i)
+	{
+		m_hiddenBiases1[i] = random.NextInt(-2048, 2048);
+		m_hiddenBiases2[i] = random.NextInt(-2048, 2048);
+	}
+	m_outputBias = 0;
+}
+
+void ValueNetwork::Evaluate(const unsigned char* inputsPtr, int count, float* valuesPtr) const
+{
+	unsigned char hidden1[BATCH_SIZE * HIDDEN], hidden2[BATCH_SIZE * HIDDEN];
+	for (int first = 0; first < count; first += BATCH_SIZE)
+	{
+		int batch = count - first < BATCH_SIZE ? count - first : BATCH_SIZE;
+		RunLayer(inputsPtr + first * INPUTS, INPUTS, batch, &m_hiddenWeights1[0], &m_hiddenBiases1[0], hidden1);
+		RunLayer(hidden1, HIDDEN, batch, &m_hiddenWeights2[0], &m_hiddenBiases2[0], hidden2);
+		for (int i = 0; i < batch; ++i)
+		{
+			int32_t sum = Dot(hidden2 + i * HIDDEN, &m_outputWeights[0], HIDDEN) + m_outputBias;
+			valuesPtr[first + i] = (float) sum / OUTPUT_SCALE;
+		}
+	}
+}
+
+void ValueNetwork::RunLayer(const unsigned char* inputsPtr, int inputCount, int count, const int8_t* weightsPtr, const int32_t* biasesPtr, unsigned char* outputsPtr)
+{
+	// output by output, so one weight row serves the whole batch while it is in the cache
+	for (int output = 0; output < HIDDEN; ++output)
+	{
+		const int8_t* rowPtr = weightsPtr + output * inputCount;
+		int32_t bias = biasesPtr[output];
+		for (int i = 0; i < count; ++i)
+		{
+			outputsPtr[i * HIDDEN + output] = ClippedRelu(Dot(inputsPtr + i * inputCount, rowPtr, inputCount) + bias);
+		}
+	}
+}
+
+void ValueNetwork::EncodeInputs(const PLAY_SAMPLE& sampleRef, unsigned char* inputsPtr)
+{
+	const int cells = SelfPlayWriter::WINDOW_SIDE * SelfPlayWriter::WINDOW_SIDE;
+	for (int bit = 0; bit < cells; ++bit)
+	{
+		inputsPtr[bit] = (unsigned char) (((sampleRef.window[bit >> 6] >> (bit & 63)) & 1) * 127);
+	}
+
+	// the offset around 64, the distance up to 127
+	int dx = sampleRef.opponentDx, dy = sampleRef.opponentDy;
+	int distance = (dx < 0 ? -dx : dx) + (dy < 0 ? -dy : dy);
+	inputsPtr[cells] = (unsigned char) (dx < -64 ? 0 : dx > 63 ? 127 : dx + 64);
+	inputsPtr[cells + 1] = (unsigned char) (dy < -64 ? 0 : dy > 63 ? 127 : dy + 64);
+	inputsPtr[cells + 2] = (unsigned char) (distance > 127 ? 127 : distance);
+	memset(inputsPtr + cells + 3, 0, INPUTS - cells - 3);
+}
+
+void ValueNetwork::EncodeInputs(const ArenaGrid& arenaRef, const CELL* positionsPtr, int player, unsigned char* inputsPtr)
+{
+	PLAY_SAMPLE sample;
+	SelfPlayRecorder::EncodeState(arenaRef, positionsPtr, player, sample);
+	EncodeInputs(sample, inputsPtr);
+}
+
+const char* ValueNetwork::GetKernelName()
+{
+#if defined(VALUE_NETWORK_AVX2)
+	return "AVX2";
+#elif defined(VALUE_NETWORK_SSSE3)
+	return "SSSE3";
+#elif defined(VALUE_NETWORK_NEON)
+	return "NEON";
+#else
+	return "scalar";
+#endif
+}
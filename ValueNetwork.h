@@ -0,0 +1,102 @@
+//-----------------------------------------------------------------
+// ValueNetwork Object
+// C++ Header - ValueNetwork.h - version 2010 v2_07
+//
+// ValueNetwork is a small learned evaluation: how good a position is for
+// the player about to move, from the 15 x 15 window around it and where
+// the opponent is (the state of a PLAY_SAMPLE). It is a 256-32-32-1
+// perceptron with int8 weights and int32 biases; activations are bytes
+// from 0 to 127, so every layer is a clipped ReLU of
+//	(sum of activation * weight + bias) >> ACTIVATION_SHIFT
+// and the output is that sum divided by OUTPUT_SCALE, 0 for an even
+// position and about +-1 for a sure win or loss. The dot products run
+// on AVX2 or SSSE3 (32 or 16 byte pairs per multiply-add) or NEON, with
+// a plain C++ fallback; all give the same result.
+//
+// Evaluate takes a whole batch of positions, e.g. the leaves of a search,
+// and runs it layer by layer, so every weight row is loaded once for up
+// to BATCH_SIZE positions. It is const and can be shared by threads.
+//
+// Weight file: "AIVN", uint32 version 1, then for every layer the int8
+// weights output by output and the int32 biases.
+//-----------------------------------------------------------------
+
+#pragma once
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <tchar.h>
+#include <vector>
+#include <stdint.h>
+#include "SelfPlay.h"
+
+//-----------------------------------------------------------------
+// ValueNetwork Class
+//-----------------------------------------------------------------
+class ValueNetwork
+{
+public:
+	static const int INPUTS = 256;			// 225 window cells, the opponent offset and distance, zeros
+	static const int HIDDEN = 32;
+	static const int ACTIVATION_SHIFT = 6;	// weights are trained as real numbers times 64
+	static const int OUTPUT_SCALE = 127 * 64;
+	static const int BATCH_SIZE = 64;		// positions per layer pass
+
+	//---------------------------
+	// Constructor(s)
+	//---------------------------
+	ValueNetwork();							// all weights 0: every position is even
+
+	//---------------------------
+	// Destructor
+	//---------------------------
+	virtual ~ValueNetwork();
+
+	//---------------------------
+	// General Methods
+	//---------------------------
+	bool Load(const TCHAR* filenamePtr);
+
+	// small random weights, for benchmarks and as a starting point for training
+	void Randomize(uint64_t seed);
+
+	// inputsPtr holds count rows of INPUTS bytes, see EncodeInputs
+	void Evaluate(const unsigned char* inputsPtr, int count, float* valuesPtr) const;
+
+	float Evaluate(const unsigned char* inputsPtr) const
+	{
+		float value;
+		Evaluate(inputsPtr, 1, &value);
+		return value;
+	}
+
+	static void EncodeInputs(const PLAY_SAMPLE& sampleRef, unsigned char* inputsPtr);
+	static void EncodeInputs(const ArenaGrid& arenaRef, const CELL* positionsPtr, int player, unsigned char* inputsPtr);
+
+	static const char* GetKernelName();		// the instruction set the dot products were compiled for
+
+private:
+	// -------------------------
+	// Member functions
+	// -------------------------
+	// one layer for a batch: count rows of inputCount activations in, count rows of HIDDEN activations out
+	static void RunLayer(const unsigned char* inputsPtr, int inputCount, int count, const int8_t* weightsPtr, const int32_t* biasesPtr, unsigned char* outputsPtr);
+
+	// -------------------------
+	// Datamembers
+	// -------------------------
+	std::vector<int8_t> m_hiddenWeights1, m_hiddenWeights2, m_outputWeights;
+	std::vector<int32_t> m_hiddenBiases1, m_hiddenBiases2;
+	int32_t m_outputBias;
+
+	// -------------------------
+	// Disabling default copy constructor and default assignment operator.
+	// If you get a linker error from one of these functions, your class is internally trying to use them. This is
+	// an error in your class, these declarations are deliberately made without implementation because they should never be used.
+	// -------------------------
+	ValueNetwork(const ValueNetwork& vnRef);
+	ValueNetwork& operator=(const ValueNetwork& vnRef);
+};
@@ -0,0 +1,192 @@
+//-----------------------------------------------------------------
+// WeightedPathFinder Object
+// C++ Header - WeightedPathFinder.h - version 2010 v2_07
+//
+// WeightedPathFinder runs Dijkstra's algorithm over an arena grid with a
+// CostMap, so every cell costs one step plus its extra cost to enter.
+// The step costs are small integers, so the open list is a RadixHeap;
+// DijkstraPriorityQueue does the same search with std::priority_queue,
+// as the reference in the benchmark. Like PathFinder, the scratch
+// buffers are kept between searches and stamped instead of cleared.
+// Arenas can be up to 65534 cells wide and high.
+//-----------------------------------------------------------------
+
+#pragma once
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#include "ArenaGrid.h"
+#include "CostMap.h"
+#include "RadixHeap.h"
+#include <vector>
+#include <queue>
+#include <algorithm>
+#include <stdint.h>
+
+//-----------------------------------------------------------------
+// WeightedPathFinder Class
+//-----------------------------------------------------------------
+template<class Grid>
+class WeightedPathFinder
+{
+public:
+	static const uint32_t UNREACHABLE = 0xffffffff;
+
+	//---------------------------
+	// Constructor(s)
+	//---------------------------
+	WeightedPathFinder() : m_gridPtr(NULL), m_stamp(0)
+	{
+	}
+
+	//---------------------------
+	// Destructor
+	//---------------------------
+	virtual ~WeightedPathFinder()
+	{
+	}
+
+	//---------------------------
+	// General Methods
+	//---------------------------
+
+	// cheapest cost from the start to every reachable cell, returns the number of reached cells
+	int Dijkstra(const Grid& gridRef, const CostMap<Grid>& costsRef, int startX, int startY)
+	{
+		Prepare(gridRef);
+		m_radixHeap.Clear();
+		Visit(gridRef.Index(startX, startY), 0);
+		m_radixHeap.Push(0, PackCell(startX, startY));
+
+		int reached = 0;
+		while (!m_radixHeap.IsEmpty())
+		{
+			uint32_t cost, packedCell;
+			m_radixHeap.Pop(&cost, &packedCell);
+			int cellX = (int) (packedCell >> 16) - 1, cellY = (int) (packedCell & 0xffff) - 1;
+			if (cost != m_scratch[gridRef.Index(cellX, cellY)].distance) continue;	// outdated entry
+			++reached;
+			for (int direction = 0; direction < 4; ++direction)
+			{
+				int x = cellX + DIRECTION_DX[direction], y = cellY + DIRECTION_DY[direction];
+				if (gridRef.IsRigid(x, y)) continue;
+				int index = gridRef.Index(x, y);
+				uint32_t newCost = cost + costsRef.GetStepCostAt(index);
+				if (IsVisited(index) && m_scratch[index].distance <= newCost) continue;
+				Visit(index, newCost);
+				m_radixHeap.Push(newCost, PackCell(x, y));
+			}
+		}
+		return reached;
+	}
+
+	// the same search with a binary heap, for comparison
+	int DijkstraPriorityQueue(const Grid& gridRef, const CostMap<Grid>& costsRef, int startX, int startY)
+	{
+		Prepare(gridRef);
+		std::priority_queue<OpenNode> open;
+		Visit(gridRef.Index(startX, startY), 0);
+		OpenNode startNode = { 0, startX, startY };
+		open.push(startNode);
+
+		int reached = 0;
+		while (!open.empty())
+		{
+			OpenNode node = open.top();
+			open.pop();
+			if (node.cost != m_scratch[gridRef.Index(node.x, node.y)].distance) continue;
+			++reached;
+			for (int direction = 0; direction < 4; ++direction)
+			{
+				int x = node.x + DIRECTION_DX[direction], y = node.y + DIRECTION_DY[direction];
+				if (gridRef.IsRigid(x, y)) continue;
+				int index = gridRef.Index(x, y);
+				uint32_t newCost = node.cost + costsRef.GetStepCostAt(index);
+				if (IsVisited(index) && m_scratch[index].distance <= newCost) continue;
+				Visit(index, newCost);
+				OpenNode newNode = { newCost, x, y };
+				open.push(newNode);
+			}
+		}
+		return reached;
+	}
+
+	bool IsReached(int x, int y) const { return IsVisited(m_gridPtr->Index(x, y)); }
+
+	// cost of the cheapest path from the last start, UNREACHABLE for cells that weren't reached
+	uint32_t GetDistance(int x, int y) const
+	{
+		int index = m_gridPtr->Index(x, y);
+		return IsVisited(index) ? m_scratch[index].distance : UNREACHABLE;
+	}
+
+private:
+	// -------------------------
+	// Internal structs
+	// -------------------------
+	struct OpenNode
+	{
+		uint32_t cost;
+		int x, y;
+		// std::priority_queue is a max heap, so the comparison is reversed
+		bool operator<(const OpenNode& otherRef) const { return cost > otherRef.cost; }
+	};
+
+	// stamp and distance side by side, so a visit touches one cache line
+	struct ScratchCell
+	{
+		unsigned int stamp;
+		uint32_t distance;
+	};
+
+	// -------------------------
+	// Member functions
+	// -------------------------
+
+	// the radix heap entries stay at 8 bytes with the cell in one word; the sentinel ring makes x and y at least -1
+	static uint32_t PackCell(int x, int y)
+	{
+		return ((uint32_t) (x + 1) << 16) | (uint32_t) (y + 1);
+	}
+
+	void Prepare(const Grid& gridRef)
+	{
+		m_gridPtr = &gridRef;
+		if ((int) m_scratch.size() != gridRef.GetCellCount())
+		{
+			ScratchCell emptyCell = { 0, 0 };
+			m_scratch.assign(gridRef.GetCellCount(), emptyCell);
+			m_stamp = 0;
+		}
+		if (++m_stamp == 0)
+		{
+			for (size_t i = 0; i < m_scratch.size(); ++i) m_scratch[i].stamp = 0;
+			m_stamp = 1;
+		}
+	}
+
+	bool IsVisited(int index) const { return m_scratch[index].stamp == m_stamp; }
+
+	void Visit(int index, uint32_t distance)
+	{
+		m_scratch[index].stamp = m_stamp;
+		m_scratch[index].distance = distance;
+	}
+
+	// -------------------------
+	// Datamembers
+	// -------------------------
+	const Grid* m_gridPtr;
+	unsigned int m_stamp;
+	std::vector<ScratchCell> m_scratch;
+	RadixHeap<uint32_t> m_radixHeap;		// the values are packed cells
+
+	// -------------------------
+	// Disabling default copy constructor and default assignment operator.
+	// If you get a linker error from one of these functions, your class is internally trying to use them. This is
+	// an error in your class, these declarations are deliberately made without implementation because they should never be used.
+	// -------------------------
+	WeightedPathFinder(const WeightedPathFinder& wpfRef);
+	WeightedPathFinder& operator=(const WeightedPathFinder& wpfRef);
+};
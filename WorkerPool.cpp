@@ -0,0 +1,116 @@
+//-----------------------------------------------------------------
+// WorkerPool Object
+// C++ Source - WorkerPool.cpp - version 2010 v2_07
+//-----------------------------------------------------------------
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#include "WorkerPool.h"
+
+//-----------------------------------------------------------------
+// WorkerPool methods
+//-----------------------------------------------------------------
+WorkerPool::WorkerPool(int threadCount) : m_taskPtr(NULL), m_itemCount(0), m_chunkSize(1), m_nextItem(0), m_generation(0), m_busyWorkers(0), m_isShuttingDown(false)
+{
+	if (threadCount <= 0)
+	{
+		SYSTEM_INFO systemInfo;
+		GetSystemInfo(&systemInfo);
+		threadCount = (int) systemInfo.dwNumberOfProcessors;
+		if (threadCount < 1) threadCount = 1;
+	}
+
+	InitializeCriticalSection(&m_lock);
+	InitializeConditionVariable(&m_workReady);
+	InitializeConditionVariable(&m_workDone);
+
+	// the calling thread is thread 0, so one worker less is created
+	m_threadStarts.resize(threadCount - 1);
+	for (int thread = 1; thread < threadCount; ++thread)
+	{
+		ThreadStart& startRef = m_threadStarts[thread - 1];
+		startRef.poolPtr = this;
+		startRef.thread = thread;
+		m_threads.push_back(CreateThread(NULL, 0, ThreadProc, &startRef, 0, NULL));
+	}
+}
+
+WorkerPool::~WorkerPool()
+{
+	EnterCriticalSection(&m_lock);
+	m_isShuttingDown = true;
+	WakeAllConditionVariable(&m_workReady);
+	LeaveCriticalSection(&m_lock);
+
+	if (!m_threads.empty()) WaitForMultipleObjects((DWORD) m_threads.size(), &m_threads[0], TRUE, INFINITE);
+	for (size_t i = 0; i < m_threads.size(); ++i)
+	{
+		CloseHandle(m_threads[i]);
+	}
+	DeleteCriticalSection(&m_lock);
+}
+
+void WorkerPool::Run(WorkerTask& taskRef, int itemCount, int chunkSize)
+{
+	EnterCriticalSection(&m_lock);
+	m_taskPtr = &taskRef;
+	m_itemCount = itemCount;
+	m_chunkSize = chunkSize > 0 ? chunkSize : 1;
+	m_nextItem = 0;
+	m_busyWorkers = (int) m_threads.size();
+	++m_generation;
+	WakeAllConditionVariable(&m_workReady);
+	LeaveCriticalSection(&m_lock);
+
+	Work(0);
+
+	EnterCriticalSection(&m_lock);
+	while (m_busyWorkers > 0)
+	{
+		SleepConditionVariableCS(&m_workDone, &m_lock, INFINITE);
+	}
+	m_taskPtr = NULL;
+	LeaveCriticalSection(&m_lock);
+}
+
+DWORD WINAPI WorkerPool::ThreadProc(LPVOID parameter)
+{
+	ThreadStart* startPtr = (ThreadStart*) parameter;
+	startPtr->poolPtr->WorkerLoop(startPtr->thread);
+	return 0;
+}
+
+void WorkerPool::WorkerLoop(int thread)
+{
+	int doneGeneration = 0;
+	EnterCriticalSection(&m_lock);
+	for (;;)
+	{
+		while (!m_isShuttingDown && m_generation == doneGeneration)
+		{
+			SleepConditionVariableCS(&m_workReady, &m_lock, INFINITE);
+		}
+		if (m_isShuttingDown) break;
+		doneGeneration = m_generation;
+		LeaveCriticalSection(&m_lock);
+
+		Work(thread);
+
+		EnterCriticalSection(&m_lock);
+		if (--m_busyWorkers == 0) WakeAllConditionVariable(&m_workDone);
+	}
+	LeaveCriticalSection(&m_lock);
+}
+
+void WorkerPool::Work(int thread)
+{
+	for (;;)
+	{
+		int first = (int) InterlockedExchangeAdd(&m_nextItem, m_chunkSize);
+		if (first >= m_itemCount) break;
+		int last = first + m_chunkSize;
+		if (last > m_itemCount) last = m_itemCount;
+		m_taskPtr->Execute(thread, first, last);
+	}
+}
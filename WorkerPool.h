@@ -0,0 +1,95 @@
+//-----------------------------------------------------------------
+// WorkerPool Object
+// C++ Header - WorkerPool.h - version 2010 v2_07
+//
+// WorkerPool keeps a fixed set of worker threads alive and spreads the
+// items of a WorkerTask over them. The items are handed out in chunks
+// through an interlocked counter, so fast threads simply take more
+// chunks. The calling thread works along and Run returns when every
+// item is done.
+//-----------------------------------------------------------------
+
+#pragma once
+
+//-----------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <vector>
+
+//-----------------------------------------------------------------
+// WorkerTask Class
+//-----------------------------------------------------------------
+class WorkerTask
+{
+public:
+	virtual ~WorkerTask() {}
+
+	// handles the items first up to (not including) last; thread is 0 for the calling thread,
+	// 1 up to GetThreadCount() - 1 for the workers, so per thread scratch can be indexed with it
+	virtual void Execute(int thread, int first, int last) = 0;
+};
+
+//-----------------------------------------------------------------
+// WorkerPool Class
+//-----------------------------------------------------------------
+class WorkerPool
+{
+public:
+	//---------------------------
+	// Constructor(s)
+	//---------------------------
+	WorkerPool(int threadCount = 0);		// 0 uses one thread per processor
+
+	//---------------------------
+	// Destructor
+	//---------------------------
+	virtual ~WorkerPool();
+
+	//---------------------------
+	// General Methods
+	//---------------------------
+	void Run(WorkerTask& taskRef, int itemCount, int chunkSize = 1);
+
+	int GetThreadCount() const { return (int) m_threads.size() + 1; }
+
+private:
+	// -------------------------
+	// Internal structs
+	// -------------------------
+	struct ThreadStart
+	{
+		WorkerPool* poolPtr;
+		int thread;
+	};
+
+	// -------------------------
+	// Member functions
+	// -------------------------
+	static DWORD WINAPI ThreadProc(LPVOID parameter);
+	void WorkerLoop(int thread);
+	void Work(int thread);
+
+	// -------------------------
+	// Datamembers
+	// -------------------------
+	std::vector<HANDLE> m_threads;
+	std::vector<ThreadStart> m_threadStarts;	// passed to the threads, so must not move while they run
+	CRITICAL_SECTION m_lock;
+	CONDITION_VARIABLE m_workReady, m_workDone;
+	WorkerTask* m_taskPtr;
+	int m_itemCount, m_chunkSize;
+	volatile LONG m_nextItem;
+	int m_generation;						// counts the calls to Run, so a worker knows when there is new work
+	int m_busyWorkers;
+	bool m_isShuttingDown;
+
+	// -------------------------
+	// Disabling default copy constructor and default assignment operator.
+	// If you get a linker error from one of these functions, your class is internally trying to use them. This is
+	// an error in your class, these declarations are deliberately made without implementation because they should never be used.
+	// -------------------------
+	WorkerPool(const WorkerPool& wpRef);
+	WorkerPool& operator=(const WorkerPool& wpRef);
+};